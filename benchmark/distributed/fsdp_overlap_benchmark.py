@@ -0,0 +1,194 @@
+"""Trace-based benchmark of FSDP compute/communication overlap on MUSA.
+
+Trains the same stack of FSDP-wrapped transformer-sized MLP blocks in the
+default-stream-only mode and in the multi-stream mode, profiles a few steps of
+each and reports, from the device kernels in the trace:
+
+  * step time,
+  * the device time busy with compute, with collectives and with either,
+  * the fraction of collective time that ran concurrently with compute.
+
+With everything on the default stream the overlap is ~0% and the step time is
+about compute + communication; in multi-stream mode it should approach
+max(compute, communication). Run with e.g.
+
+    torchrun --nproc_per_node 8 benchmark/distributed/fsdp_overlap_benchmark.py \\
+        --layers 16 --hidden 4096 --trace-dir /tmp/fsdp_traces
+
+and open the exported chrome traces to inspect the streams.
+"""
+
+import argparse
+import json
+import os
+import time
+
+import torch
+import torch.distributed as dist
+from torch import nn
+from torch.distributed.fsdp import BackwardPrefetch
+from torch.distributed.fsdp import FullyShardedDataParallel as FSDP
+from torch.distributed.fsdp.wrap import ModuleWrapPolicy
+
+import torch_musa
+from torch_musa.distributed.fsdp import enable_multi_stream
+
+COMM_KERNEL_KEYWORDS = ("mccl", "nccl", "allgather", "reducescatter", "allreduce")
+
+
+class Block(nn.Module):
+    def __init__(self, hidden):
+        super().__init__()
+        self.up = nn.Linear(hidden, 4 * hidden)
+        self.down = nn.Linear(4 * hidden, hidden)
+
+    def forward(self, x):
+        return x + self.down(torch.nn.functional.gelu(self.up(x)))
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n", maxsplit=1)[0])
+    parser.add_argument("--layers", type=int, default=16)
+    parser.add_argument("--hidden", type=int, default=4096)
+    parser.add_argument("--batch", type=int, default=8)
+    parser.add_argument("--seq-len", type=int, default=1024)
+    parser.add_argument("--warmup", type=int, default=3)
+    parser.add_argument("--steps", type=int, default=5)
+    parser.add_argument("--max-inflight-all-gathers", type=int, default=None)
+    parser.add_argument("--trace-dir", type=str, default=None)
+    return parser.parse_args()
+
+
+def merge_intervals(intervals):
+    merged = []
+    for begin, end in sorted(intervals):
+        if merged and begin <= merged[-1][1]:
+            merged[-1][1] = max(merged[-1][1], end)
+        else:
+            merged.append([begin, end])
+    return merged
+
+
+def total_length(intervals):
+    return sum(end - begin for begin, end in intervals)
+
+
+def intersect_length(a, b):
+    """Length of the intersection of two sorted, disjoint interval lists."""
+    i = j = 0
+    length = 0
+    while i < len(a) and j < len(b):
+        begin = max(a[i][0], b[j][0])
+        end = min(a[i][1], b[j][1])
+        if begin < end:
+            length += end - begin
+        if a[i][1] < b[j][1]:
+            i += 1
+        else:
+            j += 1
+    return length
+
+
+def overlap_from_trace(trace_path):
+    with open(trace_path, encoding="utf-8") as f:
+        events = json.load(f)["traceEvents"]
+    comm, compute = [], []
+    for event in events:
+        if event.get("ph") != "X" or event.get("cat") != "kernel":
+            continue
+        interval = (event["ts"], event["ts"] + event["dur"])
+        name = event["name"].lower()
+        if any(keyword in name for keyword in COMM_KERNEL_KEYWORDS):
+            comm.append(interval)
+        else:
+            compute.append(interval)
+    comm, compute = merge_intervals(comm), merge_intervals(compute)
+    comm_us = total_length(comm)
+    overlap_us = intersect_length(comm, compute)
+    return {
+        "compute_us": total_length(compute),
+        "comm_us": comm_us,
+        "busy_us": total_length(merge_intervals(comm + compute)),
+        "overlap": overlap_us / comm_us if comm_us else 0.0,
+    }
+
+
+def run(args, multi_stream, rank, device):
+    enable_multi_stream(multi_stream, args.max_inflight_all_gathers)
+    torch.manual_seed(0)
+    model = nn.Sequential(*[Block(args.hidden) for _ in range(args.layers)])
+    model = FSDP(
+        model.to(device),
+        auto_wrap_policy=ModuleWrapPolicy({Block}),
+        backward_prefetch=BackwardPrefetch.BACKWARD_PRE,
+        forward_prefetch=True,
+        limit_all_gathers=True,
+        device_id=device,
+    )
+    optimizer = torch.optim.SGD(model.parameters(), lr=1e-3)
+    inp = torch.randn(args.batch, args.seq_len, args.hidden, device=device)
+
+    def step():
+        model(inp).float().pow(2).mean().backward()
+        optimizer.step()
+        optimizer.zero_grad()
+
+    for _ in range(args.warmup):
+        step()
+    torch.musa.synchronize()
+    dist.barrier()
+
+    start = time.perf_counter()
+    for _ in range(args.steps):
+        step()
+    torch.musa.synchronize()
+    step_ms = (time.perf_counter() - start) * 1e3 / args.steps
+
+    with torch.profiler.profile(
+        activities=[
+            torch.profiler.ProfilerActivity.CPU,
+            torch.profiler.ProfilerActivity.MUSA,
+        ]
+    ) as prof:
+        for _ in range(args.steps):
+            step()
+        torch.musa.synchronize()
+
+    mode = "multi_stream" if multi_stream else "default_stream"
+    trace_dir = args.trace_dir or "."
+    os.makedirs(trace_dir, exist_ok=True)
+    trace_path = os.path.join(trace_dir, f"fsdp_{mode}_rank{rank}.json")
+    prof.export_chrome_trace(trace_path)
+    stats = overlap_from_trace(trace_path)
+    if args.trace_dir is None:
+        os.remove(trace_path)
+    enable_multi_stream(False)
+    return mode, step_ms, stats
+
+
+def main():
+    args = parse_args()
+    dist.init_process_group("mccl")
+    rank = dist.get_rank()
+    device = torch.device("musa", int(os.environ.get("LOCAL_RANK", rank)))
+    torch_musa.set_device(device)
+
+    results = [run(args, multi_stream, rank, device) for multi_stream in (False, True)]
+    if rank == 0:
+        print(
+            f"{'mode':<16}{'step ms':>10}{'compute ms':>12}{'comm ms':>10}"
+            f"{'busy ms':>10}{'overlap':>10}"
+        )
+        for mode, step_ms, stats in results:
+            print(
+                f"{mode:<16}{step_ms:>10.2f}"
+                f"{stats['compute_us'] / 1e3 / args.steps:>12.2f}"
+                f"{stats['comm_us'] / 1e3 / args.steps:>10.2f}"
+                f"{stats['busy_us'] / 1e3 / args.steps:>10.2f}"
+                f"{stats['overlap']:>10.1%}"
+            )
+    dist.destroy_process_group()
+
+
+if __name__ == "__main__":
+    main()
@@ -2,12 +2,21 @@ from tests import (  # noqa: F401  # noqa: F401
     binary_test,
     bmm_test,
     conv_test,
+    embedding_bag_test,
+    embedding_sparse_update_test,
     linear_test,
+    linear_weight_only_test,
     matmul_test,
+    mudnn_op_cache_test,
+    nms_test,
+    optimizer_test,
+    paged_attention_test,
     rmsnorm_test,
+    rope_test,
     unary_test,  # noqa: F401
     activation_test,
     gather_test,
+    launch_overhead_test,
     norm_test,
     shape_test,
     softmax_test,
@@ -136,6 +136,20 @@ def parse_args():
         help="Only run the forward path of operators",
     )
 
+    parser.add_argument(
+        "--launch-overhead",
+        "--launch_overhead",
+        type=benchmark_utils.str2bool,
+        nargs="?",
+        const=True,
+        default=False,
+        help="Report host time per op instead of execution time: the forward "
+        "loop is timed without synchronizing the device, so for tiny inputs the "
+        "result is the cost of the dispatch path (guards, handles, descriptors, "
+        "launch). Each measured loop is wrapped in an 'op_bench::<test name>' "
+        "record_function range",
+    )
+
     parser.add_argument(
         "--framework",
         help="Comma-delimited list of frameworks to test (Caffe2, PyTorch)",
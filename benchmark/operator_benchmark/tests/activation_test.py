@@ -28,5 +28,46 @@ class GeluBenchmark(op_bench.TorchBenchmarkBase):
 op_bench.generate_pt_test(gelu_configs_short, GeluBenchmark)
 
 
+"""
+Gated MLP activation benchmark, the fused op against chunk + act + mul
+"""
+gated_act_configs_short = op_bench.cross_product_configs(
+    input_shape=((8, 512, 11008), (1, 2048, 14336), (16, 1, 11008)),
+    act=["swiglu", "geglu"],
+    fused=[True, False],
+    device=["musa"],
+    dtype=[torch.half, torch.bfloat16],
+    tags=["short"],
+)
+
+
+class GatedActBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, input_shape, act, fused, device, dtype):
+        self.act = act
+        self.fused = fused
+        # input holds both projections, [..., 2 * hidden]
+        shape = input_shape[:-1] + (2 * input_shape[-1],)
+        self.inputs = {
+            "input": torch.randn(
+                shape, dtype=dtype, device=device, requires_grad=self.auto_set()
+            )
+        }
+        self.set_module_name(act)
+
+    def forward(self, input):
+        if self.fused:
+            if self.act == "swiglu":
+                return torch.ops.musa.swiglu(input)
+            return torch.ops.musa.geglu(input, approximate="tanh")
+        gate, up = torch.chunk(input, 2, dim=-1)
+        if self.act == "swiglu":
+            return torch.nn.functional.silu(gate) * up
+        return torch.nn.functional.gelu(gate, approximate="tanh") * up
+
+
+op_bench.generate_pt_test(gated_act_configs_short, GatedActBenchmark)
+op_bench.generate_pt_gradient_test(gated_act_configs_short, GatedActBenchmark)
+
+
 if __name__ == "__main__":
     op_bench.benchmark_runner.main()
@@ -0,0 +1,46 @@
+import torch
+import torch.nn.functional as F
+
+import operator_benchmark as op_bench
+
+import torch_musa  # noqa: F401
+
+
+# DLRM-style sparse features: many small tables with short jagged bags
+grouped_embedding_bag_configs = op_bench.cross_product_configs(
+    num_tables=[16, 128],
+    batch=[512],
+    rows=[10000],
+    dim=[64],
+    pooling=[4],
+    grouped=[True, False],
+    device=["musa"],
+    tags=["short"],
+)
+
+
+class GroupedEmbeddingBagBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, num_tables, batch, rows, dim, pooling, grouped, device):
+        weights, indices, offsets = [], [], []
+        for _ in range(num_tables):
+            weights.append(torch.randn(rows, dim, device=device))
+            indices.append(torch.randint(0, rows, (batch * pooling,), device=device))
+            offsets.append(torch.arange(0, batch * pooling, pooling, device=device))
+        self.inputs = {"weights": weights, "indices": indices, "offsets": offsets}
+        self.grouped = grouped
+        self.set_module_name("grouped_embedding_bag")
+
+    def forward(self, weights, indices, offsets):
+        if self.grouped:
+            return torch.ops.musa.grouped_embedding_bag(weights, indices, offsets)
+        return [
+            F.embedding_bag(i, w, o, mode="sum")
+            for w, i, o in zip(weights, indices, offsets)
+        ]
+
+
+op_bench.generate_pt_test(grouped_embedding_bag_configs, GroupedEmbeddingBagBenchmark)
+
+
+if __name__ == "__main__":
+    op_bench.benchmark_runner.main()
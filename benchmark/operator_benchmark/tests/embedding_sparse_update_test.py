@@ -0,0 +1,58 @@
+import torch
+
+import operator_benchmark as op_bench
+
+import torch_musa  # noqa: F401
+
+
+# Recommendation-sized tables: a batch touches a tiny fraction of the rows,
+# the dense path still writes and reads the whole [rows, dim] gradient.
+embedding_sparse_update_configs = op_bench.cross_product_configs(
+    rows=[10_000_000],
+    dim=[64],
+    num_indices=[65536],
+    optimizer=["sgd", "rowwise_adagrad"],
+    fused=[True, False],
+    device=["musa"],
+    tags=["long"],
+)
+
+
+class EmbeddingSparseUpdateBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, rows, dim, num_indices, optimizer, fused, device):
+        self.inputs = {
+            "weight": torch.randn(rows, dim, device=device),
+            "momentum": torch.zeros(rows, device=device),
+            "grad_output": torch.randn(num_indices, dim, device=device),
+            "indices": torch.randint(0, rows, (num_indices,), device=device),
+        }
+        self.optimizer = optimizer
+        self.fused = fused
+        self.set_module_name("embedding_sparse_update")
+
+    def forward(self, weight, momentum, grad_output, indices):
+        lr = 0.01
+        if self.fused:
+            if self.optimizer == "sgd":
+                return torch.ops.musa.embedding_backward_sgd_(
+                    weight, grad_output, indices, lr
+                )
+            return torch.ops.musa.embedding_backward_rowwise_adagrad_(
+                weight, momentum, grad_output, indices, lr
+            )
+        grad = torch.ops.aten.embedding_dense_backward(
+            grad_output, indices, weight.shape[0], -1, False
+        )
+        if self.optimizer == "sgd":
+            return weight.add_(grad, alpha=-lr)
+        momentum.add_(grad.pow(2).mean(1))
+        return weight.addcdiv_(grad, momentum.sqrt().add(1e-10).unsqueeze(1), value=-lr)
+
+
+op_bench.generate_pt_test(
+    embedding_sparse_update_configs, EmbeddingSparseUpdateBenchmark
+)
+
+
+if __name__ == "__main__":
+    op_bench.benchmark_runner.main()
@@ -0,0 +1,137 @@
+import torch
+import torch.nn.functional as F
+
+import operator_benchmark as op_bench
+
+
+"""Microbenchmarks for the host-side cost of the dispatch path.
+
+Every op runs on tiny inputs, so the device finishes long before the host has
+issued the next call. Run with --launch-overhead to report host microseconds
+per op, e.g.
+
+    python -m tests.launch_overhead_test --launch-overhead --device musa
+
+Regressions here show up as small-batch inference latency: device guards,
+muDNN/muBLAS handle lookups, descriptor creation and TensorIterator setup.
+"""
+
+
+launch_overhead_configs_short = op_bench.config_list(
+    attr_names=["N"],
+    attrs=[
+        [8],
+    ],
+    cross_product_configs={
+        "device": ["cpu", "musa"],
+    },
+    tags=["short"],
+)
+
+launch_overhead_configs_long = op_bench.cross_product_configs(
+    N=[4, 32], device=["cpu", "musa"], tags=["long"]
+)
+
+
+class LaunchOverheadBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, N, device, op_func):
+        self.inputs = {
+            "x": torch.rand(N, N, device=device),
+            "y": torch.rand(N, N, device=device),
+        }
+        # operands of a fixed role that are not worth a separate config
+        self.aux = {
+            "idx": torch.randint(0, N, (N,), device=device),
+            "idx2d": torch.randint(0, N, (N, N), device=device),
+            "mask": torch.rand(N, N, device=device) > 0.5,
+            "img": torch.rand(1, 4, N, N, device=device),
+            "kernel": torch.rand(4, 4, 1, 1, device=device),
+            "bias": torch.rand(N, device=device),
+            "table": torch.rand(16, N, device=device),
+        }
+        self.op_func = op_func
+
+    def forward(self, x, y):
+        return self.op_func(x, y, self.aux)
+
+
+launch_overhead_ops_list = op_bench.op_list(
+    attr_names=["op_name", "op_func"],
+    attrs=[
+        # binary and scalar elementwise
+        ["add", lambda x, y, a: torch.add(x, y)],
+        ["add_", lambda x, y, a: x.add_(y)],
+        ["add_scalar", lambda x, y, a: torch.add(x, 1.0)],
+        ["sub", lambda x, y, a: torch.sub(x, y)],
+        ["mul", lambda x, y, a: torch.mul(x, y)],
+        ["mul_scalar", lambda x, y, a: torch.mul(x, 2.0)],
+        ["div", lambda x, y, a: torch.div(x, y)],
+        ["pow_scalar", lambda x, y, a: torch.pow(x, 2)],
+        ["maximum", lambda x, y, a: torch.maximum(x, y)],
+        ["eq", lambda x, y, a: torch.eq(x, y)],
+        ["where", lambda x, y, a: torch.where(a["mask"], x, y)],
+        ["clamp", lambda x, y, a: torch.clamp(x, 0.2, 0.8)],
+        ["addcmul", lambda x, y, a: torch.addcmul(x, x, y, value=0.5)],
+        ["lerp", lambda x, y, a: torch.lerp(x, y, 0.5)],
+        # unary elementwise and activations
+        ["abs", lambda x, y, a: torch.abs(x)],
+        ["neg", lambda x, y, a: torch.neg(x)],
+        ["exp", lambda x, y, a: torch.exp(x)],
+        ["sqrt", lambda x, y, a: torch.sqrt(x)],
+        ["rsqrt", lambda x, y, a: torch.rsqrt(x)],
+        ["sigmoid", lambda x, y, a: torch.sigmoid(x)],
+        ["tanh", lambda x, y, a: torch.tanh(x)],
+        ["relu", lambda x, y, a: F.relu(x)],
+        ["gelu", lambda x, y, a: F.gelu(x)],
+        ["silu", lambda x, y, a: F.silu(x)],
+        ["leaky_relu", lambda x, y, a: F.leaky_relu(x)],
+        ["hardswish", lambda x, y, a: F.hardswish(x)],
+        # reductions and normalizations
+        ["sum", lambda x, y, a: torch.sum(x)],
+        ["sum_dim", lambda x, y, a: torch.sum(x, dim=1)],
+        ["mean", lambda x, y, a: torch.mean(x, dim=1)],
+        ["amax", lambda x, y, a: torch.amax(x, dim=1)],
+        ["argmax", lambda x, y, a: torch.argmax(x, dim=1)],
+        ["norm", lambda x, y, a: torch.linalg.vector_norm(x)],
+        ["cumsum", lambda x, y, a: torch.cumsum(x, dim=1)],
+        ["softmax", lambda x, y, a: F.softmax(x, dim=-1)],
+        ["log_softmax", lambda x, y, a: F.log_softmax(x, dim=-1)],
+        ["layer_norm", lambda x, y, a: F.layer_norm(x, x.shape[-1:])],
+        ["topk", lambda x, y, a: torch.topk(x, 1, dim=1)],
+        ["sort", lambda x, y, a: torch.sort(x, dim=1)],
+        # matmul-like
+        ["mm", lambda x, y, a: torch.mm(x, y)],
+        ["addmm", lambda x, y, a: torch.addmm(a["bias"], x, y)],
+        ["bmm", lambda x, y, a: torch.bmm(x.unsqueeze(0), y.unsqueeze(0))],
+        ["linear", lambda x, y, a: F.linear(x, y, a["bias"])],
+        ["conv2d_1x1", lambda x, y, a: F.conv2d(a["img"], a["kernel"])],
+        ["max_pool2d", lambda x, y, a: F.max_pool2d(a["img"], 2, ceil_mode=True)],
+        ["avg_pool2d", lambda x, y, a: F.avg_pool2d(a["img"], 2, ceil_mode=True)],
+        # copies, layout and dtype
+        ["clone", lambda x, y, a: x.clone()],
+        ["contiguous_t", lambda x, y, a: x.t().contiguous()],
+        ["copy_", lambda x, y, a: x.copy_(y)],
+        ["to_half", lambda x, y, a: x.to(torch.half)],
+        ["fill_", lambda x, y, a: x.fill_(1.0)],
+        ["zero_", lambda x, y, a: x.zero_()],
+        ["cat", lambda x, y, a: torch.cat([x, y])],
+        ["stack", lambda x, y, a: torch.stack([x, y])],
+        # indexing
+        ["index_select", lambda x, y, a: torch.index_select(x, 0, a["idx"])],
+        ["gather", lambda x, y, a: torch.gather(x, 1, a["idx2d"])],
+        ["scatter_", lambda x, y, a: x.scatter_(1, a["idx2d"], y)],
+        ["masked_fill", lambda x, y, a: x.masked_fill(a["mask"], 0.0)],
+        ["embedding", lambda x, y, a: F.embedding(a["idx"], a["table"])],
+    ],
+)
+
+
+op_bench.generate_pt_tests_from_op_list(
+    launch_overhead_ops_list,
+    launch_overhead_configs_short + launch_overhead_configs_long,
+    LaunchOverheadBenchmark,
+)
+
+
+if __name__ == "__main__":
+    op_bench.benchmark_runner.main()
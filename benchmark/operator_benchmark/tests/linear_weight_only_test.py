@@ -0,0 +1,58 @@
+import operator_benchmark as op_bench
+import torch
+import torch_musa
+
+"""Microbenchmarks for weight-only quantized Linear against fp16 MatMul."""
+
+# decode-shaped problems, M is the number of tokens in flight
+linear_weight_only_configs = op_bench.cross_product_configs(
+    M=[1, 2, 4, 8, 16],
+    N=[4096, 11008],
+    K=[4096],
+    bits=[8, 4],
+    device=["musa"],
+    tags=["short"],
+)
+
+linear_fp16_configs = op_bench.cross_product_configs(
+    M=[1, 2, 4, 8, 16],
+    N=[4096, 11008],
+    K=[4096],
+    device=["musa"],
+    tags=["short"],
+)
+
+
+class LinearWeightOnlyBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, M, N, K, bits, device):
+        weight = torch.randn(N, K, dtype=torch.float16, device=device)
+        self.inputs = {
+            "input": torch.randn(M, K, dtype=torch.float16, device=device),
+            "packed_weight": torch.ops.quantized.linear_weight_only_prepack(
+                weight, None, bits, 128
+            ),
+        }
+        self.set_module_name(f"linear_weight_only_int{bits}")
+
+    def forward(self, input, packed_weight):
+        return torch.ops.quantized.linear_weight_only(input, packed_weight)
+
+
+class LinearFp16MatMulBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, M, N, K, device):
+        self.inputs = {
+            "input": torch.randn(M, K, dtype=torch.float16, device=device),
+            "weight": torch.randn(K, N, dtype=torch.float16, device=device),
+        }
+        self.set_module_name("linear_fp16_matmul")
+
+    def forward(self, input, weight):
+        return torch.matmul(input, weight)
+
+
+op_bench.generate_pt_test(linear_weight_only_configs, LinearWeightOnlyBenchmark)
+op_bench.generate_pt_test(linear_fp16_configs, LinearFp16MatMulBenchmark)
+
+
+if __name__ == "__main__":
+    op_bench.benchmark_runner.main()
@@ -0,0 +1,80 @@
+"""Host overhead of small muDNN ops with and without the descriptor cache.
+
+Shapes are tiny so that the measured time is dominated by host work, compare
+the op_cacheTrue and op_cacheFalse variants of each op for the per-call saving.
+"""
+
+import torch
+import torch.nn.functional as F
+
+import operator_benchmark as op_bench
+import torch_musa  # noqa: F401
+
+
+mudnn_op_cache_configs = op_bench.cross_product_configs(
+    batch=[1, 8],
+    op_cache=[True, False],
+    device=["musa"],
+    tags=["short"],
+)
+
+mudnn_op_cache_ops_list = op_bench.op_list(
+    attr_names=["op_name", "op_func"],
+    attrs=[
+        ["sum", lambda x, w: x.sum(dim=-1)],
+        ["softmax", lambda x, w: F.softmax(x, dim=-1)],
+        ["mm", lambda x, w: torch.mm(x.flatten(1), w)],
+        ["addmm", lambda x, w: torch.addmm(x[:, 0, 0, :8], x.flatten(1), w)],
+    ],
+)
+
+
+class MudnnOpCacheBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, batch, op_cache, device, op_func):
+        torch.backends.mudnn.op_cache = op_cache
+        self.inputs = {
+            "input": torch.randn(batch, 4, 8, 8, device=device),
+            "weight": torch.randn(4 * 8 * 8, 8, device=device),
+        }
+        self.op_func = op_func
+
+    def forward(self, input, weight):
+        return self.op_func(input, weight)
+
+
+class MudnnOpCacheConvBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, batch, op_cache, device):
+        torch.backends.mudnn.op_cache = op_cache
+        self.inputs = {
+            "input": torch.randn(batch, 4, 8, 8, device=device),
+            "weight": torch.randn(8, 4, 3, 3, device=device),
+        }
+        self.set_module_name("mudnn_op_cache_conv2d")
+
+    def forward(self, input, weight):
+        return F.conv2d(input, weight, padding=1)
+
+
+class MudnnOpCacheSDPABenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, batch, op_cache, device):
+        torch.backends.mudnn.op_cache = op_cache
+        self.inputs = {
+            "query": torch.randn(batch, 2, 16, 32, device=device),
+            "key": torch.randn(batch, 2, 16, 32, device=device),
+            "value": torch.randn(batch, 2, 16, 32, device=device),
+        }
+        self.set_module_name("mudnn_op_cache_sdpa")
+
+    def forward(self, query, key, value):
+        return F.scaled_dot_product_attention(query, key, value)
+
+
+op_bench.generate_pt_tests_from_op_list(
+    mudnn_op_cache_ops_list, mudnn_op_cache_configs, MudnnOpCacheBenchmark
+)
+op_bench.generate_pt_test(mudnn_op_cache_configs, MudnnOpCacheConvBenchmark)
+op_bench.generate_pt_test(mudnn_op_cache_configs, MudnnOpCacheSDPABenchmark)
+
+
+if __name__ == "__main__":
+    op_bench.benchmark_runner.main()
@@ -0,0 +1,67 @@
+import torch
+import torchvision
+
+import operator_benchmark as op_bench
+
+import torch_musa  # noqa: F401
+
+
+# Detection serving shapes, 1k to 20k candidate boxes per image
+nms_configs = op_bench.cross_product_configs(
+    num_boxes=[1000, 5000, 20000],
+    iou_threshold=[0.5],
+    device=["musa"],
+    tags=["short"],
+)
+
+batched_nms_configs = op_bench.cross_product_configs(
+    batch=[8],
+    num_boxes=[1000, 5000, 20000],
+    num_classes=[80],
+    iou_threshold=[0.5],
+    device=["musa"],
+    tags=["short"],
+)
+
+
+def make_boxes(shape, device):
+    xy = torch.rand(*shape, 2, device=device) * 1000
+    wh = torch.rand(*shape, 2, device=device) * 100 + 1
+    return torch.cat((xy, xy + wh), dim=-1)
+
+
+class NmsBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, num_boxes, iou_threshold, device):
+        self.inputs = {
+            "boxes": make_boxes((num_boxes,), device),
+            "scores": torch.rand(num_boxes, device=device),
+        }
+        self.iou_threshold = iou_threshold
+        self.set_module_name("nms")
+
+    def forward(self, boxes, scores):
+        return torchvision.ops.nms(boxes, scores, self.iou_threshold)
+
+
+class BatchedNmsBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, batch, num_boxes, num_classes, iou_threshold, device):
+        self.inputs = {
+            "boxes": make_boxes((batch, num_boxes), device),
+            "scores": torch.rand(batch, num_boxes, device=device),
+            "idxs": torch.randint(
+                0, num_classes, (batch, num_boxes), device=device
+            ),
+        }
+        self.iou_threshold = iou_threshold
+        self.set_module_name("musa_batched_nms")
+
+    def forward(self, boxes, scores, idxs):
+        return torch.ops.musa.batched_nms(boxes, scores, idxs, self.iou_threshold)
+
+
+op_bench.generate_pt_test(nms_configs, NmsBenchmark)
+op_bench.generate_pt_test(batched_nms_configs, BatchedNmsBenchmark)
+
+
+if __name__ == "__main__":
+    op_bench.benchmark_runner.main()
@@ -0,0 +1,107 @@
+import operator_benchmark as op_bench
+import torch
+
+import torch_musa  # noqa: F401
+from torch_musa.optim import FusedAdam, FusedSGD
+
+
+"""Microbenchmarks for one optimizer step.
+
+The many-small configs hold 50k [64, 64] tensors, LoRA adapter or MoE
+expert sized, where a step is bound by launches rather than bandwidth. The
+long configs hold ~1B parameters as 64 [4096, 4096] tensors, the size of
+a LLaMA-style model's weights, so the step is bound by streaming the params,
+grads and optimizer states. fused=False runs torch.optim with foreach=True,
+the _foreach_* path the fused multi_tensor_apply kernels replace.
+"""
+
+
+optimizer_configs_short = op_bench.cross_product_configs(
+    num_tensors=[8],
+    numel=[4096 * 4096],
+    optimizer=["adamw", "sgd"],
+    fused=[True, False],
+    master_weights=[False],
+    device=["musa"],
+    dtype=[torch.float32],
+    tags=["short"],
+)
+
+optimizer_configs_many_small = op_bench.cross_product_configs(
+    num_tensors=[50000],
+    numel=[64 * 64],
+    optimizer=["adamw", "sgd"],
+    fused=[True, False],
+    master_weights=[False],
+    device=["musa"],
+    dtype=[torch.float32],
+    tags=["short"],
+)
+
+optimizer_configs_long = op_bench.cross_product_configs(
+    num_tensors=[64],
+    numel=[4096 * 4096],
+    optimizer=["adamw", "sgd"],
+    fused=[False],
+    master_weights=[False],
+    device=["musa"],
+    dtype=[torch.bfloat16],
+    tags=["long"],
+) + op_bench.cross_product_configs(
+    num_tensors=[64],
+    numel=[4096 * 4096],
+    optimizer=["adamw", "sgd"],
+    fused=[True],
+    master_weights=[True, False],
+    device=["musa"],
+    dtype=[torch.bfloat16],
+    tags=["long"],
+)
+
+
+class OptimizerStepBenchmark(op_bench.TorchBenchmarkBase):
+    def init(
+        self, num_tensors, numel, optimizer, fused, master_weights, device, dtype
+    ):
+        params = [
+            torch.nn.Parameter(torch.randn(numel, device=device, dtype=dtype))
+            for _ in range(num_tensors)
+        ]
+        for p in params:
+            p.grad = torch.randn_like(p)
+        if optimizer == "adamw":
+            if fused:
+                self.optim = FusedAdam(
+                    params, lr=1e-4, weight_decay=0.01, master_weights=master_weights
+                )
+            else:
+                self.optim = torch.optim.AdamW(
+                    params, lr=1e-4, weight_decay=0.01, foreach=True
+                )
+        else:
+            if fused:
+                self.optim = FusedSGD(
+                    params, lr=1e-2, momentum=0.9, master_weights=master_weights
+                )
+            else:
+                self.optim = torch.optim.SGD(
+                    params, lr=1e-2, momentum=0.9, foreach=True
+                )
+        # one step outside the timed region allocates the optimizer states
+        self.optim.step()
+        self.inputs = {"p0": params[0]}
+        self.set_module_name("optimizer_step")
+
+    def forward(self, p0):
+        self.optim.step()
+        return p0
+
+
+op_bench.generate_pt_test(
+    optimizer_configs_short + optimizer_configs_many_small + optimizer_configs_long,
+    OptimizerStepBenchmark,
+)
+
+
+if __name__ == "__main__":
+    op_bench.benchmark_runner.main()
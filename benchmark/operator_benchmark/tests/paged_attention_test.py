@@ -0,0 +1,77 @@
+import torch
+import torch.nn.functional as F
+
+import operator_benchmark as op_bench
+
+import torch_musa  # noqa: F401
+
+
+# LLM decode: one new query token per sequence against its whole KV cache
+paged_attention_configs = op_bench.cross_product_configs(
+    batch=[1, 16, 64],
+    context_len=[512, 2048, 4096],
+    num_heads=[32],
+    head_dim=[128],
+    block_size=[16],
+    paged=[True, False],
+    device=["musa"],
+    dtype=[torch.half],
+    tags=["short"],
+)
+
+
+class PagedAttentionBenchmark(op_bench.TorchBenchmarkBase):
+    def init(
+        self, batch, context_len, num_heads, head_dim, block_size, paged, device, dtype
+    ):
+        self.paged = paged
+        self.context_len = context_len
+        if paged:
+            blocks_per_seq = context_len // block_size
+            cache_shape = (batch * blocks_per_seq, block_size, num_heads, head_dim)
+            self.inputs = {
+                "query": torch.randn(
+                    batch, num_heads, head_dim, dtype=dtype, device=device
+                ),
+                "key_cache": torch.randn(cache_shape, dtype=dtype, device=device),
+                "value_cache": torch.randn(cache_shape, dtype=dtype, device=device),
+                "block_tables": torch.randperm(batch * blocks_per_seq, device=device)
+                .to(torch.int32)
+                .view(batch, blocks_per_seq),
+                "context_lens": torch.full(
+                    (batch,), context_len, dtype=torch.int32, device=device
+                ),
+            }
+        else:
+            # dense flash attention over caches padded to the context length
+            cache_shape = (batch, num_heads, context_len, head_dim)
+            self.inputs = {
+                "query": torch.randn(
+                    batch, num_heads, 1, head_dim, dtype=dtype, device=device
+                ),
+                "key_cache": torch.randn(cache_shape, dtype=dtype, device=device),
+                "value_cache": torch.randn(cache_shape, dtype=dtype, device=device),
+                "block_tables": None,
+                "context_lens": None,
+            }
+        self.set_module_name("paged_attention_decode")
+
+    def forward(self, query, key_cache, value_cache, block_tables, context_lens):
+        if self.paged:
+            return torch.ops.musa.paged_attention_decode(
+                query,
+                key_cache,
+                value_cache,
+                block_tables,
+                context_lens,
+                self.context_len,
+            )
+        with torch.backends.cuda.sdp_kernel(enable_math=False, enable_flash=True):
+            return F.scaled_dot_product_attention(query, key_cache, value_cache)
+
+
+op_bench.generate_pt_test(paged_attention_configs, PagedAttentionBenchmark)
+
+
+if __name__ == "__main__":
+    op_bench.benchmark_runner.main()
@@ -40,5 +40,64 @@ op_bench.generate_pt_test(rmsnorm_long_configs, RMSNormBenchmark)
 op_bench.generate_pt_gradient_test(rmsnorm_long_configs, RMSNormBenchmark)
 
 
+fused_add_norm_configs = op_bench.cross_product_configs(
+    input_shape=(
+        (2, 128, 1024),
+        (8, 128, 2048),
+        (1, 128, 4096),
+        (16, 1, 4096)
+    ),
+    norm=["rmsnorm", "layernorm"],
+    fused=[True, False],
+    device=["musa"],
+    dtype=[torch.half],
+    tags=["short"],
+)
+
+
+class FusedAddNormBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, input_shape, norm, fused, device, dtype):
+        self.norm = norm
+        self.fused = fused
+        hidden = input_shape[-1]
+        self.inputs = {
+            "input": torch.randn(
+                input_shape, dtype=dtype, device=device, requires_grad=self.auto_set()
+            ),
+            "residual": torch.randn(
+                input_shape, dtype=dtype, device=device, requires_grad=self.auto_set()
+            ),
+            "weight": torch.randn(
+                hidden, dtype=dtype, device=device, requires_grad=self.auto_set()
+            ),
+            "bias": torch.randn(
+                hidden, dtype=dtype, device=device, requires_grad=self.auto_set()
+            ),
+        }
+        self.set_module_name("fused_add_" + norm)
+
+    def forward(self, input, residual, weight, bias):
+        # only the normalized output is returned, the gradient tests reduce a
+        # single tensor
+        normalized_shape = [input.shape[-1]]
+        if self.fused:
+            if self.norm == "rmsnorm":
+                return torch.ops.musa.fused_add_rmsnorm(
+                    input, residual, normalized_shape, weight
+                )[0]
+            return torch.ops.musa.fused_add_layernorm(
+                input, residual, normalized_shape, weight, bias
+            )[0]
+        # h = x + residual; y = norm(h), as in an unfused transformer block
+        hidden = input + residual
+        if self.norm == "rmsnorm":
+            return torch.rms_norm(hidden, normalized_shape, weight, 1e-6)
+        return torch.nn.functional.layer_norm(hidden, normalized_shape, weight, bias)
+
+
+op_bench.generate_pt_test(fused_add_norm_configs, FusedAddNormBenchmark)
+op_bench.generate_pt_gradient_test(fused_add_norm_configs, FusedAddNormBenchmark)
+
+
 if __name__ == "__main__":
     op_bench.benchmark_runner.main()
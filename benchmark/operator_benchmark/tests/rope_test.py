@@ -0,0 +1,57 @@
+import operator_benchmark as op_bench
+import torch
+
+import torch_musa  # noqa: F401
+
+
+# LLaMA-7B prefill and decode shapes, q and k of [batch, seq_len, heads, 128]
+rope_configs = op_bench.cross_product_configs(
+    batch=[1, 8],
+    seq_len=[1, 512, 2048],
+    num_heads=[32],
+    head_dim=[128],
+    fused=[True, False],
+    device=["musa"],
+    dtype=[torch.half],
+    tags=["short"],
+)
+
+
+def rotate_half(x):
+    x1, x2 = x.chunk(2, -1)
+    return torch.cat((-x2, x1), -1)
+
+
+class RopeBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, batch, seq_len, num_heads, head_dim, fused, device, dtype):
+        self.fused = fused
+        positions = torch.arange(seq_len, device=device)
+        inv_freq = 1.0 / (
+            10000.0 ** (torch.arange(0, head_dim, 2, device=device) / head_dim)
+        )
+        freqs = torch.outer(positions.float(), inv_freq)
+        shape = (batch, seq_len, num_heads, head_dim)
+        self.inputs = {
+            "q": torch.randn(shape, dtype=dtype, device=device),
+            "k": torch.randn(shape, dtype=dtype, device=device),
+            "cos": freqs.cos(),
+            "sin": freqs.sin(),
+        }
+        if not fused:
+            # eager HF LLaMA rotate_half path, [S, 1, D] tables in the input dtype
+            emb = torch.cat((freqs, freqs), -1).unsqueeze(1)
+            self.inputs["cos"] = emb.cos().to(dtype)
+            self.inputs["sin"] = emb.sin().to(dtype)
+        self.set_module_name("fused_rope")
+
+    def forward(self, q, k, cos, sin):
+        if self.fused:
+            return torch.ops.musa.fused_rope_(q, k, cos, sin)
+        return q * cos + rotate_half(q) * sin, k * cos + rotate_half(k) * sin
+
+
+op_bench.generate_pt_test(rope_configs, RopeBenchmark)
+
+
+if __name__ == "__main__":
+    op_bench.benchmark_runner.main()
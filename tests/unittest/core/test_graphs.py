@@ -0,0 +1,179 @@
+"""Unittest for MUSA graph capture and replay."""
+
+# pylint: disable=missing-function-docstring, redefined-outer-name, unused-import
+import pytest
+import torch
+
+import torch_musa
+from torch_musa import testing
+
+
+def _warmup(fn):
+    # run once eagerly on a side stream so lazy init stays out of the capture
+    side = torch.musa.Stream()
+    side.wait_stream(torch.musa.current_stream())
+    with torch.musa.stream(side):
+        fn()
+    torch.musa.current_stream().wait_stream(side)
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+def test_graph_capture_replay():
+    static_x = torch.randn(1024, device="musa")
+
+    def step():
+        return (static_x * 2 + 1).relu().sum()
+
+    _warmup(step)
+    g = torch.musa.MUSAGraph()
+    with torch.musa.graph(g):
+        static_out = step()
+
+    for _ in range(3):
+        static_x.copy_(torch.randn(1024, device="musa"))
+        g.replay()
+        torch.musa.synchronize()
+        golden = (static_x.cpu() * 2 + 1).relu().sum()
+        assert torch.allclose(static_out.cpu(), golden, rtol=1e-5, atol=1e-3)
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+def test_graph_is_capturing():
+    assert not torch.musa.is_current_stream_capturing()
+    x = torch.ones(16, device="musa")
+    _warmup(lambda: x + 1)
+    g = torch.musa.MUSAGraph()
+    with torch.musa.graph(g):
+        capturing = torch.musa.is_current_stream_capturing()
+        y = x + 1
+    assert capturing
+    assert not torch.musa.is_current_stream_capturing()
+    g.replay()
+    assert torch.equal(y.cpu(), torch.full((16,), 2.0))
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+def test_graph_capture_on_default_stream():
+    g = torch.musa.MUSAGraph()
+    with pytest.raises(RuntimeError, match="non-default stream"):
+        g.capture_begin()
+    # the failed capture leaves the default generator usable eagerly
+    x = torch.ones(64, device="musa")
+    torch.nn.functional.dropout(x, p=0.5)
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+@pytest.mark.skipif(
+    testing.get_musa_arch() < 21,
+    reason="dropout masks are drawn on the host below arch 21",
+)
+def test_graph_dropout_rng():
+    x = torch.ones(4096, device="musa")
+    _warmup(lambda: torch.nn.functional.dropout(x, p=0.5))
+    g = torch.musa.MUSAGraph()
+    with torch.musa.graph(g):
+        out = torch.nn.functional.dropout(x, p=0.5)
+
+    masks = []
+    for _ in range(3):
+        g.replay()
+        torch.musa.synchronize()
+        result = out.cpu()
+        # kept elements are scaled by 1 / (1 - p)
+        assert torch.all((result == 0) | (result == 2))
+        masks.append(result != 0)
+    # every replay draws a fresh mask
+    assert not torch.equal(masks[0], masks[1])
+    assert not torch.equal(masks[1], masks[2])
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+@pytest.mark.skipif(
+    testing.get_musa_arch() >= 21, reason="dropout masks are drawn on device"
+)
+def test_graph_dropout_rejected_on_host_rng():
+    x = torch.ones(4096, device="musa")
+    _warmup(lambda: torch.nn.functional.dropout(x, p=0.5))
+    g = torch.musa.MUSAGraph()
+    with pytest.raises(RuntimeError, match="drawn on the host"):
+        with torch.musa.graph(g):
+            torch.nn.functional.dropout(x, p=0.5)
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+def test_graph_shared_pool():
+    x = torch.randn(256, device="musa")
+    _warmup(lambda: x * 3)
+    g1 = torch.musa.MUSAGraph()
+    with torch.musa.graph(g1):
+        y1 = x * 3
+    g2 = torch.musa.MUSAGraph()
+    with torch.musa.graph(g2, pool=g1.pool()):
+        y2 = y1 + 1
+    assert g2.pool() == g1.pool()
+
+    handle = torch.musa.graph_pool_handle()
+    g3 = torch.musa.MUSAGraph()
+    with torch.musa.graph(g3, pool=handle):
+        y3 = x - 1
+    assert g3.pool() == handle
+
+    g1.replay()
+    g2.replay()
+    g3.replay()
+    torch.musa.synchronize()
+    golden = x.cpu()
+    assert torch.allclose(y2.cpu(), golden * 3 + 1)
+    assert torch.allclose(y3.cpu(), golden - 1)
+    del g1, g2, g3
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+def test_graph_mublas_workspace_outlives_eviction():
+    a = torch.randn(256, 256, device="musa")
+    b = torch.randn(256, 256, device="musa")
+    capture_stream = torch.musa.Stream()
+    # the capture stream's workspace exists before the capture begins
+    capture_stream.wait_stream(torch.musa.current_stream())
+    with torch.musa.stream(capture_stream):
+        torch.mm(a, b)
+    torch.musa.current_stream().wait_stream(capture_stream)
+
+    g = torch.musa.MUSAGraph()
+    with torch.musa.graph(g, stream=capture_stream):
+        out = torch.mm(a, b)
+
+    # more streams than the workspaces kept per handle, then drop them all
+    for _ in range(6):
+        side = torch.musa.Stream()
+        with torch.musa.stream(side):
+            torch.mm(a, b)
+    torch_musa._MUSAC._musa_clearMublasWorkspaces()
+    torch.musa.synchronize()
+
+    for _ in range(3):
+        out.zero_()
+        g.replay()
+        torch.musa.synchronize()
+        assert torch.allclose(out.cpu(), a.cpu() @ b.cpu(), rtol=1e-4, atol=1e-3)
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+def test_graph_reset_releases_mublas_workspace():
+    a = torch.randn(64, 64, device="musa")
+    torch.mm(a, a)
+    torch_musa._MUSAC._musa_clearMublasWorkspaces()
+    before = torch.musa.memory_stats()["mublas_workspace_bytes.current"]
+
+    g = torch.musa.MUSAGraph()
+    # the workspace of the capture stream is allocated inside the capture
+    with torch.musa.graph(g):
+        out = torch.mm(a, a)
+    g.replay()
+    torch.musa.synchronize()
+    assert torch.allclose(out.cpu(), a.cpu() @ a.cpu(), rtol=1e-4, atol=1e-3)
+
+    torch_musa._MUSAC._musa_clearMublasWorkspaces()
+    assert torch.musa.memory_stats()["mublas_workspace_bytes.current"] > before
+    g.reset()
+    assert torch.musa.memory_stats()["mublas_workspace_bytes.current"] == before
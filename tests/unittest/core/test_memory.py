@@ -384,3 +384,13 @@ def test_storage_resize():
     test_tensor = torch.randn(1024 * 1024).to("musa")
     test_tensor.storage().resize_(0)
     test_tensor.storage().resize_(test_tensor.numel())
+
+
+def test_mublas_workspace_stats():
+    stats = torch.musa.memory_stats()
+    for metric in ("current", "peak", "allocated", "freed"):
+        assert stats[f"mublas_workspace_bytes.{metric}"] >= 0
+    held = stats["mublas_workspace_bytes.current"]
+    torch_musa._MUSAC._musa_clearMublasWorkspaces()
+    torch.musa.synchronize()
+    assert torch.musa.memory_stats()["mublas_workspace_bytes.current"] <= held
@@ -61,3 +61,67 @@ def test_module_save_load():
             r"map_location=torch.device\('cpu'\) to map your storages to the MUSA or CPU.",
         ):
             reloaded_model = torch.load(model_path, map_location="cuda")
+
+
+def _make_checkpoint(path):
+    state = {
+        "weight": torch.randn(1024, 257),
+        "bias": torch.arange(300, dtype=torch.int64),
+        "half": torch.randn(33, 7).half(),
+        "empty": torch.empty(0),
+        "nested": [torch.randn(5), {"step": 3}],
+    }
+    # two tensors sharing one storage must stay shared after loading
+    state["view"] = state["weight"][3:10]
+    torch.save(state, path)
+    return state
+
+
+def _assert_same_state(loaded, state, device):
+    for key in ("weight", "bias", "half", "empty", "view"):
+        assert loaded[key].device == device
+        assert loaded[key].dtype == state[key].dtype
+        assert torch.equal(loaded[key].cpu(), state[key])
+    assert torch.equal(loaded["nested"][0].cpu(), state["nested"][0])
+    assert loaded["nested"][1] == {"step": 3}
+    assert (
+        loaded["view"].untyped_storage().data_ptr()
+        == loaded["weight"].untyped_storage().data_ptr()
+    )
+
+
+@pytest.mark.parametrize("num_workers", [1, 4])
+def test_streaming_load_fake_device(num_workers):
+    with tempfile.TemporaryDirectory() as temp_dir:
+        path = os.path.join(temp_dir, "ckpt.pt")
+        state = _make_checkpoint(path)
+        # small chunks so that storages are split across several copies
+        loaded, stats = torch_musa.streaming_load(
+            path,
+            num_workers=num_workers,
+            chunk_bytes=4096,
+            fake_device=True,
+            return_stats=True,
+        )
+        _assert_same_state(loaded, state, torch.device("cpu"))
+        assert stats.num_storages == 4
+        assert stats.num_bytes == sum(
+            state[k].untyped_storage().nbytes() for k in ("weight", "bias", "half")
+        ) + state["nested"][0].untyped_storage().nbytes()
+        assert stats.gbps > 0
+
+
+def test_streaming_load():
+    with tempfile.TemporaryDirectory() as temp_dir:
+        path = os.path.join(temp_dir, "ckpt.pt")
+        state = _make_checkpoint(path)
+        loaded = torch_musa.streaming_load(path, "musa", chunk_bytes=1 << 16)
+        _assert_same_state(loaded, state, torch.device("musa", 0))
+
+        model = ModelClass()
+        model_path = os.path.join(temp_dir, "model.pt")
+        torch.save(model.state_dict(), model_path)
+        loaded = torch_musa.streaming_load(model_path)
+        for key, value in model.state_dict().items():
+            assert loaded[key].device == torch.device("musa", 0)
+            assert torch.equal(loaded[key].cpu(), value)
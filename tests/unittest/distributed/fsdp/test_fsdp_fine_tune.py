@@ -17,7 +17,7 @@ from torch import nn
 import torch.distributed as dist
 from torch.distributed._tensor import DeviceMesh
 from torch.distributed.device_mesh import init_device_mesh
-from torch.distributed.fsdp.wrap import _Policy
+from torch.distributed.fsdp.wrap import _Policy, ModuleWrapPolicy
 from torch.distributed.fsdp.fully_sharded_data_parallel import (
     FullyShardedDataParallel as FSDP,
 )
@@ -31,7 +31,7 @@ from torch.distributed.fsdp.api import (
 import torch_musa
 from torch_musa import testing
 from torch_musa.testing.common_fsdp import FSDPTest, skip_if_lt_x_gpu
-from torch_musa.distributed.fsdp import ShardedGradScaler
+from torch_musa.distributed.fsdp import ShardedGradScaler, enable_multi_stream
 
 NUM_DEVICES_FOR_TESTING = 4
 HYBRID_SHARD_STRATEGY = [
@@ -178,6 +178,62 @@ class TestFSDPFineTune(FSDPTest):
                 setattr(fsdp_config, "sharding_strategy", sharding_strategy)
                 self._test_fsdp_basic_training(fsdp_config)
 
+    @skip_if_lt_x_gpu(NUM_DEVICES_FOR_TESTING)
+    @pytest.mark.skipif(
+        testing.get_musa_arch() <= 22,
+        reason="FSDP multi-stream mode needs an arch newer than 22",
+    )
+    def test_fsdp_multi_stream_training(self):
+        for sharding_strategy in supported_full_sharding_strategies():
+            for backward_prefetch in supported_backward_prefetch_configs():
+                for forward_prefetch in [True, False]:
+                    fsdp_config = FSDPConfig()
+                    fsdp_config.sharding_strategy = sharding_strategy
+                    fsdp_config.backward_prefetch = backward_prefetch
+                    fsdp_config.forward_prefetch = forward_prefetch
+                    self._test_fsdp_multi_stream_training(fsdp_config)
+
+    def _train_wrapped_seq_module(self, fsdp_config, multi_stream):
+        enable_multi_stream(multi_stream, max_inflight_all_gathers=1)
+        try:
+            torch.manual_seed(0)
+            device = torch_musa.current_device()
+            model = self._init_seq_module().to(device)
+            fsdp_model = FSDP(
+                module=model,
+                sharding_strategy=fsdp_config.sharding_strategy,
+                auto_wrap_policy=ModuleWrapPolicy({nn.Linear}),
+                backward_prefetch=fsdp_config.backward_prefetch,
+                forward_prefetch=fsdp_config.forward_prefetch,
+                limit_all_gathers=True,
+                device_id=device,
+            )
+            optimizer = torch.optim.Adam(fsdp_model.parameters(), lr=0.001)
+            torch.manual_seed(self.rank)
+            for _ in range(5):
+                inp = torch.randn((2, 6), device=device)
+                fsdp_model(inp).sum().backward()
+                optimizer.step()
+                optimizer.zero_grad()
+        finally:
+            enable_multi_stream(False)
+        return fsdp_model
+
+    def _test_fsdp_multi_stream_training(self, fsdp_config):
+        ref_model = self._train_wrapped_seq_module(fsdp_config, multi_stream=False)
+        assert ref_model._unshard_stream is ref_model._default_stream
+
+        fsdp_model = self._train_wrapped_seq_module(fsdp_config, multi_stream=True)
+        assert fsdp_model._unshard_stream is not fsdp_model._default_stream
+        assert fsdp_model._post_backward_stream is not fsdp_model._default_stream
+        assert fsdp_model._free_event_queue._max_num_inflight_all_gathers == 1
+
+        # overlapping only reorders the streams, the math is the same
+        torch.musa.synchronize()
+        for p, p_ref in zip(fsdp_model.parameters(), ref_model.parameters()):
+            torch.testing.assert_close(p, p_ref)
+        dist.barrier()
+
     def _test_fsdp_basic_training(self, fsdp_config):
         device_mesh = self._device_mesh_plan(
             hybrid_shard=fsdp_config.sharding_strategy in HYBRID_SHARD_STRATEGY
@@ -52,6 +52,36 @@ def runner(rank, world_size):
     clean()
 
 
+def sync_batch_norm_runner(rank, world_size):
+    torch_musa.set_device(rank)
+    start(rank, world_size)
+    torch.manual_seed(0)
+    inp = torch.randn(4 * world_size, 8, 5, 5).to(memory_format=torch.channels_last)
+    grad_out = torch.randn_like(inp)
+    bn = nn.BatchNorm2d(8)
+    sync_bn = nn.SyncBatchNorm.convert_sync_batchnorm(nn.BatchNorm2d(8)).to("musa")
+
+    # every rank holds a shard of the batch, the statistics span all of them
+    shard = slice(4 * rank, 4 * (rank + 1))
+    inp_ref = inp.clone().requires_grad_()
+    ref_out = bn(inp_ref)
+    ref_out.backward(grad_out)
+    inp_musa = inp[shard].to("musa").requires_grad_()
+    out = sync_bn(inp_musa)
+    out.backward(grad_out[shard].to("musa"))
+
+    torch.testing.assert_close(
+        out.detach().cpu(), ref_out[shard].detach(), atol=1e-4, rtol=1e-4
+    )
+    torch.testing.assert_close(
+        inp_musa.grad.cpu(), inp_ref.grad[shard], atol=1e-4, rtol=1e-4
+    )
+    torch.testing.assert_close(
+        sync_bn.running_mean.cpu(), bn.running_mean, atol=1e-4, rtol=1e-4
+    )
+    clean()
+
+
 def train(fn, world_size):
     mp.spawn(fn, args=(world_size,), nprocs=world_size, join=True)
 
@@ -67,5 +97,13 @@ def test_DistributedDataParallel():
         train(runner, torch.musa.device_count())
 
 
+@pytest.mark.skipif(
+    testing.get_musa_arch() < 22, reason="MCCL not released for qy1 dev3.0.0"
+)
+@testing.skip_if_not_multiple_musa_device
+def test_SyncBatchNorm():
+    train(sync_batch_norm_runner, min(torch.musa.device_count(), 2))
+
+
 if __name__ == "__main__":
     train(runner, 2)
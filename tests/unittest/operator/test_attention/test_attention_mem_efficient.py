@@ -0,0 +1,164 @@
+"""
+Op Unittest for memory-efficient (tiled) Attention.
+"""
+
+# pylint: disable=invalid-name
+import pytest
+import torch
+from torch.nn import functional as F
+
+from torch_musa import testing
+from torch_musa.testing.base_test_tool import DefaultComparator
+
+# [batch, num_heads, num_kv_heads, q_len, kv_len, head_dim]
+SHAPES = [
+    [2, 4, 4, 37, 37, 32],
+    [1, 8, 2, 16, 70, 64],
+    [3, 2, 1, 65, 9, 16],
+]
+
+# small enough to split every shape above into many tiles
+SMALL_TILE_BYTES = 4096
+
+
+def make_inputs(shape, dtype=torch.float32, device="cpu"):
+    batch, heads, kv_heads, q_len, kv_len, head_dim = shape
+    q = torch.randn(batch, heads, q_len, head_dim, dtype=dtype, device=device)
+    k = torch.randn(batch, kv_heads, kv_len, head_dim, dtype=dtype, device=device)
+    v = torch.randn(batch, kv_heads, kv_len, head_dim, dtype=dtype, device=device)
+    return q, k, v
+
+
+def reference_sdpa(q, k, v, attn_mask=None, is_causal=False, scale=None):
+    """F.scaled_dot_product_attention with the key/value heads repeated."""
+    groups = q.shape[1] // k.shape[1]
+    k, v = (t.repeat_interleave(groups, 1) for t in (k, v))
+    if is_causal:
+        causal = torch.ones(q.shape[2], k.shape[2], dtype=torch.bool).tril()
+        attn_mask = causal if attn_mask is None else attn_mask & causal
+    return F.scaled_dot_product_attention(q, k, v, attn_mask, scale=scale)
+
+
+@pytest.mark.parametrize("shape", SHAPES)
+@pytest.mark.parametrize("is_causal", [False, True])
+@pytest.mark.parametrize("max_tile_bytes", [SMALL_TILE_BYTES, None])
+def test_mem_efficient_attention_cpu(shape, is_causal, max_tile_bytes):
+    q, k, v = make_inputs(shape)
+    for t in (q, k, v):
+        t.requires_grad_()
+    out = torch.ops.musa.mem_efficient_attention(
+        q, k, v, is_causal=is_causal, max_tile_bytes=max_tile_bytes
+    )
+    grad = torch.randn_like(out)
+    out.backward(grad)
+
+    q_ref, k_ref, v_ref = (t.detach().clone().requires_grad_() for t in (q, k, v))
+    out_ref = reference_sdpa(q_ref, k_ref, v_ref, is_causal=is_causal)
+    out_ref.backward(grad)
+
+    comparator = DefaultComparator(abs_diff=1e-5, rel_diff=1e-5)
+    assert comparator(out, out_ref)
+    for t, t_ref in ((q, q_ref), (k, k_ref), (v, v_ref)):
+        assert comparator(t.grad, t_ref.grad)
+
+
+@pytest.mark.parametrize("mask_kind", ["bool", "float", "key_padding"])
+def test_mem_efficient_attention_mask_cpu(mask_kind):
+    q, k, v = make_inputs([2, 4, 4, 33, 45, 32])
+    if mask_kind == "bool":
+        attn_mask = torch.rand(2, 1, 33, 45) > 0.3
+        ref_mask = attn_mask
+    elif mask_kind == "float":
+        attn_mask = torch.randn(33, 45)
+        ref_mask = attn_mask
+    else:
+        attn_mask = torch.ones(2, 45, dtype=torch.bool)
+        attn_mask[0, 40:] = False
+        ref_mask = attn_mask[:, None, None, :]
+    out = torch.ops.musa.mem_efficient_attention(
+        q, k, v, attn_mask, scale=0.3, max_tile_bytes=SMALL_TILE_BYTES
+    )
+    out_ref = reference_sdpa(q, k, v, ref_mask, scale=0.3)
+    assert DefaultComparator(abs_diff=1e-5, rel_diff=1e-5)(out, out_ref)
+
+
+def test_mem_efficient_attention_dropout_cpu():
+    q, k, v = make_inputs([1, 2, 2, 40, 40, 16])
+    for t in (q, k, v):
+        t.requires_grad_()
+    kwargs = {"dropout_p": 0.3, "max_tile_bytes": SMALL_TILE_BYTES}
+    torch.manual_seed(1234)
+    out = torch.ops.musa.mem_efficient_attention(q, k, v, **kwargs)
+    torch.manual_seed(1234)
+    again = torch.ops.musa.mem_efficient_attention(q, k, v, **kwargs)
+    other = torch.ops.musa.mem_efficient_attention(q, k, v, **kwargs)
+    assert torch.equal(out, again)
+    assert not torch.equal(out, other)
+
+    # the backward must redraw the forward's mask: check against numerical
+    # gradients of the same draw
+    def func(query):
+        torch.manual_seed(1234)
+        return torch.ops.musa.mem_efficient_attention(query, k, v, **kwargs)
+
+    q64 = q.detach().double().requires_grad_()
+    k, v = k.detach().double(), v.detach().double()
+    assert torch.autograd.gradcheck(func, (q64,), eps=1e-6, atol=1e-5)
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+@pytest.mark.parametrize("shape", SHAPES)
+@pytest.mark.parametrize("dtype", [torch.float32, torch.float16])
+@pytest.mark.parametrize("is_causal", [False, True])
+def test_mem_efficient_attention_musa(shape, dtype, is_causal):
+    q, k, v = make_inputs(shape, dtype=torch.float32)
+    out_cpu = torch.ops.musa.mem_efficient_attention(
+        q, k, v, is_causal=is_causal, max_tile_bytes=SMALL_TILE_BYTES
+    )
+    q_musa, k_musa, v_musa = (t.to(dtype).musa().requires_grad_() for t in (q, k, v))
+    out = torch.ops.musa.mem_efficient_attention(
+        q_musa, k_musa, v_musa, is_causal=is_causal, max_tile_bytes=SMALL_TILE_BYTES
+    )
+    out.sum().backward()
+    if dtype == torch.float16:
+        comparator = DefaultComparator(abs_diff=5e-3, rel_diff=5e-3)
+    else:
+        comparator = DefaultComparator(abs_diff=1e-5, rel_diff=1e-5)
+    assert comparator(out.float().cpu(), out_cpu)
+    assert all(t.grad is not None for t in (q_musa, k_musa, v_musa))
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+def test_mem_efficient_attention_dropout_musa():
+    q, k, v = make_inputs([2, 4, 4, 64, 64, 32], device="musa")
+    kwargs = {"dropout_p": 0.2, "max_tile_bytes": SMALL_TILE_BYTES}
+    torch.musa.manual_seed(42)
+    out = torch.ops.musa.mem_efficient_attention(q, k, v, **kwargs)
+    torch.musa.manual_seed(42)
+    assert torch.equal(out, torch.ops.musa.mem_efficient_attention(q, k, v, **kwargs))
+
+    # the output is linear in the values for a fixed draw, so the backward
+    # redraws the forward's masks iff <grad, f(delta)> == <dv, delta>
+    def func(value):
+        torch.musa.manual_seed(42)
+        return torch.ops.musa.mem_efficient_attention(q, k, value, **kwargs)
+
+    v.requires_grad_()
+    grad = torch.randn_like(out)
+    func(v).backward(grad)
+    delta = torch.randn_like(v)
+    with torch.no_grad():
+        lhs = (grad * func(delta)).sum()
+    rhs = (v.grad * delta).sum()
+    assert torch.allclose(lhs.cpu(), rhs.cpu(), rtol=1e-4, atol=1e-3)
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+def test_sdpa_routes_to_mem_efficient():
+    q, k, v = make_inputs([2, 4, 4, 128, 128, 64], device="musa")
+    with torch.backends.cuda.sdp_kernel(
+        enable_flash=False, enable_math=False, enable_mem_efficient=True
+    ):
+        out = F.scaled_dot_product_attention(q, k, v, is_causal=True)
+    out_ref = reference_sdpa(q.cpu(), k.cpu(), v.cpu(), is_causal=True)
+    assert DefaultComparator(abs_diff=1e-5, rel_diff=1e-5)(out.cpu(), out_ref)
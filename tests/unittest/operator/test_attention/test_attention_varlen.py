@@ -0,0 +1,196 @@
+"""
+Op Unittest for variable-length (packed) Attention.
+"""
+
+# pylint: disable=invalid-name
+import pytest
+import torch
+from torch.nn import functional as F
+
+from torch_musa import testing
+from torch_musa.testing.base_test_tool import DefaultComparator
+
+# equal lengths take one dense call viewed in place, equal lengths that are
+# not neighbours gather their rows, distinct lengths one call each
+SEQLENS = [
+    [16, 16, 16],
+    [7, 7, 32, 1, 1],
+    [9, 4, 9, 0, 4, 9],
+    [5, 0, 17, 9, 33, 2, 12],
+]
+
+
+def cu_seqlens_of(seqlens):
+    return torch.tensor([0] + seqlens).cumsum(0).to(torch.int32)
+
+
+def reference_varlen(q, k, v, seqlens, is_causal):
+    """Per-sequence SDPA on CPU float32."""
+    outs, begin = [], 0
+    for seqlen in seqlens:
+        if seqlen == 0:
+            continue
+        rows = slice(begin, begin + seqlen)
+        out = F.scaled_dot_product_attention(
+            *(t[rows].float().cpu().transpose(0, 1) for t in (q, k, v)),
+            is_causal=is_causal,
+        )
+        outs.append(out.transpose(0, 1))
+        begin += seqlen
+    return torch.cat(outs)
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+@pytest.mark.parametrize("seqlens", SEQLENS)
+@pytest.mark.parametrize("tail_shape", [[4, 8], []])
+def test_varlen_pack_unpack(seqlens, tail_shape):
+    cu_seqlens = cu_seqlens_of(seqlens)
+    max_seqlen = max(seqlens)
+    packed = torch.randn([sum(seqlens)] + tail_shape)
+
+    padded_cpu = torch.ops.musa.varlen_unpack(packed, cu_seqlens, max_seqlen)
+    for b, seqlen in enumerate(seqlens):
+        begin = int(cu_seqlens[b])
+        assert torch.equal(padded_cpu[b, :seqlen], packed[begin : begin + seqlen])
+        assert not padded_cpu[b, seqlen:].any()
+    assert torch.equal(torch.ops.musa.varlen_pack(padded_cpu, cu_seqlens), packed)
+
+    padded = torch.ops.musa.varlen_unpack(packed.musa(), cu_seqlens, max_seqlen)
+    assert torch.equal(padded.cpu(), padded_cpu)
+    repacked = torch.ops.musa.varlen_pack(
+        padded, cu_seqlens.musa(), total=packed.shape[0]
+    )
+    assert torch.equal(repacked.cpu(), packed)
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+def test_varlen_pack_unpack_backward():
+    seqlens = [3, 6, 1]
+    cu_seqlens = cu_seqlens_of(seqlens)
+    packed = torch.randn(sum(seqlens), 4, device="musa", requires_grad=True)
+    padded = torch.ops.musa.varlen_unpack(packed, cu_seqlens, 6)
+    grad = torch.randn_like(padded)
+    padded.backward(grad)
+    expected = torch.ops.musa.varlen_pack(grad.cpu(), cu_seqlens)
+    assert torch.equal(packed.grad.cpu(), expected)
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+@pytest.mark.skipif(
+    testing.get_musa_arch() < 22, reason="SKIP this test if in GPU with arch below 22."
+)
+@pytest.mark.parametrize("seqlens", SEQLENS)
+@pytest.mark.parametrize("is_causal", [True, False])
+@pytest.mark.parametrize("dtype", [torch.half])
+def test_flash_attn_varlen(seqlens, is_causal, dtype):
+    """
+    Packed attention against per-sequence attention.
+    """
+    num_heads, head_dim = 8, 64
+    cu_seqlens = cu_seqlens_of(seqlens)
+    q, k, v = (
+        torch.randn(sum(seqlens), num_heads, head_dim, dtype=dtype, device="musa")
+        for _ in range(3)
+    )
+    out = torch.ops.musa.flash_attn_varlen(
+        q, k, v, cu_seqlens, cu_seqlens, max(seqlens), max(seqlens), is_causal=is_causal
+    )
+    comparator = DefaultComparator(abs_diff=5e-2, rel_diff=1e-3)
+    assert comparator(out.float().cpu(), reference_varlen(q, k, v, seqlens, is_causal))
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+@pytest.mark.skipif(
+    testing.get_musa_arch() < 22, reason="SKIP this test if in GPU with arch below 22."
+)
+def test_flash_attn_varlen_nested():
+    """
+    Nested-tensor SDPA takes the varlen path.
+    """
+    seqlens = [5, 17, 9]
+    num_heads, head_dim = 8, 64
+    q, k, v = (
+        torch.randn(sum(seqlens), num_heads, head_dim, dtype=torch.half, device="musa")
+        for _ in range(3)
+    )
+    nested = [
+        torch.nested.nested_tensor(list(t.split(seqlens))).transpose(1, 2)
+        for t in (q, k, v)
+    ]
+    with torch.no_grad(), torch.backends.cuda.sdp_kernel(
+        enable_math=False, enable_flash=True
+    ):
+        out = F.scaled_dot_product_attention(*nested)
+    out = torch.cat([t.transpose(0, 1) for t in out.unbind()])
+    comparator = DefaultComparator(abs_diff=5e-2, rel_diff=1e-3)
+    assert comparator(out.float().cpu(), reference_varlen(q, k, v, seqlens, False))
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+@pytest.mark.skipif(
+    testing.get_musa_arch() < 22, reason="SKIP this test if in GPU with arch below 22."
+)
+@pytest.mark.parametrize("is_causal", [True, False])
+def test_flash_attn_varlen_backward(is_causal):
+    """
+    Gradients of packed attention against per-sequence attention.
+    """
+    seqlens = [9, 4, 9, 0, 4, 17]
+    num_heads, head_dim = 4, 64
+    cu_seqlens = cu_seqlens_of(seqlens)
+    q, k, v = (
+        torch.randn(sum(seqlens), num_heads, head_dim, dtype=torch.half)
+        for _ in range(3)
+    )
+    grad = torch.randn(sum(seqlens), num_heads, head_dim, dtype=torch.half)
+
+    inputs = [t.musa().requires_grad_() for t in (q, k, v)]
+    out = torch.ops.musa.flash_attn_varlen(
+        *inputs, cu_seqlens, cu_seqlens, max(seqlens), max(seqlens), is_causal=is_causal
+    )
+    out.backward(grad.musa())
+
+    golden_inputs = [t.float().requires_grad_() for t in (q, k, v)]
+    reference_varlen(*golden_inputs, seqlens, is_causal).backward(grad.float())
+    comparator = DefaultComparator(abs_diff=5e-2, rel_diff=1e-2)
+    for t, golden in zip(inputs, golden_inputs):
+        assert comparator(t.grad.float().cpu(), golden.grad)
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+@pytest.mark.skipif(
+    testing.get_musa_arch() < 22, reason="SKIP this test if in GPU with arch below 22."
+)
+def test_flash_attn_varlen_dropout():
+    """
+    Dropout rescales the kept attention mass of every query row.
+    """
+    seqlens = [9, 4, 9, 0, 4, 17]
+    num_heads, head_dim, p = 4, 64, 0.5
+    cu_seqlens = cu_seqlens_of(seqlens)
+    q, k = (
+        torch.randn(sum(seqlens), num_heads, head_dim, dtype=torch.half, device="musa")
+        for _ in range(2)
+    )
+    # values are constant per sequence, an output row is that constant times
+    # the kept probability mass scaled by 1 / (1 - p)
+    v = torch.cat(
+        [
+            torch.full((n, num_heads, head_dim), float(i + 1))
+            for i, n in enumerate(seqlens)
+        ]
+    ).to(torch.half).musa()
+    args = (q, k, v, cu_seqlens, cu_seqlens, max(seqlens), max(seqlens))
+
+    out = torch.ops.musa.flash_attn_varlen(*args, dropout_p=p).float().cpu()
+    scale = torch.cat(
+        [torch.full((n,), float(i + 1)) for i, n in enumerate(seqlens)]
+    ).view(-1, 1, 1)
+    mass = out / scale
+    assert torch.all(mass >= -1e-3) and torch.all(mass <= 1 / (1 - p) + 1e-2)
+    # every element of a row is scaled by the same mass
+    assert torch.allclose(mass, mass[..., :1].expand_as(mass), atol=1e-2)
+    # some probabilities were dropped, and different calls draw different masks
+    assert not torch.allclose(mass, torch.ones_like(mass), atol=1e-2)
+    again = torch.ops.musa.flash_attn_varlen(*args, dropout_p=p).float().cpu()
+    assert not torch.equal(out, again)
@@ -0,0 +1,104 @@
+"""
+Op Unittest for paged KV-cache attention.
+"""
+
+# pylint: disable=invalid-name
+import pytest
+import torch
+from torch.nn import functional as F
+
+from torch_musa import testing
+from torch_musa.testing.base_test_tool import DefaultComparator
+
+
+def make_paged_cache(context_lens, num_kv_heads, head_dim, block_size, dtype):
+    """Fill a shuffled paged cache with random K/V and return the dense copies."""
+    blocks_per_seq = [-(-n // block_size) for n in context_lens]
+    num_blocks = sum(blocks_per_seq) + 2
+    shape = (num_blocks, block_size, num_kv_heads, head_dim)
+    key_cache = torch.zeros(shape, dtype=dtype)
+    value_cache = torch.zeros(shape, dtype=dtype)
+    block_tables = torch.zeros(len(context_lens), max(blocks_per_seq), dtype=torch.int32)
+    free = torch.randperm(num_blocks)
+    keys, values, slots = [], [], []
+    for b, n in enumerate(context_lens):
+        table, free = free[: blocks_per_seq[b]], free[blocks_per_seq[b] :]
+        block_tables[b, : table.numel()] = table.to(torch.int32)
+        pos = torch.arange(n)
+        slots.append(table[pos // block_size] * block_size + pos % block_size)
+        keys.append(torch.randn(n, num_kv_heads, head_dim, dtype=dtype))
+        values.append(torch.randn(n, num_kv_heads, head_dim, dtype=dtype))
+    torch.ops.musa.reshape_and_cache(
+        torch.cat(keys), torch.cat(values), key_cache, value_cache, torch.cat(slots)
+    )
+    return key_cache, value_cache, block_tables, keys, values
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+@pytest.mark.parametrize("block_size", [16, 32])
+def test_reshape_and_cache(block_size):
+    num_kv_heads, head_dim = 4, 64
+    num_blocks = 8
+    key = torch.randn(20, num_kv_heads, head_dim, dtype=torch.half)
+    value = torch.randn_like(key)
+    slot_mapping = torch.randperm(num_blocks * block_size)[:20]
+    slot_mapping[3] = -1  # padding token, skipped
+    shape = (num_blocks, block_size, num_kv_heads, head_dim)
+    key_cache = torch.zeros(shape, dtype=torch.half)
+    value_cache = torch.zeros(shape, dtype=torch.half)
+    torch.ops.musa.reshape_and_cache(key, value, key_cache, value_cache, slot_mapping)
+    musa_key_cache, musa_value_cache = (
+        torch.zeros(shape, dtype=torch.half, device="musa") for _ in range(2)
+    )
+    torch.ops.musa.reshape_and_cache(
+        key.musa(), value.musa(), musa_key_cache, musa_value_cache, slot_mapping.musa()
+    )
+    assert torch.equal(musa_key_cache.cpu(), key_cache)
+    assert torch.equal(musa_value_cache.cpu(), value_cache)
+    assert torch.equal(key_cache.view(-1, num_kv_heads, head_dim)[slot_mapping[0]], key[0])
+    assert not key_cache.view(-1, num_kv_heads, head_dim)[slot_mapping[3]].any()
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+@pytest.mark.parametrize("context_lens", [[1, 17, 64], [300, 0, 33, 128]])
+@pytest.mark.parametrize("num_heads,num_kv_heads", [(8, 8), (8, 2)])
+@pytest.mark.parametrize("block_size", [16])
+@pytest.mark.parametrize("dtype", [torch.half, torch.float32])
+def test_paged_attention_decode(context_lens, num_heads, num_kv_heads, block_size, dtype):
+    """
+    Paged decode against dense attention over every sequence's cache.
+    """
+    head_dim = 64
+    key_cache, value_cache, block_tables, keys, values = make_paged_cache(
+        context_lens, num_kv_heads, head_dim, block_size, dtype
+    )
+    query = torch.randn(len(context_lens), num_heads, head_dim, dtype=dtype)
+    lens = torch.tensor(context_lens, dtype=torch.int32)
+    max_len = max(context_lens)
+
+    out = torch.ops.musa.paged_attention_decode(
+        query.musa(),
+        key_cache.musa(),
+        value_cache.musa(),
+        block_tables.musa(),
+        lens.musa(),
+        max_len,
+    )
+    out_cpu = torch.ops.musa.paged_attention_decode(
+        query, key_cache, value_cache, block_tables, lens, max_len
+    )
+
+    groups = num_heads // num_kv_heads
+    expected = torch.zeros(query.shape)
+    for b, n in enumerate(context_lens):
+        if n == 0:
+            continue
+        k = keys[b].float().repeat_interleave(groups, 1).transpose(0, 1)
+        v = values[b].float().repeat_interleave(groups, 1).transpose(0, 1)
+        expected[b] = F.scaled_dot_product_attention(
+            query[b].float().unsqueeze(1), k, v
+        ).squeeze(1)
+    abs_diff = 5e-3 if dtype == torch.half else 1e-5
+    comparator = DefaultComparator(abs_diff=abs_diff, rel_diff=1e-3)
+    assert comparator(out.float().cpu(), expected)
+    assert comparator(out_cpu.float(), expected)
@@ -569,3 +569,68 @@ def test_conv_transpose3d_bwd(common_config, dtype, channels_last):
         test.check_musafp16_vs_cpufp32(inputs=inputs)
     else:
         test.check_result(inputs=inputs)
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+@pytest.mark.parametrize("channels_last", [True, False])
+def test_conv2d_benchmark_mode(channels_last, tmp_path):
+    memory_format = torch.channels_last if channels_last else torch.contiguous_format
+    input_ = torch.randn(2, 8, 32, 32).to(memory_format=memory_format)
+    weight = torch.randn(16, 8, 3, 3).to(memory_format=memory_format)
+    bias = torch.randn(16)
+    golden = torch.nn.functional.conv2d(input_, weight, bias, padding=1)
+
+    x = input_.musa().requires_grad_()
+    w = weight.musa().requires_grad_()
+    torch.backends.mudnn.clear_conv_algo_cache()
+    with torch.backends.mudnn.flags(benchmark=True):
+        assert torch.backends.mudnn.benchmark
+        out = torch.nn.functional.conv2d(x, w, bias.musa(), padding=1)
+        out.sum().backward()
+        # forward, backward data and backward filter are cached separately
+        assert torch.backends.mudnn.conv_algo_cache_size() == 3
+        # a second call hits the cache
+        out_again = torch.nn.functional.conv2d(x, w, bias.musa(), padding=1)
+        assert torch.backends.mudnn.conv_algo_cache_size() == 3
+    assert not torch.backends.mudnn.benchmark
+    assert torch.allclose(out.detach().cpu(), golden, atol=1e-4, rtol=1e-4)
+    assert torch.equal(out.detach(), out_again.detach())
+
+    cache_file = str(tmp_path / "conv_algos.txt")
+    torch.backends.mudnn.save_conv_algo_cache(cache_file)
+    torch.backends.mudnn.clear_conv_algo_cache()
+    assert torch.backends.mudnn.conv_algo_cache_size() == 0
+    torch.backends.mudnn.load_conv_algo_cache(cache_file)
+    assert torch.backends.mudnn.conv_algo_cache_size() == 3
+    torch.backends.mudnn.clear_conv_algo_cache()
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+def test_conv2d_benchmark_mode_graph_capture():
+    # a cache miss inside a capture falls back to the recommended algorithm
+    x = torch.randn(2, 8, 32, 32, device="musa")
+    w = torch.randn(16, 8, 3, 3, device="musa")
+    side = torch.musa.Stream()
+    side.wait_stream(torch.musa.current_stream())
+    with torch.musa.stream(side):
+        torch.nn.functional.conv2d(x, w, padding=1)
+    torch.musa.current_stream().wait_stream(side)
+
+    torch.backends.mudnn.clear_conv_algo_cache()
+    g = torch.musa.MUSAGraph()
+    with torch.backends.mudnn.flags(benchmark=True):
+        with torch.musa.graph(g):
+            out = torch.nn.functional.conv2d(x, w, padding=1)
+    assert torch.backends.mudnn.conv_algo_cache_size() == 0
+    g.replay()
+    torch.musa.synchronize()
+    golden = torch.nn.functional.conv2d(x.cpu(), w.cpu(), padding=1)
+    assert torch.allclose(out.cpu(), golden, atol=1e-4, rtol=1e-4)
+
+
+def test_mudnn_benchmark_workspace_limit_get_set():
+    orig = torch.backends.mudnn.benchmark_workspace_limit
+    torch.backends.mudnn.benchmark_workspace_limit = 64 << 20
+    assert torch.backends.mudnn.benchmark_workspace_limit == 64 << 20
+    torch.backends.mudnn.benchmark_workspace_limit = orig
+    assert torch.backends.mudnn.benchmark_workspace_limit == orig
@@ -137,3 +137,54 @@ def test_embedding_bwd(input_shape, dtype):
         comparators=comparator,
     )
     test.check_result()
+
+
+def sparse_update_golden(weight, momentum, grad_output, indices, lr, eps, wd, pad):
+    """dense gradient followed by an update of the touched rows only"""
+    grad = torch.ops.aten.embedding_dense_backward(
+        grad_output.float(), indices, weight.shape[0], pad, False
+    )
+    rows = indices.reshape(-1).unique()
+    rows = rows[rows != pad]
+    w = weight.float()
+    g = grad[rows] + wd * w[rows]
+    if momentum is None:
+        w[rows] -= lr * g
+        return w, None
+    m = momentum.clone()
+    m[rows] += g.pow(2).mean(1)
+    w[rows] -= lr * g / (m[rows].sqrt() + eps).unsqueeze(1)
+    return w, m
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+@pytest.mark.parametrize("input_shape", [(512,), (16, 256), (128, 512)])
+@pytest.mark.parametrize("dim", [16, 128, 300])
+@pytest.mark.parametrize("optimizer", ["sgd", "rowwise_adagrad"])
+@pytest.mark.parametrize("padding_idx", [-1, 3])
+def test_embedding_backward_sparse_update(input_shape, dim, optimizer, padding_idx):
+    num_weights = 1000
+    lr, eps, wd = 0.1, 1e-8, 0.01
+    weight = torch.randn(num_weights, dim)
+    momentum = torch.rand(num_weights) if optimizer == "rowwise_adagrad" else None
+    # a small index range so that rows repeat within the batch
+    indices = torch.randint(0, num_weights // 4, input_shape)
+    grad_output = torch.randn(*input_shape, dim)
+    golden_w, golden_m = sparse_update_golden(
+        weight, momentum, grad_output, indices, lr, eps, wd, padding_idx
+    )
+
+    for device in ["cpu", "musa"]:
+        w = weight.to(device)
+        args = (grad_output.to(device), indices.to(device), lr)
+        if optimizer == "sgd":
+            torch.ops.musa.embedding_backward_sgd_(
+                w, *args, weight_decay=wd, padding_idx=padding_idx
+            )
+        else:
+            m = momentum.to(device)
+            torch.ops.musa.embedding_backward_rowwise_adagrad_(
+                w, m, *args, eps=eps, weight_decay=wd, padding_idx=padding_idx
+            )
+            assert torch.allclose(m.cpu(), golden_m, atol=1e-4, rtol=1e-4)
+        assert torch.allclose(w.cpu(), golden_w, atol=1e-4, rtol=1e-4)
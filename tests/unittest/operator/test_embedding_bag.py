@@ -114,3 +114,97 @@ def notest_embedding_bag_fp16(input_data, mode):
         comparators=testing.DefaultComparator(abs_diff=1e-6),
     )
     test.check_musafp16_vs_musafp32({"input": input_data["input"]}, train=False)
+
+
+def make_grouped_inputs(num_tables, batch, include_last_offset):
+    weights, indices, offsets = [], [], []
+    for t in range(num_tables):
+        rows = random.randint(1, 300)
+        dim = random.choice([4, 16, 33, 64])
+        weights.append(torch.randn(rows, dim))
+        lengths = torch.randint(0, 6, [batch])
+        offsets_t = torch.cat([torch.zeros(1, dtype=torch.long), lengths.cumsum(0)])
+        indices.append(torch.randint(0, rows, [int(offsets_t[-1])]))
+        offsets.append(offsets_t if include_last_offset else offsets_t[:-1])
+    return weights, indices, offsets
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+@pytest.mark.parametrize("num_tables", [1, 7, 64])
+@pytest.mark.parametrize("batch", [1, 32])
+@pytest.mark.parametrize("mode", ["sum", "mean"])
+@pytest.mark.parametrize("include_last_offset", [False, True])
+def test_grouped_embedding_bag(num_tables, batch, mode, include_last_offset):
+    weights, indices, offsets = make_grouped_inputs(
+        num_tables, batch, include_last_offset
+    )
+    mode_id = {"sum": 0, "mean": 1}[mode]
+    golden_w = [w.clone().requires_grad_() for w in weights]
+    golden = [
+        torch.nn.functional.embedding_bag(
+            i, w, o, mode=mode, include_last_offset=include_last_offset
+        )
+        for w, i, o in zip(golden_w, indices, offsets)
+    ]
+    grads = [torch.randn_like(g) for g in golden]
+    torch.autograd.backward(golden, grads)
+
+    musa_w = [w.musa().requires_grad_() for w in weights]
+    outs = torch.ops.musa.grouped_embedding_bag(
+        musa_w,
+        [i.musa() for i in indices],
+        [o.musa() for o in offsets],
+        mode_id,
+        include_last_offset,
+    )
+    assert len(outs) == num_tables
+    for out, ref in zip(outs, golden):
+        assert torch.allclose(out.cpu(), ref.detach(), atol=1e-5, rtol=1e-5)
+
+    torch.autograd.backward(outs, [g.musa() for g in grads])
+    for w, ref in zip(musa_w, golden_w):
+        assert torch.allclose(w.grad.cpu(), ref.grad, atol=1e-5, rtol=1e-5)
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+def test_grouped_embedding_bag_partial_grad():
+    weights, indices, offsets = make_grouped_inputs(3, 8, False)
+    musa_w = [w.musa().requires_grad_() for w in weights]
+    outs = torch.ops.musa.grouped_embedding_bag(
+        musa_w, [i.musa() for i in indices], [o.musa() for o in offsets]
+    )
+    outs[1].sum().backward()
+    golden_w = weights[1].clone().requires_grad_()
+    torch.nn.functional.embedding_bag(
+        indices[1], golden_w, offsets[1], mode="sum"
+    ).sum().backward()
+    assert torch.allclose(musa_w[1].grad.cpu(), golden_w.grad)
+    assert (musa_w[0].grad.cpu() == 0).all()
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+def test_grouped_embedding_bag_trailing_indices():
+    # indices past the last offset belong to no bag and get no gradient
+    weights, indices, offsets = make_grouped_inputs(4, 8, True)
+    indices = [
+        torch.cat([i, torch.randint(0, w.size(0), [5])])
+        for w, i in zip(weights, indices)
+    ]
+    golden_w = [w.clone().requires_grad_() for w in weights]
+    golden = [
+        torch.nn.functional.embedding_bag(
+            i, w, o, mode="sum", include_last_offset=True
+        )
+        for w, i, o in zip(golden_w, indices, offsets)
+    ]
+    torch.autograd.backward(golden, [torch.ones_like(g) for g in golden])
+
+    musa_w = [w.musa().requires_grad_() for w in weights]
+    outs = torch.ops.musa.grouped_embedding_bag(
+        musa_w, [i.musa() for i in indices], [o.musa() for o in offsets], 0, True
+    )
+    for out, ref in zip(outs, golden):
+        assert torch.allclose(out.cpu(), ref.detach(), atol=1e-5, rtol=1e-5)
+    torch.autograd.backward(outs, [torch.ones_like(o) for o in outs])
+    for w, ref in zip(musa_w, golden_w):
+        assert torch.allclose(w.grad.cpu(), ref.grad, atol=1e-5, rtol=1e-5)
@@ -0,0 +1,146 @@
+"""Test the host-backed embedding with a device row cache."""
+
+# pylint: disable=missing-function-docstring, redefined-outer-name, unused-import
+import torch
+import torch.nn.functional as F
+import pytest
+
+import torch_musa
+from torch_musa import testing
+from torch_musa.utils.embedding_cache import (
+    CachedEmbedding,
+    SetAssociativeCachePlanner,
+)
+
+
+def lookup(planner, rows):
+    plan = planner.plan(torch.tensor(rows))
+    planner.release(plan)
+    return plan
+
+
+def test_planner_hits_and_slots():
+    planner = SetAssociativeCachePlanner(num_sets=4, associativity=2)
+    plan = planner.plan(torch.tensor([[1, 5], [1, 2]]))
+    assert plan.slots.shape == (2, 2)
+    assert plan.slots[0, 0] == plan.slots[1, 0]
+    # 1 and 5 share set 1 and take both of its ways
+    assert sorted((plan.slots.view(-1)[:2] // 2).tolist()) == [1, 1]
+    assert sorted(plan.fetch_rows.tolist()) == [1, 2, 5]
+    assert plan.evict_rows.numel() == 0 and plan.spill_rows.numel() == 0
+    planner.release(plan)
+
+    plan = lookup(planner, [5, 2])
+    assert plan.fetch_rows.numel() == 0
+    assert torch.equal(planner.tags.view(-1)[plan.slots], torch.tensor([5, 2]))
+
+
+@pytest.mark.parametrize("policy", ["lru", "lfu"])
+def test_planner_eviction(policy):
+    planner = SetAssociativeCachePlanner(num_sets=1, associativity=2, policy=policy)
+    lookup(planner, [0, 0, 0, 1])
+    lookup(planner, [1])
+    plan = lookup(planner, [2])
+    # lru drops 0 (used longest ago), lfu drops 1 (looked up twice vs. three times)
+    expected = 0 if policy == "lru" else 1
+    assert plan.evict_rows.tolist() == [expected]
+    assert sorted(planner.tags.view(-1).tolist()) == sorted([1 - expected, 2])
+
+
+def test_planner_locks_and_spill():
+    planner = SetAssociativeCachePlanner(num_sets=1, associativity=2)
+    pending = planner.plan(torch.tensor([0]))
+    # way of row 0 is locked, only one way is left for rows 1 and 2
+    plan = planner.plan(torch.tensor([1, 2]))
+    assert plan.fetch_rows.tolist() == [1]
+    assert plan.spill_rows.tolist() == [2]
+    assert plan.slots.tolist() == [plan.fetch_slots.item(), planner.num_slots]
+    planner.release(plan)
+
+    with pytest.raises(RuntimeError):
+        planner.plan(torch.tensor([3, 4, 5]), allow_spill=False)
+    assert sorted(planner.tags.view(-1).tolist()) == [0, 1]
+    planner.release(pending)
+    plan = lookup(planner, [3, 4])
+    assert sorted(plan.evict_rows.tolist()) == [0, 1]
+
+
+def run_cached_embedding(device, ahead=1):
+    torch.manual_seed(0)
+    num_embeddings, dim, lr = 1000, 16, 0.5
+    table = torch.randn(num_embeddings, dim)
+    emb = CachedEmbedding(
+        num_embeddings, dim, cache_rows=512, associativity=8, device=device,
+        _weight=table,
+    )
+    opt = torch.optim.SGD(emb.parameters(), lr=lr)
+    batches = [torch.randint(0, num_embeddings, (8, 6)) for _ in range(20)]
+    for indices in batches[:ahead]:
+        emb.prefetch(indices)
+    for i, indices in enumerate(batches):
+        out = emb(indices)
+        assert torch.allclose(out.cpu(), F.embedding(indices, table))
+        # queued before the optimizer step that still updates the cache
+        if i + ahead < len(batches):
+            emb.prefetch(batches[i + ahead])
+        out.sum().backward()
+        opt.step()
+        opt.zero_grad()
+        # d(sum)/d(row) is the number of lookups of the row
+        table.index_add_(0, indices.view(-1), torch.full((indices.numel(), dim), -lr))
+    assert torch.allclose(emb.flush(), table, atol=1e-5)
+
+
+@pytest.mark.parametrize("ahead", [1, 2])
+def test_cached_embedding_host(ahead):
+    run_cached_embedding("cpu", ahead)
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+@pytest.mark.parametrize("ahead", [1, 2])
+def test_cached_embedding(ahead):
+    run_cached_embedding("musa", ahead)
+
+
+def run_state_dict(device):
+    table = torch.randn(100, 4)
+    emb = CachedEmbedding(100, 4, cache_rows=16, associativity=4, device=device,
+                          _weight=table)
+    opt = torch.optim.SGD(emb.parameters(), lr=1.0)
+    indices = torch.tensor([3, 7, 7, 42])
+    emb(indices).sum().backward()
+    opt.step()
+    table.index_add_(0, indices, torch.full((4, 4), -1.0))
+
+    state = emb.state_dict()
+    assert list(state) == ["weight"]
+    assert torch.allclose(state["weight"], table)
+
+    other = CachedEmbedding(100, 4, cache_rows=16, associativity=4, device=device)
+    other(torch.tensor([3, 5]))
+    other.load_state_dict(state)
+    lookup_rows = torch.tensor([[3, 5], [42, 99]])
+    assert torch.allclose(other(lookup_rows).cpu(), F.embedding(lookup_rows, table))
+    # a plain nn.Embedding checkpoint loads as well
+    other.load_state_dict(torch.nn.Embedding(100, 4, _weight=table * 2).state_dict())
+    assert torch.allclose(other.flush(), table * 2)
+
+
+def test_cached_embedding_state_dict_host():
+    run_state_dict("cpu")
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+def test_cached_embedding_state_dict():
+    run_state_dict("musa")
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+def test_cached_embedding_spill_in_eval():
+    table = torch.randn(64, 4)
+    emb = CachedEmbedding(64, 4, cache_rows=4, associativity=2, _weight=table)
+    indices = torch.arange(64).view(8, 8)
+    with pytest.raises(RuntimeError):
+        emb(indices)
+    emb.eval()
+    assert torch.allclose(emb(indices).cpu(), F.embedding(indices, table))
@@ -0,0 +1,142 @@
+"""Test fused residual-add + RMSNorm/LayerNorm operators."""
+
+# pylint: disable=missing-function-docstring, redefined-outer-name, unused-import,invalid-name
+import pytest
+import torch
+import torch.nn.functional as F
+import torch_musa
+
+from torch_musa import testing
+from torch_musa.testing.base_test_tool import DefaultComparator
+
+SHAPES = [(2, 17, 256), (4, 1000), (3, 5, 4, 96)]
+
+
+def ref_rms_norm(x, normalized_shape, weight, eps):
+    dims = tuple(range(-len(normalized_shape), 0))
+    h = x.float()
+    out = h * torch.rsqrt(h.pow(2).mean(dims, keepdim=True) + eps)
+    if weight is not None:
+        out = out * weight.float()
+    return out.to(x.dtype)
+
+
+def run_fused(rms, x, residual, normalized_shape, weight, bias, eps):
+    if rms:
+        return torch.ops.musa.fused_add_rmsnorm(
+            x, residual, normalized_shape, weight, eps
+        )
+    return torch.ops.musa.fused_add_layernorm(
+        x, residual, normalized_shape, weight, bias, eps
+    )
+
+
+def run_ref(rms, x, residual, normalized_shape, weight, bias, eps):
+    h = x + residual
+    if rms:
+        return ref_rms_norm(h, normalized_shape, weight, eps), h
+    return F.layer_norm(h, normalized_shape, weight, bias, eps), h
+
+
+def make_inputs(shape, norm_ndim, affine, dtype, device, param_dtype=None):
+    param_dtype = param_dtype or dtype
+    normalized_shape = list(shape[-norm_ndim:])
+    x = torch.randn(shape, dtype=dtype, device=device, requires_grad=True)
+    residual = torch.randn(shape, dtype=dtype, device=device, requires_grad=True)
+    weight = bias = None
+    if affine:
+        weight = torch.randn(
+            normalized_shape, dtype=param_dtype, device=device, requires_grad=True
+        )
+        bias = torch.randn(
+            normalized_shape, dtype=param_dtype, device=device, requires_grad=True
+        )
+    return x, residual, normalized_shape, weight, bias
+
+
+def check_against_ref(rms, inputs, eps, comparator, ref_device="cpu"):
+    out, residual_out = run_fused(rms, *inputs, eps)
+    grad_out, grad_residual = torch.randn_like(out), torch.randn_like(residual_out)
+    torch.autograd.backward((out, residual_out), (grad_out, grad_residual))
+
+    ref_inputs = [
+        None if t is None else t.detach().to(ref_device).float().requires_grad_()
+        for t in (inputs[0], inputs[1], inputs[3], inputs[4])
+    ]
+    x, residual, weight, bias = ref_inputs
+    out_ref, residual_out_ref = run_ref(rms, x, residual, inputs[2], weight, bias, eps)
+    torch.autograd.backward(
+        (out_ref, residual_out_ref),
+        (grad_out.to(ref_device).float(), grad_residual.to(ref_device).float()),
+    )
+
+    assert comparator(out.float().cpu(), out_ref.cpu())
+    assert comparator(residual_out.float().cpu(), residual_out_ref.cpu())
+    params = [(inputs[0], x), (inputs[1], residual), (inputs[3], weight)]
+    if not rms:
+        params.append((inputs[4], bias))
+    for t, t_ref in params:
+        if t is not None:
+            assert comparator(t.grad.float().cpu(), t_ref.grad.cpu())
+
+
+@pytest.mark.parametrize("rms", [True, False])
+@pytest.mark.parametrize("shape", SHAPES)
+@pytest.mark.parametrize("affine", [True, False])
+def test_fused_add_norm_cpu(rms, shape, affine):
+    inputs = make_inputs(shape, 1, affine, torch.float32, "cpu")
+    check_against_ref(
+        rms, inputs, 1e-5, DefaultComparator(abs_diff=1e-4, rel_diff=1e-4)
+    )
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+@pytest.mark.parametrize("rms", [True, False])
+@pytest.mark.parametrize("shape", SHAPES)
+@pytest.mark.parametrize("norm_ndim", [1, 2])
+@pytest.mark.parametrize("affine", [True, False])
+@pytest.mark.parametrize("dtype", [torch.float32, torch.float16, torch.bfloat16])
+def test_fused_add_norm_musa(rms, shape, norm_ndim, affine, dtype):
+    inputs = make_inputs(shape, norm_ndim, affine, dtype, "musa")
+    if dtype == torch.float32:
+        comparator = DefaultComparator(abs_diff=1e-4, rel_diff=1e-4)
+    elif dtype == torch.float16:
+        comparator = DefaultComparator(abs_diff=5e-3, rel_diff=5e-3)
+    else:
+        comparator = DefaultComparator(abs_diff=5e-2, rel_diff=5e-2)
+    check_against_ref(rms, inputs, 1e-6, comparator)
+
+
+def run_float_params(rms, dtype, device):
+    # half/bf16 activations with the float32 weight and bias kept under AMP
+    inputs = make_inputs((4, 7, 256), 1, True, dtype, device, torch.float32)
+    comparator = DefaultComparator(abs_diff=5e-2, rel_diff=5e-2)
+    check_against_ref(rms, inputs, 1e-6, comparator)
+    assert inputs[3].grad.dtype == torch.float32
+
+
+@pytest.mark.parametrize("rms", [True, False])
+@pytest.mark.parametrize("dtype", [torch.float16, torch.bfloat16])
+def test_fused_add_norm_float_params_cpu(rms, dtype):
+    run_float_params(rms, dtype, "cpu")
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+@pytest.mark.parametrize("rms", [True, False])
+@pytest.mark.parametrize("dtype", [torch.float16, torch.bfloat16])
+def test_fused_add_norm_float_params(rms, dtype):
+    run_float_params(rms, dtype, "musa")
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+def test_fused_add_norm_no_grad():
+    x = torch.randn(8, 4096, dtype=torch.half, device="musa")
+    residual = torch.randn_like(x)
+    weight = torch.randn(4096, dtype=torch.half, device="musa")
+    with torch.no_grad():
+        out, residual_out = torch.ops.musa.fused_add_rmsnorm(
+            x, residual, [4096], weight
+        )
+    assert torch.equal(residual_out, x + residual)
+    out_ref = ref_rms_norm(x + residual, [4096], weight, 1e-6)
+    assert DefaultComparator(abs_diff=5e-3, rel_diff=5e-3)(out, out_ref)
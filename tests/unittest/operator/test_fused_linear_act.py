@@ -0,0 +1,131 @@
+"""Test fused linear/conv activation epilogue operators."""
+
+# pylint: disable=missing-function-docstring, redefined-outer-name, unused-import
+import torch
+from torch import nn
+import torch.nn.functional as F
+import pytest
+
+import torch_musa
+from torch_musa import testing
+from torch_musa.utils.fusion import fuse_linear_act
+
+ACTS = ["none", "relu", "gelu", "silu"]
+
+
+def ref_act(x, act):
+    if act == "relu":
+        return F.relu(x)
+    if act == "gelu":
+        return F.gelu(x)
+    if act == "silu":
+        return F.silu(x)
+    return x
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+@pytest.mark.parametrize("shape", [(1, 64), (4, 7, 128), (33, 96)])
+@pytest.mark.parametrize("out_features", [16, 80])
+@pytest.mark.parametrize("act", ACTS)
+@pytest.mark.parametrize("has_bias", [True, False])
+def test_fused_linear_act(shape, out_features, act, has_bias):
+    x = torch.randn(shape)
+    w = torch.randn(out_features, shape[-1])
+    b = torch.randn(out_features) if has_bias else None
+    golden = ref_act(F.linear(x, w, b), act)
+
+    out_cpu = torch.ops.musa.fused_linear_act(x, w, b, act)
+    assert torch.allclose(out_cpu, golden, atol=1e-5, rtol=1e-5)
+
+    out = torch.ops.musa.fused_linear_act(
+        x.musa(), w.musa(), b.musa() if has_bias else None, act
+    )
+    assert out.shape == golden.shape
+    assert torch.allclose(out.cpu(), golden, atol=1e-3, rtol=1e-3)
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+# bias row, [1, N] bias, full residual, broadcast column (unfused fallback)
+@pytest.mark.parametrize("self_shape", [(80,), (1, 80), (33, 80), (33, 1)])
+@pytest.mark.parametrize("beta, alpha", [(1, 1), (0.5, 2)])
+@pytest.mark.parametrize("act", ACTS)
+@pytest.mark.parametrize("transposed_mat2", [True, False])
+def test_fused_addmm_act(self_shape, beta, alpha, act, transposed_mat2):
+    self_ = torch.randn(self_shape)
+    mat1 = torch.randn(33, 96)
+    mat2 = torch.randn(80, 96).t() if transposed_mat2 else torch.randn(96, 80)
+    golden = ref_act(torch.addmm(self_, mat1, mat2, beta=beta, alpha=alpha), act)
+
+    out_cpu = torch.ops.musa.fused_addmm_act(
+        self_, mat1, mat2, beta=beta, alpha=alpha, act=act
+    )
+    assert torch.allclose(out_cpu, golden, atol=1e-5, rtol=1e-5)
+
+    out = torch.ops.musa.fused_addmm_act(
+        self_.musa(), mat1.musa(), mat2.musa(), beta=beta, alpha=alpha, act=act
+    )
+    assert out.shape == golden.shape
+    assert torch.allclose(out.cpu(), golden, atol=1e-3, rtol=1e-3)
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+@pytest.mark.parametrize(
+    "config",
+    [
+        # input, out_c, kernel, stride, padding, dilation, groups
+        [(2, 8, 16, 16), 16, (3, 3), [1, 1], [1, 1], [1, 1], 1],
+        [(2, 8, 16, 16), 8, (3, 3), [2, 2], [1, 1], [1, 1], 8],
+        [(1, 4, 6, 8, 8), 8, (3, 3, 3), [1, 1, 1], [1, 1, 1], [1, 1, 1], 1],
+    ],
+)
+@pytest.mark.parametrize("act", ACTS)
+def test_fused_conv_bias_act(config, act):
+    in_shape, out_c, kernel, stride, padding, dilation, groups = config
+    x = torch.randn(in_shape)
+    w = torch.randn(out_c, in_shape[1] // groups, *kernel)
+    b = torch.randn(out_c)
+    golden = ref_act(
+        torch.convolution(x, w, b, stride, padding, dilation, False, [0], groups),
+        act,
+    )
+    out = torch.ops.musa.fused_conv_bias_act(
+        x.musa(), w.musa(), b.musa(), stride, padding, dilation, groups, act
+    )
+    assert torch.allclose(out.cpu(), golden, atol=1e-3, rtol=1e-3)
+
+
+class _MLP(nn.Module):
+    def __init__(self):
+        super().__init__()
+        self.conv = nn.Conv2d(3, 8, 3, padding=1)
+        self.fc1 = nn.Linear(8 * 8 * 8, 64)
+        self.act = nn.GELU()
+        self.fc2 = nn.Linear(64, 32)
+        self.proj = nn.Parameter(torch.randn(32, 16))
+        self.proj_bias = nn.Parameter(torch.randn(16))
+
+    def forward(self, x):
+        x = F.silu(self.conv(x))
+        x = self.act(self.fc1(x.flatten(1)))
+        x = torch.relu(self.fc2(x))
+        return F.silu(torch.addmm(self.proj_bias, x, self.proj))
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+def test_fuse_linear_act_pass():
+    model = _MLP().eval()
+    x = torch.randn(4, 3, 8, 8)
+    golden = model(x)
+
+    fused = fuse_linear_act(model)
+    targets = [n.target for n in fused.graph.nodes if n.op == "call_function"]
+    assert targets.count(torch.ops.musa.fused_linear_act) == 2
+    assert targets.count(torch.ops.musa.fused_conv_bias_act) == 1
+    assert targets.count(torch.ops.musa.fused_addmm_act) == 1
+
+    fused = fused.to("musa")
+    out = fused(x.musa())
+    assert torch.allclose(out.cpu(), golden, atol=1e-3, rtol=1e-3)
+
+    with pytest.raises(RuntimeError):
+        fuse_linear_act(model.train())
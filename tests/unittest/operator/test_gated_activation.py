@@ -0,0 +1,100 @@
+"""Test fused SwiGLU/GeGLU operators."""
+
+# pylint: disable=missing-function-docstring, redefined-outer-name, unused-import,invalid-name
+import pytest
+import torch
+import torch.nn.functional as F
+import torch_musa
+
+from torch_musa import testing
+
+SHAPES = [(2, 17, 256), (4, 1000), (3, 5, 4, 96), (0, 64)]
+
+# (op, kwargs, activation of the gate)
+ACTIVATIONS = [
+    (torch.ops.musa.swiglu, {}, F.silu),
+    (torch.ops.musa.geglu, {}, F.gelu),
+    (
+        torch.ops.musa.geglu,
+        {"approximate": "tanh"},
+        lambda x: F.gelu(x, approximate="tanh"),
+    ),
+]
+
+DTYPES = [(torch.float32, 1e-5), (torch.float16, 2e-3), (torch.bfloat16, 2e-2)]
+
+
+def make_inputs(shape, two_inputs, dtype, device):
+    torch.manual_seed(1234)
+    if two_inputs:
+        tensors = [torch.randn(shape), torch.randn(shape)]
+    else:
+        tensors = [torch.randn(shape[:-1] + (2 * shape[-1],))]
+    return [t.to(dtype).to(device).requires_grad_() for t in tensors]
+
+
+def run_ref(act, inputs):
+    if len(inputs) == 2:
+        a, b = inputs
+    else:
+        a, b = torch.chunk(inputs[0], 2, dim=-1)
+    return act(a) * b
+
+
+def check(op, kwargs, act, shape, two_inputs, dtype, tol, device):
+    inputs = make_inputs(shape, two_inputs, dtype, device)
+    out = op(*inputs, **kwargs)
+    assert out.shape == shape and out.dtype == dtype
+    grad_out = torch.randn(shape).to(dtype).to(device)
+    out.backward(grad_out)
+
+    ref_inputs = [t.detach().float().cpu().requires_grad_() for t in inputs]
+    ref_out = run_ref(act, ref_inputs)
+    ref_out.backward(grad_out.float().cpu())
+    torch.testing.assert_close(out.float().cpu(), ref_out, atol=tol, rtol=tol)
+    for t, ref_t in zip(inputs, ref_inputs):
+        torch.testing.assert_close(
+            t.grad.float().cpu(), ref_t.grad, atol=tol * 4, rtol=tol * 4
+        )
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+@pytest.mark.parametrize("op, kwargs, act", ACTIVATIONS)
+@pytest.mark.parametrize("shape", SHAPES)
+@pytest.mark.parametrize("two_inputs", [False, True])
+@pytest.mark.parametrize("dtype, tol", DTYPES)
+def test_gated_activation(op, kwargs, act, shape, two_inputs, dtype, tol):
+    check(op, kwargs, act, shape, two_inputs, dtype, tol, "musa")
+
+
+@pytest.mark.parametrize("op, kwargs, act", ACTIVATIONS)
+@pytest.mark.parametrize("two_inputs", [False, True])
+def test_gated_activation_cpu(op, kwargs, act, two_inputs):
+    check(op, kwargs, act, (2, 17, 256), two_inputs, torch.float32, 1e-5, "cpu")
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+def test_gated_activation_non_contiguous():
+    torch.manual_seed(1234)
+    x = torch.randn(64, 512, device="musa").t()
+    out = torch.ops.musa.swiglu(x)
+    ref = run_ref(F.silu, [x.cpu()])
+    torch.testing.assert_close(out.cpu(), ref, atol=1e-5, rtol=1e-5)
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+def test_swiglu_matches_gated_silu():
+    torch.manual_seed(1234)
+    x = torch.randn(4, 32, 1024, device="musa")
+    torch.testing.assert_close(
+        torch.ops.musa.swiglu(x), torch.gated_silu(x), atol=1e-6, rtol=1e-5
+    )
+
+
+def test_gated_activation_errors():
+    with pytest.raises(RuntimeError):
+        torch.ops.musa.swiglu(torch.randn(4, 5))
+    with pytest.raises(RuntimeError):
+        torch.ops.musa.swiglu(torch.randn(4, 6), torch.randn(4, 3))
+    with pytest.raises(RuntimeError):
+        torch.ops.musa.geglu(torch.randn(4, 6), approximate="sigmoid")
@@ -0,0 +1,45 @@
+"""Test masked_select operators."""
+
+# pylint: disable=missing-function-docstring, redefined-outer-name, unused-import
+import torch
+import pytest
+import torch_musa
+from torch_musa import testing
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+@pytest.mark.parametrize(
+    "shapes",
+    [[(10,), (10,)], [(4, 8), (4, 8)], [(4, 8), (8,)], [(2, 1, 6), (3, 1)]],
+)
+@pytest.mark.parametrize("size", [0, 4, 100])
+@pytest.mark.parametrize("dtype", [torch.float32, torch.int64])
+def test_masked_select_static(shapes, size, dtype):
+    x = torch.randint(-5, 5, shapes[0]).to(dtype)
+    mask = torch.rand(shapes[1]) > 0.5
+    golden = torch.masked_select(x, mask)
+    n = min(size, golden.numel())
+    for device in ["cpu", "musa"]:
+        out, count = torch.ops.musa.masked_select_static(
+            x.to(device), mask.to(device), size, 9
+        )
+        assert count.item() == golden.numel()
+        assert out.shape == (size,)
+        assert torch.equal(out[:n].cpu(), golden[:n])
+        assert (out[n:].cpu() == 9).all()
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+def test_masked_select_static_sync_free():
+    x = torch.randn(128).musa()
+    mask = x > 0
+    torch.musa.set_sync_debug_mode("error")
+    try:
+        out, count = torch.ops.musa.masked_select_static(x, mask, 128)
+        with pytest.raises(RuntimeError, match="synchronizing MUSA operation"):
+            torch.masked_select(x, mask)
+    finally:
+        torch.musa.set_sync_debug_mode("default")
+    golden = torch.masked_select(x.cpu(), mask.cpu())
+    assert count.item() == golden.numel()
+    assert torch.equal(out[: golden.numel()].cpu(), golden)
@@ -59,3 +59,24 @@ def test_mm_fp16(input_data):
     test.check_musafp16_vs_musafp32()
     test.check_out_ops(fp16=True)
     test.check_grad_fn(fp16=True)
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+def test_mm_alternating_streams():
+    # handles are rebound to the current stream only when it changes, make
+    # sure switching back and forth still launches on the right stream
+    lhs = torch.randn(64, 32)
+    rhs = torch.randn(32, 16)
+    golden = torch.mm(lhs, rhs)
+    lhs_musa, rhs_musa = lhs.musa(), rhs.musa()
+    streams = [torch.musa.Stream(), torch.musa.current_stream(), torch.musa.Stream()]
+    outs = []
+    for i in range(6):
+        stream = streams[i % len(streams)]
+        stream.wait_stream(torch.musa.current_stream())
+        with torch.musa.stream(stream):
+            outs.append(torch.mm(lhs_musa, rhs_musa).softmax(-1))
+        torch.musa.current_stream().wait_stream(stream)
+    torch.musa.synchronize()
+    for out in outs:
+        assert torch.allclose(out.cpu(), golden.softmax(-1), atol=1e-3)
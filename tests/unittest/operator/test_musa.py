@@ -40,3 +40,40 @@ def test_allow_tf32_get_set():
     torch.backends.mudnn.allow_tf32 = not orig
     assert torch_musa._MUSAC._get_allow_tf32() == (not orig)
     torch.backends.mudnn.allow_tf32 = orig
+
+
+def test_mudnn_op_cache_get_set():
+    orig = torch.backends.mudnn.op_cache
+    assert torch_musa._MUSAC._get_mudnn_op_cache() == orig
+
+    torch.backends.mudnn.op_cache = not orig
+    assert torch_musa._MUSAC._get_mudnn_op_cache() == (not orig)
+    torch.backends.mudnn.op_cache = orig
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+def test_mudnn_op_cache_results():
+    x = torch.randn(4, 8, 6, 6)
+    w = torch.randn(8, 8, 3, 3)
+    m = torch.randn(8 * 6 * 6, 16)
+    orig = torch.backends.mudnn.op_cache
+    results = []
+    for op_cache in [True, False]:
+        torch.backends.mudnn.op_cache = op_cache
+        out = []
+        # run twice so that the second call hits the cache
+        for _ in range(2):
+            x_m = x.musa()
+            out.append(
+                [
+                    x_m.sum(dim=(2, 3)).cpu(),
+                    torch.softmax(x_m, dim=1).cpu(),
+                    torch.mm(x_m.flatten(1), m.musa()).cpu(),
+                    torch.nn.functional.conv2d(x_m, w.musa(), padding=1).cpu(),
+                ]
+            )
+        results.append(out)
+    torch.backends.mudnn.op_cache = orig
+    flat = [t for out in results for ts in out for t in ts]
+    for i, t in enumerate(flat):
+        assert torch.equal(t, flat[i % 4])
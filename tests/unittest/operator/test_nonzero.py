@@ -60,3 +60,38 @@ def test_count_nonzero(input_data, dtype):
     test = testing.OpTest(func=torch.count_nonzero, input_args=input_args)
     test.check_result()
     test.check_grad_fn()
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+@pytest.mark.parametrize("input_shape", [(), (10,), (256, 2), (2, 4, 6, 8)])
+@pytest.mark.parametrize("size", [0, 5, 100, 2000])
+@pytest.mark.parametrize("fill_value", [-1, 7])
+def test_nonzero_static(input_shape, size, fill_value):
+    x = torch.randint(0, 3, input_shape).float()
+    golden = torch.nonzero_static(x, size=size, fill_value=fill_value)
+    true_count = torch.count_nonzero(x)
+
+    out = torch.nonzero_static(x.musa(), size=size, fill_value=fill_value)
+    assert torch.equal(out.cpu(), golden)
+
+    for device in ["cpu", "musa"]:
+        out, count = torch.ops.musa.nonzero_static(x.to(device), size, fill_value)
+        assert count.device.type == device
+        assert torch.equal(out.cpu(), golden)
+        assert count.item() == true_count.item()
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+def test_nonzero_static_sync_free():
+    x = torch.randn(64, 32).musa()
+    torch.musa.set_sync_debug_mode("error")
+    try:
+        out, count = torch.ops.musa.nonzero_static(x, 100)
+        torch.nonzero_static(x, size=100)
+        with pytest.raises(RuntimeError, match="synchronizing MUSA operation"):
+            torch.nonzero(x)
+    finally:
+        torch.musa.set_sync_debug_mode(0)
+    assert torch.musa.get_sync_debug_mode() == 0
+    assert torch.equal(out.cpu(), torch.nonzero_static(x.cpu(), size=100))
+    assert count.item() == 64 * 32
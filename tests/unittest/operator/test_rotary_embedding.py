@@ -0,0 +1,115 @@
+"""Test fused rotary position embedding operators."""
+
+# pylint: disable=missing-function-docstring, redefined-outer-name, unused-import,invalid-name
+import pytest
+import torch
+import torch_musa
+
+from torch_musa import testing
+from torch_musa.testing.base_test_tool import DefaultComparator
+
+
+def rope_cache(max_positions, rot_dim, base=10000.0):
+    inv_freq = 1.0 / (base ** (torch.arange(0, rot_dim, 2).float() / rot_dim))
+    freqs = torch.outer(torch.arange(max_positions).float(), inv_freq)
+    return freqs.cos(), freqs.sin()
+
+
+def ref_rope(x, cos, sin, position_ids, interleaved):
+    """Eager RoPE as in HF LLaMA (NeoX) and GPT-J, x: [B, S, H, D]."""
+    rot_dim = 2 * cos.shape[-1]
+    if position_ids is None:
+        position_ids = torch.arange(x.shape[1])
+    cos = cos[position_ids].unsqueeze(-2)
+    sin = sin[position_ids].unsqueeze(-2)
+    if position_ids.dim() == 1:
+        cos, sin = cos.unsqueeze(0), sin.unsqueeze(0)
+    rot, rest = x[..., :rot_dim].float(), x[..., rot_dim:]
+    if interleaved:
+        cos = cos.repeat_interleave(2, -1)
+        sin = sin.repeat_interleave(2, -1)
+        x1, x2 = rot[..., ::2], rot[..., 1::2]
+        rotated = torch.stack((-x2, x1), dim=-1).flatten(-2)
+    else:
+        cos, sin = torch.cat((cos, cos), -1), torch.cat((sin, sin), -1)
+        x1, x2 = rot.chunk(2, -1)
+        rotated = torch.cat((-x2, x1), -1)
+    out = rot * cos + rotated * sin
+    return torch.cat((out.to(x.dtype), rest), -1)
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+@pytest.mark.parametrize("interleaved", [False, True])
+@pytest.mark.parametrize("rot_dim", [64, 32])
+@pytest.mark.parametrize("position_kind", ["none", "shared", "batched"])
+@pytest.mark.parametrize("dtype", [torch.float32, torch.float16])
+def test_fused_rope(interleaved, rot_dim, position_kind, dtype):
+    batch, seq_len, num_heads, num_kv_heads, head_dim = 2, 17, 8, 2, 64
+    cos, sin = rope_cache(64, rot_dim)
+    position_ids = {
+        "none": None,
+        "shared": torch.arange(5, 5 + seq_len),
+        "batched": torch.randint(0, 64, (batch, seq_len)),
+    }[position_kind]
+    q = torch.randn(batch, seq_len, num_heads, head_dim).to(dtype)
+    k = torch.randn(batch, seq_len, num_kv_heads, head_dim).to(dtype)
+    q_ref = ref_rope(q, cos, sin, position_ids, interleaved)
+    k_ref = ref_rope(k, cos, sin, position_ids, interleaved)
+    if dtype == torch.float16:
+        comparator = DefaultComparator(abs_diff=1e-3, rel_diff=1e-3)
+    else:
+        comparator = DefaultComparator(abs_diff=1e-5, rel_diff=1e-5)
+
+    q_cpu, k_cpu = q.clone(), k.clone()
+    torch.ops.musa.fused_rope_(q_cpu, k_cpu, cos, sin, position_ids, interleaved)
+    assert comparator(q_cpu, q_ref)
+    assert comparator(k_cpu, k_ref)
+
+    q_musa, k_musa = q.musa(), k.musa()
+    pos_musa = None if position_ids is None else position_ids.musa()
+    torch.ops.musa.fused_rope_(
+        q_musa, k_musa, cos.musa(), sin.musa(), pos_musa, interleaved
+    )
+    assert comparator(q_musa.cpu(), q_ref)
+    assert comparator(k_musa.cpu(), k_ref)
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+@pytest.mark.parametrize("device", ["cpu", "musa"])
+def test_fused_rope_strided(device):
+    # [B, H, S, D] projections transposed to [B, S, H, D] are rotated in place
+    cos, sin = rope_cache(32, 64)
+    q = torch.randn(2, 4, 16, 64, device=device)
+    k = torch.randn(2, 4, 16, 64, device=device)
+    q_ref = ref_rope(q.transpose(1, 2).cpu(), cos, sin, None, False)
+    k_ref = ref_rope(k.transpose(1, 2).cpu(), cos, sin, None, False)
+    torch.ops.musa.fused_rope_(
+        q.transpose(1, 2), k.transpose(1, 2), cos.to(device), sin.to(device)
+    )
+    comparator = DefaultComparator(abs_diff=1e-5, rel_diff=1e-5)
+    assert comparator(q.transpose(1, 2).cpu(), q_ref)
+    assert comparator(k.transpose(1, 2).cpu(), k_ref)
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+@pytest.mark.parametrize("device", ["cpu", "musa"])
+@pytest.mark.parametrize("interleaved", [False, True])
+def test_fused_rope_backward(device, interleaved):
+    cos, sin = rope_cache(32, 32)
+    cos, sin = cos.to(device), sin.to(device)
+    position_ids = torch.randint(0, 32, (2, 9), device=device)
+    q = torch.randn(2, 9, 4, 64, device=device, requires_grad=True)
+    k = torch.randn(2, 9, 2, 64, device=device, requires_grad=True)
+    q_out, k_out = torch.ops.musa.fused_rope(q, k, cos, sin, position_ids, interleaved)
+    grad_q, grad_k = torch.randn_like(q_out), torch.randn_like(k_out)
+    torch.autograd.backward((q_out, k_out), (grad_q, grad_k))
+
+    q_ref = q.detach().cpu().requires_grad_()
+    k_ref = k.detach().cpu().requires_grad_()
+    args = (cos.cpu(), sin.cpu(), position_ids.cpu(), interleaved)
+    torch.autograd.backward(
+        (ref_rope(q_ref, *args), ref_rope(k_ref, *args)), (grad_q.cpu(), grad_k.cpu())
+    )
+    comparator = DefaultComparator(abs_diff=1e-5, rel_diff=1e-5)
+    assert comparator(q.grad.cpu(), q_ref.grad)
+    assert comparator(k.grad.cpu(), k_ref.grad)
@@ -0,0 +1,169 @@
+"""Test SyncBatchNorm operators."""
+
+# pylint: disable=missing-function-docstring, redefined-outer-name, unused-import,invalid-name
+import pytest
+import torch
+import torch.nn.functional as F
+import torch_musa
+
+from torch_musa import testing
+
+EPS = 1e-5
+MOMENTUM = 0.1
+
+# (shape, memory_format), the last two split every channel across blocks
+INPUTS = [
+    ((8, 16, 7, 7), torch.contiguous_format),
+    ((8, 16, 7, 7), torch.channels_last),
+    ((32, 64), torch.contiguous_format),
+    ((4, 8, 33), torch.contiguous_format),
+    ((2, 3, 4, 5, 6), torch.channels_last_3d),
+    ((64, 4, 64, 64), torch.contiguous_format),
+    ((64, 4, 64, 64), torch.channels_last),
+]
+
+DTYPES = [(torch.float32, 1e-4), (torch.float16, 2e-2), (torch.bfloat16, 1e-1)]
+
+
+def make_input(shape, memory_format, dtype):
+    torch.manual_seed(1234)
+    x = torch.randn(shape) * 2.0 + 0.5
+    return x.to(dtype).to("musa").contiguous(memory_format=memory_format)
+
+
+def ref_stats(x):
+    x = x.float().cpu().transpose(0, 1).reshape(x.size(1), -1)
+    mean = x.mean(1)
+    var = x.var(1, unbiased=False)
+    return mean, var, x.size(1)
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+@pytest.mark.parametrize("shape, memory_format", INPUTS)
+@pytest.mark.parametrize("dtype, tol", DTYPES)
+def test_batch_norm_stats(shape, memory_format, dtype, tol):
+    x = make_input(shape, memory_format, dtype)
+    mean, invstd = torch.batch_norm_stats(x, EPS)
+    ref_mean, ref_var, _ = ref_stats(x)
+    assert mean.dtype == torch.float32
+    torch.testing.assert_close(mean.cpu(), ref_mean, atol=tol, rtol=tol)
+    torch.testing.assert_close(
+        invstd.cpu(), torch.rsqrt(ref_var + EPS), atol=tol, rtol=tol
+    )
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+@pytest.mark.parametrize("shape, memory_format", INPUTS)
+def test_batch_norm_gather_stats_with_counts(shape, memory_format):
+    x = make_input(shape, memory_format, torch.float32)
+    # uneven shards of the batch, empty ones included, as the ranks would hold
+    shards = list(torch.tensor_split(x, [1, 1, x.size(0) // 2], dim=0))
+    stats = [torch.batch_norm_stats(s, EPS) for s in shards]
+    mean_all = torch.stack([m for m, _ in stats])
+    invstd_all = torch.stack([i for _, i in stats])
+    counts = torch.tensor(
+        [s.numel() // s.size(1) for s in shards], dtype=torch.float, device="musa"
+    )
+    running_mean = torch.rand(x.size(1), device="musa")
+    running_var = torch.rand(x.size(1), device="musa") + 0.5
+    ref_running_mean = running_mean.cpu()
+    ref_running_var = running_var.cpu()
+    mean, invstd = torch.batch_norm_gather_stats_with_counts(
+        x,
+        mean_all,
+        invstd_all,
+        running_mean,
+        running_var,
+        MOMENTUM,
+        EPS,
+        counts,
+    )
+    ref_mean, ref_var, n = ref_stats(x)
+    torch.testing.assert_close(mean.cpu(), ref_mean, atol=1e-4, rtol=1e-4)
+    torch.testing.assert_close(
+        invstd.cpu(), torch.rsqrt(ref_var + EPS), atol=1e-4, rtol=1e-4
+    )
+    torch.testing.assert_close(
+        running_mean.cpu(),
+        (1 - MOMENTUM) * ref_running_mean + MOMENTUM * ref_mean,
+        atol=1e-4,
+        rtol=1e-4,
+    )
+    torch.testing.assert_close(
+        running_var.cpu(),
+        (1 - MOMENTUM) * ref_running_var + MOMENTUM * ref_var * n / (n - 1),
+        atol=1e-4,
+        rtol=1e-4,
+    )
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+@pytest.mark.parametrize("shape, memory_format", INPUTS)
+@pytest.mark.parametrize("dtype, tol", DTYPES)
+@pytest.mark.parametrize("affine", [True, False])
+def test_batch_norm_elemt(shape, memory_format, dtype, tol, affine):
+    x = make_input(shape, memory_format, dtype)
+    weight = torch.rand(x.size(1), device="musa") if affine else None
+    bias = torch.rand(x.size(1), device="musa") if affine else None
+    mean, invstd = torch.batch_norm_stats(x, EPS)
+    out = torch.batch_norm_elemt(x, weight, bias, mean, invstd, EPS)
+    assert out.dtype == dtype
+    assert out.is_contiguous(memory_format=memory_format)
+    ref = F.batch_norm(
+        x.float().cpu(),
+        None,
+        None,
+        weight.cpu() if affine else None,
+        bias.cpu() if affine else None,
+        training=True,
+        eps=EPS,
+    )
+    torch.testing.assert_close(out.float().cpu(), ref, atol=tol, rtol=tol)
+
+    out_buf = torch.empty(0, dtype=dtype, device="musa")
+    torch.batch_norm_elemt(x, weight, bias, mean, invstd, EPS, out=out_buf)
+    assert torch.equal(out_buf, out)
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+@pytest.mark.parametrize("shape, memory_format", INPUTS)
+@pytest.mark.parametrize("dtype, tol", DTYPES)
+def test_batch_norm_backward(shape, memory_format, dtype, tol):
+    x = make_input(shape, memory_format, dtype)
+    torch.manual_seed(4321)
+    grad_out = torch.randn(shape).to(dtype).to("musa")
+    grad_out = grad_out.contiguous(memory_format=memory_format)
+    weight = torch.rand(x.size(1), device="musa")
+    bias = torch.rand(x.size(1), device="musa")
+
+    mean, invstd = torch.batch_norm_stats(x, EPS)
+    sum_dy, sum_dy_xmu, grad_weight, grad_bias = torch.batch_norm_backward_reduce(
+        grad_out, x, mean, invstd, weight, True, True, True
+    )
+    count = torch.tensor([x.numel() // x.size(1)], dtype=torch.int32, device="musa")
+    grad_input = torch.batch_norm_backward_elemt(
+        grad_out, x, mean, invstd, weight, sum_dy, sum_dy_xmu, count
+    )
+
+    x_ref = x.float().cpu().requires_grad_()
+    weight_ref = weight.cpu().requires_grad_()
+    bias_ref = bias.cpu().requires_grad_()
+    F.batch_norm(x_ref, None, None, weight_ref, bias_ref, True, eps=EPS).backward(
+        grad_out.float().cpu()
+    )
+    assert grad_input.dtype == dtype
+    torch.testing.assert_close(
+        grad_input.float().cpu(), x_ref.grad, atol=tol, rtol=tol
+    )
+    torch.testing.assert_close(
+        grad_weight.cpu(), weight_ref.grad, atol=tol * 10, rtol=tol
+    )
+    torch.testing.assert_close(grad_bias.cpu(), bias_ref.grad, atol=tol * 10, rtol=tol)
+    torch.testing.assert_close(sum_dy, grad_bias)
+
+    # only the requested outputs are computed
+    outputs = torch.batch_norm_backward_reduce(
+        grad_out, x, mean, invstd, weight, False, True, False
+    )
+    assert outputs[0] is None and outputs[1] is None and outputs[3] is None
+    torch.testing.assert_close(outputs[2], grad_weight)
@@ -69,6 +69,77 @@ def test_nms(num_boxes, iou_threshold, dtype):
     test.check_result()
 
 
+def get_batched_boxes(batch, num_boxes, num_classes):
+    xy = torch.rand(batch, num_boxes, 2) * 100
+    wh = torch.rand(batch, num_boxes, 2) * 30 + 1
+    boxes = torch.cat((xy, xy + wh), dim=-1)
+    scores = torch.rand(batch, num_boxes)
+    idxs = torch.randint(0, num_classes, size=(batch, num_boxes))
+    return boxes, scores, idxs
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+@pytest.mark.parametrize("batch", [1, 3])
+@pytest.mark.parametrize("num_boxes", [10, 500, 3000])
+@pytest.mark.parametrize("iou_threshold", [0.7, 0.3])
+@pytest.mark.parametrize("max_output", [-1, 100])
+def test_musa_batched_nms(batch, num_boxes, iou_threshold, max_output):
+    boxes, scores, idxs = get_batched_boxes(batch, num_boxes, 5)
+    keep_cpu, num_cpu = torch.ops.musa.batched_nms(
+        boxes, scores, idxs, iou_threshold, max_output
+    )
+    for b in range(batch):
+        golden = torchvision.ops.batched_nms(
+            boxes[b], scores[b], idxs[b], iou_threshold
+        )
+        if max_output >= 0:
+            golden = golden[:max_output]
+        assert num_cpu[b].item() == golden.numel()
+        assert torch.equal(keep_cpu[b, : golden.numel()], golden)
+        assert (keep_cpu[b, golden.numel() :] == -1).all()
+
+    keep, num = torch.ops.musa.batched_nms(
+        boxes.musa(), scores.musa(), idxs.musa(), iou_threshold, max_output
+    )
+    assert torch.equal(keep.cpu(), keep_cpu)
+    assert torch.equal(num.cpu(), num_cpu)
+
+    # class agnostic
+    keep_cpu, num_cpu = torch.ops.musa.batched_nms(
+        boxes, scores, None, iou_threshold, max_output
+    )
+    keep, num = torch.ops.musa.batched_nms(
+        boxes.musa(), scores.musa(), None, iou_threshold, max_output
+    )
+    assert torch.equal(keep.cpu(), keep_cpu)
+    assert torch.equal(num.cpu(), num_cpu)
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+@pytest.mark.parametrize("dtype", [torch.float16, torch.bfloat16])
+def test_musa_batched_nms_low_precision(dtype):
+    # the host reference takes the dtypes the device path takes and rounds the
+    # same way, so both keep exactly the same boxes
+    if testing.get_musa_arch() < 22 and dtype == torch.bfloat16:
+        return
+    boxes, scores, idxs = get_batched_boxes(2, 500, 5)
+    boxes, scores = boxes.to(dtype), scores.to(dtype)
+    keep_cpu, num_cpu = torch.ops.musa.batched_nms(boxes, scores, idxs, 0.5, -1)
+    keep, num = torch.ops.musa.batched_nms(
+        boxes.musa(), scores.musa(), idxs.musa(), 0.5, -1
+    )
+    assert torch.equal(keep.cpu(), keep_cpu)
+    assert torch.equal(num.cpu(), num_cpu)
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+def test_nms_many_boxes():
+    boxes, scores, _ = get_batched_boxes(1, 20000, 1)
+    golden = torchvision.ops.nms(boxes[0], scores[0], 0.5)
+    out = torchvision.ops.nms(boxes[0].musa(), scores[0].musa(), 0.5)
+    assert torch.equal(out.cpu(), golden)
+
+
 @testing.test_on_nonzero_card_if_multiple_musa_device(1)
 @pytest.mark.parametrize("dtype", support_dtypes)
 @pytest.mark.parametrize("spatial_scale", [0.5, 1.0, 1.5, 2.0])
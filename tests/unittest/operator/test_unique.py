@@ -155,3 +155,41 @@ def test_unique_dim(input_data, data_type, return_inverse, return_counts):
         )
         test.check_result()
         test.check_grad_fn()
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+@pytest.mark.parametrize("shape", [(0,), (1,), (33,), (4, 5, 6)])
+@pytest.mark.parametrize("size", [0, 3, 10, 200])
+@pytest.mark.parametrize("dtype", [torch.float32, torch.int64])
+def test_unique_static(shape, size, dtype):
+    x = torch.randint(0, 12, shape).to(dtype)
+    values, inverse, counts = torch.unique(
+        x, sorted=True, return_inverse=True, return_counts=True
+    )
+    n = min(size, values.numel())
+    for device in ["cpu", "musa"]:
+        out, out_inverse, out_counts, num = torch.ops.musa.unique_static(
+            x.to(device), size, True, True, -1
+        )
+        assert num.device.type == device
+        assert num.item() == values.numel()
+        assert torch.equal(out[:n].cpu(), values[:n])
+        assert (out[n:].cpu() == -1).all()
+        assert torch.equal(out_inverse.cpu(), inverse)
+        assert torch.equal(out_counts[:n].cpu(), counts[:n])
+        assert (out_counts[n:].cpu() == 0).all()
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+def test_unique_static_sync_free():
+    x = torch.randint(0, 50, (1000,)).musa()
+    torch.musa.set_sync_debug_mode("error")
+    try:
+        out, _, _, num = torch.ops.musa.unique_static(x, 64)
+        with pytest.raises(RuntimeError, match="synchronizing MUSA operation"):
+            torch.unique(x)
+    finally:
+        torch.musa.set_sync_debug_mode("default")
+    golden = torch.unique(x.cpu())
+    assert num.item() == golden.numel()
+    assert torch.equal(out[: golden.numel()].cpu(), golden)
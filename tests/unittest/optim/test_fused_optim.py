@@ -0,0 +1,245 @@
+"""Test FusedAdam and FusedSGD optimizers"""
+
+# pylint: disable=missing-function-docstring, unused-import
+import pytest
+import torch
+import torch_musa
+from torch_musa.optim import FusedAdam, FusedSGD
+
+SIZES = [[4096, 1024], [4096], [1023, 17], [1]]
+ITERS = 7
+
+
+def make_params(dtype, sizes=None, device="musa"):
+    torch.manual_seed(9876)
+    return [torch.rand(size, dtype=dtype, device=device) for size in sizes or SIZES]
+
+
+def gen_grads(params, seed):
+    torch.manual_seed(seed)
+    return [torch.rand_like(p) for p in params]
+
+
+def run_pair(
+    ref_optim_cls, ref_kwargs, tst_optim_cls, tst_kwargs, dtype, scale=1.0, sizes=None
+):
+    """Runs both optimizers on identical grads; the reference sees fp32 grads
+    unscaled on the host side."""
+    tensors = make_params(dtype, sizes)
+    ref_params = [torch.nn.Parameter(t.float().clone()) for t in tensors]
+    tst_params = [torch.nn.Parameter(t.clone()) for t in tensors]
+    ref_optim = ref_optim_cls(ref_params, **ref_kwargs)
+    tst_optim = tst_optim_cls(tst_params, **tst_kwargs)
+    for it in range(ITERS):
+        grads = gen_grads(tst_params, it)
+        for p_ref, p_tst, g in zip(ref_params, tst_params, grads):
+            p_ref.grad = g.float()
+            p_tst.grad = (g.float() * scale).to(dtype)
+        if scale != 1.0:
+            tst_optim.grad_scale = torch.tensor(scale, device="musa")
+            tst_optim.found_inf = torch.tensor(0.0, device="musa")
+        ref_optim.step()
+        tst_optim.step()
+    return ref_params, tst_params, tst_optim
+
+
+def assert_close(ref_params, tst_params, atol, rtol):
+    for p_ref, p_tst in zip(ref_params, tst_params):
+        torch.testing.assert_close(p_tst.float(), p_ref, atol=atol, rtol=rtol)
+
+
+@pytest.mark.parametrize("adam_w_mode", [True, False])
+@pytest.mark.parametrize("amsgrad", [True, False])
+@pytest.mark.parametrize("weight_decay", [0.0, 0.01])
+def test_fused_adam(adam_w_mode, amsgrad, weight_decay):
+    option = {
+        "lr": 5e-4,
+        "betas": (0.9, 0.999),
+        "eps": 1e-8,
+        "weight_decay": weight_decay,
+        "amsgrad": amsgrad,
+    }
+    ref_cls = torch.optim.AdamW if adam_w_mode else torch.optim.Adam
+    ref_params, tst_params, _ = run_pair(
+        ref_cls,
+        option,
+        FusedAdam,
+        dict(option, adam_w_mode=adam_w_mode),
+        torch.float32,
+    )
+    assert_close(ref_params, tst_params, atol=1e-6, rtol=1e-5)
+
+
+@pytest.mark.parametrize("momentum", [0.0, 0.9])
+@pytest.mark.parametrize("nesterov", [True, False])
+@pytest.mark.parametrize("weight_decay", [0.0, 0.01])
+def test_fused_sgd(momentum, nesterov, weight_decay):
+    if nesterov and momentum == 0.0:
+        return
+    option = {
+        "lr": 0.01,
+        "momentum": momentum,
+        "nesterov": nesterov,
+        "weight_decay": weight_decay,
+    }
+    ref_params, tst_params, _ = run_pair(
+        torch.optim.SGD, option, FusedSGD, option, torch.float32
+    )
+    assert_close(ref_params, tst_params, atol=1e-6, rtol=1e-5)
+
+
+@pytest.mark.parametrize(
+    "optim_cls, ref_cls, option",
+    [
+        (FusedAdam, torch.optim.AdamW, {"lr": 5e-4, "weight_decay": 0.01}),
+        (FusedSGD, torch.optim.SGD, {"lr": 0.01, "momentum": 0.9}),
+    ],
+)
+def test_many_small_tensors(optim_cls, ref_cls, option):
+    # more tensors than one launch takes, the metadata goes to device memory
+    # and is reused across the steps
+    sizes = [[17 + i % 5, 13] for i in range(3000)] + [[300000]]
+    ref_params, tst_params, _ = run_pair(
+        ref_cls, option, optim_cls, option, torch.float32, sizes=sizes
+    )
+    assert_close(ref_params, tst_params, atol=1e-6, rtol=1e-5)
+
+
+def test_many_small_tensors_graph_capture():
+    # during capture the metadata stays in the kernel arguments, the graph
+    # must not read cached device tables
+    sizes = [[17 + i % 5, 13] for i in range(300)]
+    option = {"lr": 0.01, "momentum": 0.9}
+    tensors = make_params(torch.float32, sizes)
+    ref_params = [torch.nn.Parameter(t.clone()) for t in tensors]
+    tst_params = [torch.nn.Parameter(t.clone()) for t in tensors]
+    for p in ref_params + tst_params:
+        p.grad = torch.zeros_like(p)
+    ref_optim = torch.optim.SGD(ref_params, **option)
+    tst_optim = FusedSGD(tst_params, **option)
+
+    def set_grads(seed):
+        for p_ref, p_tst, g in zip(ref_params, tst_params, gen_grads(tst_params, seed)):
+            p_ref.grad.copy_(g)
+            p_tst.grad.copy_(g)
+
+    # the first step creates the momentum buffers, outside the capture
+    side = torch.musa.Stream()
+    side.wait_stream(torch.musa.current_stream())
+    with torch.musa.stream(side):
+        set_grads(0)
+        ref_optim.step()
+        tst_optim.step()
+    torch.musa.current_stream().wait_stream(side)
+
+    graph = torch.musa.MUSAGraph()
+    with torch.musa.graph(graph):
+        tst_optim.step()
+    for it in range(1, ITERS):
+        set_grads(it)
+        ref_optim.step()
+        graph.replay()
+    torch.musa.synchronize()
+    assert_close(ref_params, tst_params, atol=1e-6, rtol=1e-5)
+
+
+@pytest.mark.parametrize("dtype", [torch.float16, torch.bfloat16])
+@pytest.mark.parametrize(
+    "optim_cls, option",
+    [
+        (FusedAdam, {"lr": 5e-4, "weight_decay": 0.01}),
+        (FusedSGD, {"lr": 0.01, "momentum": 0.9}),
+    ],
+)
+def test_master_weights(dtype, optim_cls, option):
+    ref_cls = torch.optim.AdamW if optim_cls is FusedAdam else torch.optim.SGD
+    ref_params, tst_params, tst_optim = run_pair(
+        ref_cls, option, optim_cls, dict(option, master_weights=True), dtype
+    )
+    for p_ref, p_tst in zip(ref_params, tst_params):
+        state = tst_optim.state[p_tst]
+        assert state["master_param"].dtype == torch.float32
+        torch.testing.assert_close(
+            state["master_param"], p_ref, atol=1e-5, rtol=1e-4
+        )
+        assert torch.equal(p_tst, state["master_param"].to(dtype))
+
+
+@pytest.mark.parametrize("optim_cls", [FusedAdam, FusedSGD])
+def test_grad_scaler_states(optim_cls):
+    option = {"lr": 0.01}
+    if optim_cls is FusedSGD:
+        option["momentum"] = 0.9
+    ref_cls = torch.optim.AdamW if optim_cls is FusedAdam else torch.optim.SGD
+    if optim_cls is FusedAdam:
+        option["weight_decay"] = 0.0
+    ref_params, tst_params, tst_optim = run_pair(
+        ref_cls, option, optim_cls, option, torch.float32, scale=1024.0
+    )
+    assert_close(ref_params, tst_params, atol=1e-5, rtol=1e-4)
+
+    # an overflowed step leaves params, states and the step count untouched
+    before = [p.detach().clone() for p in tst_params]
+    states = [
+        {k: v.clone() for k, v in tst_optim.state[p].items()} for p in tst_params
+    ]
+    steps = [g.get("step") for g in tst_optim.param_groups]
+    steps = [None if s is None else s.clone() for s in steps]
+    for p in tst_params:
+        p.grad = torch.full_like(p, float("inf"))
+    tst_optim.grad_scale = torch.tensor(1024.0, device="musa")
+    tst_optim.found_inf = torch.tensor(1.0, device="musa")
+    tst_optim.step()
+    for p, p_before, state in zip(tst_params, before, states):
+        assert torch.equal(p, p_before)
+        for k, v in state.items():
+            assert torch.equal(tst_optim.state[p][k], v)
+    for group, step in zip(tst_optim.param_groups, steps):
+        if step is not None:
+            assert torch.equal(group["step"], step)
+
+
+@pytest.mark.parametrize("dampening", [0.0, 0.5])
+def test_fused_sgd_overflow_on_first_step(dampening):
+    # the skipped first step must not count as the momentum initialization
+    torch.manual_seed(0)
+    params = [torch.randn(257, device="musa"), torch.randn(3, 5, device="musa")]
+    tst_params = [p.clone().requires_grad_() for p in params]
+    ref_params = [p.clone().requires_grad_() for p in params]
+    tst_optim = FusedSGD(tst_params, lr=0.01, momentum=0.9, dampening=dampening)
+    ref_optim = torch.optim.SGD(ref_params, lr=0.01, momentum=0.9, dampening=dampening)
+
+    for p in tst_params:
+        p.grad = torch.full_like(p, float("inf"))
+    tst_optim.grad_scale = torch.tensor(1024.0, device="musa")
+    tst_optim.found_inf = torch.tensor(1.0, device="musa")
+    tst_optim.step()
+    for p, p_init in zip(tst_params, params):
+        assert torch.equal(p, p_init)
+
+    for _ in range(3):
+        grads = [torch.randn_like(p) for p in params]
+        for p, g in zip(tst_params, grads):
+            p.grad = g * 1024.0
+        for p, g in zip(ref_params, grads):
+            p.grad = g.clone()
+        tst_optim.grad_scale = torch.tensor(1024.0, device="musa")
+        tst_optim.found_inf = torch.tensor(0.0, device="musa")
+        tst_optim.step()
+        ref_optim.step()
+    assert_close(ref_params, tst_params, atol=1e-5, rtol=1e-4)
+
+
+def test_grad_scaler_integration():
+    model = torch.nn.Linear(64, 64).to("musa")
+    optim = FusedAdam(model.parameters(), lr=1e-3)
+    scaler = torch.musa.amp.GradScaler()
+    x = torch.randn(8, 64, device="musa")
+    before = [p.detach().clone() for p in model.parameters()]
+    loss = model(x).pow(2).mean()
+    scaler.scale(loss).backward()
+    scaler.step(optim)
+    scaler.update()
+    assert not hasattr(optim, "grad_scale")
+    for p, p_before in zip(model.parameters(), before):
+        assert not torch.equal(p, p_before)
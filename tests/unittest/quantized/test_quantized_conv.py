@@ -363,3 +363,62 @@ def test_qconv2d_silu_add(input_data):
     assert (
         qoutput.int_repr().cpu().to(torch.int32) - foutput.int_repr().to(torch.int32)
     ).max() <= 1
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+@pytest.mark.skipif(
+    testing.get_musa_arch() < 22,
+    reason="Quantized conv supported in QY2 or later",
+)
+@pytest.mark.parametrize("input_data", conv_input_data)
+def test_qconv2d_per_channel(input_data):
+    """Test quantized conv2d operators with per-output-channel weight scales"""
+    conv2d_args = {
+        "in_channels": input_data["in_channels"],
+        "out_channels": input_data["out_channels"],
+        "kernel_size": input_data["kernel_size"],
+        "stride": input_data["stride"],
+        "padding": input_data["padding"],
+        "dilation": input_data["dilation"],
+        "groups": input_data["groups"],
+        "bias": input_data["bias"],
+    }
+    data = input_data["input"]
+    module = torch.nn.Conv2d(**conv2d_args)
+    fweight = module.weight
+    fbias = module.bias
+    scales = fweight.detach().abs().amax(dim=(1, 2, 3)).clamp_min(1e-8) / 2**7
+    qweight = torch.quantize_per_channel(
+        fweight, scales.double(), torch.zeros_like(scales, dtype=torch.long), 0, torch.qint8
+    )
+    module.weight = torch.nn.Parameter(qweight.dequantize())
+
+    if input_data["relu"]:
+        qmodule = nniq.ConvReLU2d(**conv2d_args)
+    else:
+        qmodule = nnq.Conv2d(**conv2d_args)
+    qmodule.set_weight_bias(
+        qweight.to("musa"), fbias.to("musa") if fbias is not None else None
+    )
+
+    qdata = torch.quantize_per_tensor(
+        data, float(data.abs().max()) / 2**7, 0, torch.qint8
+    )
+    foutput = module(qdata.dequantize())
+    if input_data["relu"]:
+        foutput = torch.relu(foutput)
+
+    out_scale = float(foutput.abs().max() / 2**7)
+    qmodule.scale = out_scale
+    qmodule.zero_point = 0
+    qoutput = qmodule(qdata.to("musa"))
+
+    foutput = torch.quantize_per_tensor(foutput, out_scale, 0, torch.qint8)
+    assert (
+        qoutput.int_repr().cpu().to(torch.int32)
+        - foutput.int_repr().cpu().to(torch.int32)
+    ).abs().max() <= 1
+
+    unpacked_weight, _ = qmodule._weight_bias()
+    assert unpacked_weight.qscheme() == torch.per_channel_affine
+    assert torch.equal(unpacked_weight.int_repr().cpu(), qweight.int_repr())
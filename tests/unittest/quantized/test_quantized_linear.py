@@ -109,3 +109,114 @@ def test_qlinear(input_data):
         qoutput.int_repr().cpu().to(torch.int32)
         - foutput.int_repr().cpu().to(torch.int32)
     ).max() <= 1
+
+
+weight_only_input_data = [
+    {"M": 1, "in_features": 256, "out_features": 512, "bits": 8, "group_size": -1},
+    {"M": 4, "in_features": 256, "out_features": 512, "bits": 8, "group_size": 64},
+    {"M": 16, "in_features": 512, "out_features": 256, "bits": 4, "group_size": 128},
+    {"M": 3, "in_features": 512, "out_features": 128, "bits": 4, "group_size": -1},
+    {"M": 17, "in_features": 256, "out_features": 512, "bits": 8, "group_size": 64},
+    {"M": 32, "in_features": 256, "out_features": 256, "bits": 4, "group_size": 64},
+]
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+@pytest.mark.parametrize("input_data", weight_only_input_data)
+@pytest.mark.parametrize("dtype", [torch.float16, torch.float32])
+@pytest.mark.parametrize("bias", [True, False])
+@pytest.mark.parametrize("batch_shape", [[], [2]])
+def test_linear_weight_only(input_data, dtype, bias, batch_shape):
+    """Test weight-only int8/int4 quantized linear against its host reference
+
+    The device kernel takes inputs of at most 16 rows once flattened, so 2-D
+    inputs cover it up to that bound and batched ones take the MatMul path.
+    """
+    M, K, N = input_data["M"], input_data["in_features"], input_data["out_features"]
+    weight = torch.randn(N, K)
+    fbias = torch.randn(N) if bias else None
+    data = torch.randn(*batch_shape, M, K).to(dtype)
+
+    # host reference, packed and computed on cpu
+    cpu_packed = torch.ops.quantized.linear_weight_only_prepack(
+        weight, fbias, input_data["bits"], input_data["group_size"]
+    )
+    cpu_output = torch.ops.quantized.linear_weight_only(data, cpu_packed)
+
+    # the reference must match a plain linear with the dequantized weight
+    dq_weight, _ = cpu_packed.unpack()
+    golden = torch.nn.functional.linear(data.float(), dq_weight, fbias)
+    assert torch.allclose(cpu_output.float(), golden, atol=1e-2, rtol=1e-2)
+
+    musa_packed = torch.ops.quantized.linear_weight_only_prepack(
+        weight.to("musa"),
+        fbias.to("musa") if bias else None,
+        input_data["bits"],
+        input_data["group_size"],
+    )
+    musa_output = torch.ops.quantized.linear_weight_only(data.to("musa"), musa_packed)
+    assert musa_output.dtype == dtype
+    assert musa_output.shape == (*batch_shape, M, N)
+    atol, rtol = (1e-2, 1e-2) if dtype == torch.float16 else (1e-4, 1e-4)
+    assert torch.allclose(musa_output.cpu().float(), cpu_output.float(), atol=atol, rtol=rtol)
+
+    # dynamic linear entry shares the same packed params
+    dyn_output = torch.ops.quantized.linear_dynamic(data.to("musa"), musa_packed)
+    assert torch.allclose(dyn_output.cpu(), musa_output.cpu())
+
+
+@testing.test_on_nonzero_card_if_multiple_musa_device(1)
+@pytest.mark.skipif(
+    testing.get_musa_arch() < 22, reason="Quantized Lineare supported in QY2 or later"
+)
+@pytest.mark.parametrize("input_data", linear_input_data)
+@pytest.mark.parametrize("input_zero_point", [0, 3])
+def test_qlinear_per_channel(input_data, input_zero_point):
+    """Test quantized linear operators with per-output-channel weight scales"""
+    data = input_data["input"]
+    module = torch.nn.Linear(
+        input_data["in_features"], input_data["out_features"], input_data["bias"]
+    )
+    fweight = module.weight
+    fbias = module.bias
+    scales = fweight.detach().abs().amax(dim=1).clamp_min(1e-8) / 2**7
+    qweight = torch.quantize_per_channel(
+        fweight, scales.double(), torch.zeros_like(scales, dtype=torch.long), 0, torch.qint8
+    )
+    module.weight = torch.nn.Parameter(qweight.dequantize())
+
+    if input_data["relu"]:
+        qmodule = nniq.LinearReLU(
+            input_data["in_features"],
+            input_data["out_features"],
+            input_data["bias"],
+            input_data["dtype"],
+        )
+    else:
+        qmodule = nnq.Linear(
+            input_data["in_features"],
+            input_data["out_features"],
+            input_data["bias"],
+            input_data["dtype"],
+        )
+    qmodule.set_weight_bias(
+        qweight.to("musa"), fbias.to("musa") if fbias is not None else None
+    )
+
+    qdata = torch.quantize_per_tensor(
+        data, float(data.abs().max() / 2**7), input_zero_point, torch.qint8
+    )
+    foutput = module(qdata.dequantize())
+    if input_data["relu"]:
+        foutput = torch.relu(foutput)
+
+    out_scale = float(foutput.abs().max() / 2**7)
+    qmodule.scale = out_scale
+    qmodule.zero_point = 0
+    qoutput = qmodule(qdata.to("musa"))
+
+    foutput = torch.quantize_per_tensor(foutput, out_scale, 0, torch.qint8)
+    assert (
+        qoutput.int_repr().cpu().to(torch.int32)
+        - foutput.int_repr().cpu().to(torch.int32)
+    ).abs().max() <= 1
@@ -72,6 +72,8 @@ from .core.device import (
     is_available,
     device_count,
     synchronize,
+    set_sync_debug_mode,
+    get_sync_debug_mode,
     get_device_name,
     get_device_capability,
     get_device_properties,
@@ -89,6 +91,12 @@ from .core.stream import (
     Stream,
     Event,
 )
+from .core.graphs import (
+    is_current_stream_capturing,
+    graph_pool_handle,
+    MUSAGraph,
+    graph,
+)
 from .core import amp
 from .core.amp.common import (
     amp_definitely_not_available,
@@ -106,7 +114,11 @@ from .core.amp.common import (
 
 torch.autocast = torch.musa.amp.AutocastBase
 
-from .core.serialization import register_deserialization
+from .core.serialization import (
+    register_deserialization,
+    streaming_load,
+    StreamingLoadStats,
+)
 
 from .core import memory
 from .core.memory import (
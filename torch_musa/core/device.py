@@ -5,7 +5,7 @@ This package adds support for Moore Threads GPU device type implementation.
 # pylint: disable=W0622
 
 
-from typing import Any, Tuple, Optional
+from typing import Any, Tuple, Optional, Union
 from functools import lru_cache
 import torch_musa._MUSAC
 from ._lazy_init import _lazy_init
@@ -154,6 +154,35 @@ def synchronize(device: _device_t = None) -> None:
         return torch_musa._MUSAC._musa_synchronize()
 
 
+def set_sync_debug_mode(debug_mode: Union[int, str]) -> None:
+    r"""Sets the debug mode for musa synchronizing operations.
+
+    Args:
+        debug_mode(str or int): if "default" or 0, don't error or warn on
+            synchronizing operations, if "warn" or 1, warn on synchronizing
+            operations, if "error" or 2, error out synchronizing operations.
+    """
+    _lazy_init()
+    if isinstance(debug_mode, str):
+        if debug_mode == "default":
+            debug_mode = 0
+        elif debug_mode == "warn":
+            debug_mode = 1
+        elif debug_mode == "error":
+            debug_mode = 2
+        else:
+            raise RuntimeError(
+                "invalid value of debug_mode, expected one of `default`, `warn`, `error`"
+            )
+    torch_musa._MUSAC._musa_set_sync_debug_mode(debug_mode)
+
+
+def get_sync_debug_mode() -> int:
+    r"""Returns current value of debug mode for musa synchronizing operations."""
+    _lazy_init()
+    return torch_musa._MUSAC._musa_get_sync_debug_mode()
+
+
 @lru_cache(maxsize=1)
 def device_count() -> int:
     """Returns the number of Moore Threads GPUs avaiable."""
@@ -0,0 +1,197 @@
+"""Capture MUSA work into a graph and replay it with a single launch"""
+
+# pylint: disable=invalid-name, W0236, W0246
+import gc
+from typing import Optional
+
+import torch_musa
+from ._utils import _dummy_type
+from .memory import empty_cache
+from .device import synchronize
+from .stream import Stream, stream as _stream_ctx
+
+if not hasattr(torch_musa._MUSAC, "_MUSAGraph"):
+    # Define dummy base classes
+    torch_musa._MUSAC.__dict__["_MUSAGraph"] = _dummy_type("_MUSAGraph")
+    torch_musa._MUSAC.__dict__["_graph_pool_handle"] = _dummy_type(
+        "_graph_pool_handle"
+    )
+
+__all__ = ["is_current_stream_capturing", "graph_pool_handle", "MUSAGraph", "graph"]
+
+
+def is_current_stream_capturing():
+    r"""
+    Returns True if MUSA graph capture is underway on the current MUSA stream,
+    False otherwise.
+
+    If a MUSA context does not exist on the current device, returns False
+    without initializing the context.
+    """
+    return torch_musa._MUSAC._musa_isCurrentStreamCapturing()
+
+
+def graph_pool_handle():
+    r"""
+    Returns an opaque token representing the id of a graph memory pool.
+    See :ref:`Graph memory management<graph-memory-management>`.
+    """
+    return torch_musa._MUSAC._graph_pool_handle()
+
+
+class MUSAGraph(torch_musa._MUSAC._MUSAGraph):
+    r"""
+    Wrapper around a MUSA graph.
+
+    Kernels issued on the capturing stream between :meth:`capture_begin` and
+    :meth:`capture_end` are recorded, not run. :meth:`replay` launches all of
+    them with a single host call. Tensors allocated during capture live in a
+    private memory pool of the graph, so their addresses stay valid across
+    replays: feed new inputs by copying into the tensors used at capture time
+    and read results from the tensors produced at capture time.
+
+    Random ops (dropout, bernoulli, ...) on the default generator draw fresh
+    numbers on every replay.
+    """
+
+    def __new__(cls):
+        return super(MUSAGraph, cls).__new__(cls)
+
+    def capture_begin(self, pool=None, capture_error_mode="global"):
+        r"""
+        Begins capturing MUSA work on the current stream.
+
+        Typically, you shouldn't call ``capture_begin`` yourself.
+        Use :class:`~torch_musa.graph`, which calls ``capture_begin`` internally.
+
+        Arguments:
+            pool (optional): Token (returned by :func:`~torch_musa.graph_pool_handle`
+                or :meth:`other_Graph_instance.pool()<torch_musa.MUSAGraph.pool>`)
+                that hints this graph may share memory with the indicated pool.
+            capture_error_mode (str, optional): specifies the musaStreamCaptureMode
+                for the graph capture stream. Can be "global", "thread_local" or
+                "relaxed". During capture, potentially unsafe API calls such as
+                musaMalloc from other threads are prohibited in "global" mode,
+                only from this thread in "thread_local" mode and allowed in
+                "relaxed" mode.
+        """  # noqa: B950
+        super().capture_begin(pool=pool, capture_error_mode=capture_error_mode)
+
+    def capture_end(self):
+        r"""
+        Ends MUSA graph capture on the current stream.
+        After ``capture_end``, ``replay`` may be called on this instance.
+
+        Typically, you shouldn't call ``capture_end`` yourself.
+        Use :class:`~torch_musa.graph`, which calls ``capture_end`` internally.
+        """
+        super().capture_end()
+
+    def replay(self):
+        r"""
+        Replays the MUSA work captured by this graph.
+        """
+        super().replay()
+
+    def reset(self):
+        r"""
+        Deletes the graph currently held by this instance.
+        """
+        super().reset()
+
+    def pool(self):
+        r"""
+        Returns an opaque token representing the id of this graph's memory pool.
+        This id can optionally be passed to another graph's ``capture_begin``,
+        which hints the other graph may share the same memory pool.
+        """
+        return super().pool()
+
+    def enable_debug_mode(self):
+        r"""
+        Keeps the captured graph alive after instantiation so that
+        :meth:`debug_dump` can print it.
+        """
+        return super().enable_debug_mode()
+
+    def debug_dump(self, debug_path):
+        r"""
+        Arguments:
+            debug_path (required): Path to dump the graph to.
+
+        Calls a debugging function to dump the graph if the debugging is
+        enabled via MUSAGraph.enable_debug_mode()
+        """
+        return super().debug_dump(debug_path)
+
+
+class graph:
+    r"""
+    Context-manager that captures MUSA work into a :class:`torch_musa.MUSAGraph`
+    object for later replay.
+
+    Arguments:
+        musa_graph (torch_musa.MUSAGraph): Graph object used for capture.
+        pool (optional): Opaque token (returned by a call to
+            :func:`~torch_musa.graph_pool_handle()` or
+            :meth:`other_Graph_instance.pool()<torch_musa.MUSAGraph.pool>`)
+            hinting this graph's capture may share memory from the specified pool.
+        stream (torch_musa.Stream, optional): If supplied, will be set as the
+            current stream in the context. If not supplied, ``graph`` sets its
+            own internal side stream as the current stream in the context.
+        capture_error_mode (str, optional): specifies the musaStreamCaptureMode
+            for the graph capture stream, see :meth:`MUSAGraph.capture_begin`.
+
+    .. note::
+        For effective memory sharing, if you pass a ``pool`` used by a previous
+        capture and the previous capture used an explicit ``stream`` argument,
+        you should pass the same ``stream`` argument to this capture.
+
+    .. warning::
+        Run the captured work once eagerly on a side stream before capturing it,
+        so that lazy initialization (handles, workspaces, autotuning) does not
+        happen inside the capture.
+    """
+
+    default_capture_stream: Optional[Stream] = None
+
+    def __init__(
+        self,
+        musa_graph,
+        pool=None,
+        stream=None,
+        capture_error_mode: str = "global",
+    ):
+        # Lazy-init here rather than at module level because it needs the
+        # device to be initialized.
+        if self.__class__.default_capture_stream is None:
+            self.__class__.default_capture_stream = Stream()
+
+        self.pool = () if pool is None else (pool,)
+        self.capture_stream = (
+            stream if stream is not None else self.__class__.default_capture_stream
+        )
+        assert self.capture_stream is not None
+        self.stream_ctx = _stream_ctx(self.capture_stream)
+        self.musa_graph = musa_graph
+        self.capture_error_mode = capture_error_mode
+
+    def __enter__(self):
+        # Free as much memory as we can for the graph
+        synchronize()
+        gc.collect()
+        empty_cache()
+
+        # Stackoverflow seems comfortable with this pattern
+        # https://stackoverflow.com/questions/26635684/calling-enter-and-exit-manually#39172487
+        self.stream_ctx.__enter__()
+
+        self.musa_graph.capture_begin(
+            *self.pool, capture_error_mode=self.capture_error_mode
+        )
+
+    def __exit__(self, exc_type, exc_value, traceback):
+        self.musa_graph.capture_end()
+        self.stream_ctx.__exit__(exc_type, exc_value, traceback)
+        # returning None should propagate exceptions from either capture_end or
+        # stream_ctx.__exit__()
@@ -115,6 +115,10 @@ def memory_stats(device=None):
       number of over-size allocation requests received by the memory allocator.
     - ``"oversize_segments.{current,peak,allocated,freed}"``:
       number of over-size reserved segments from ``musaMalloc()``.
+    - ``"mublas_workspace_bytes.{current,peak,allocated,freed}"``:
+      amount of memory held as mublas workspaces, one per (handle, stream)
+      pair, sized by ``MUBLAS_WORKSPACE_CONFIG``. Also counted in
+      ``allocated_bytes``.
 
     Args:
         device (torch.device or int, optional): selected device. Returns
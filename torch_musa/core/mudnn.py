@@ -12,17 +12,22 @@ def version():
     return torch_musa._MUSAC._mudnn_version()
 
 
-def set_flags(_allow_tf32: bool):
-    orig_flags = (torch_musa._MUSAC._get_allow_tf32(),)
+def set_flags(_allow_tf32: bool, _benchmark=None):
+    orig_flags = (
+        torch_musa._MUSAC._get_allow_tf32(),
+        torch_musa._MUSAC._get_mudnn_benchmark(),
+    )
     torch_musa._MUSAC._set_allow_tf32(_allow_tf32)
+    if _benchmark is not None:
+        torch_musa._MUSAC._set_mudnn_benchmark(_benchmark)
     return orig_flags
 
 
 @contextmanager
-def flags(allow_tf32=True):
-    """Some useful flags to setup. We only have allow_tf32 for now."""
+def flags(allow_tf32=True, benchmark=False):
+    """Some useful flags to setup: allow_tf32 and benchmark."""
     with __allow_nonbracketed_mutation():
-        orig_flags = set_flags(allow_tf32)
+        orig_flags = set_flags(allow_tf32, benchmark)
     try:
         yield
     finally:
@@ -31,6 +36,27 @@ def flags(allow_tf32=True):
             set_flags(*orig_flags)
 
 
+def save_conv_algo_cache(path: str):
+    """Persist the convolution algorithms picked in benchmark mode to ``path``."""
+    torch_musa._MUSAC._mudnn_conv_algo_cache_save(path)
+
+
+def load_conv_algo_cache(path: str):
+    """Load convolution algorithms saved by ``save_conv_algo_cache``, entries are
+    merged into the in-memory cache so the next run skips the benchmark."""
+    torch_musa._MUSAC._mudnn_conv_algo_cache_load(path)
+
+
+def clear_conv_algo_cache():
+    """Drop every cached convolution algorithm."""
+    torch_musa._MUSAC._mudnn_conv_algo_cache_clear()
+
+
+def conv_algo_cache_size() -> int:
+    """Number of cached convolution problems across all devices."""
+    return torch_musa._MUSAC._mudnn_conv_algo_cache_size()
+
+
 class MudnnModule(PropModule):
     """A helper module that enables the hack for the frontend to get mudnn attributes."""
 
@@ -39,6 +65,24 @@ class MudnnModule(PropModule):
     allow_tf32 = ContextProp(
         torch_musa._MUSAC._get_allow_tf32, torch_musa._MUSAC._set_allow_tf32
     )
+    # time every muDNN convolution algorithm once per problem and reuse the
+    # fastest one, like torch.backends.cudnn.benchmark
+    benchmark = ContextProp(
+        torch_musa._MUSAC._get_mudnn_benchmark,
+        torch_musa._MUSAC._set_mudnn_benchmark,
+    )
+    # reuse configured muDNN descriptors and muTensor layouts across calls
+    # with the same signature, TORCH_MUSA_MUDNN_OP_CACHE=0 disables it at start
+    op_cache = ContextProp(
+        torch_musa._MUSAC._get_mudnn_op_cache,
+        torch_musa._MUSAC._set_mudnn_op_cache,
+    )
+    # workspace bound in bytes of the candidates tried in benchmark mode, 0
+    # means unlimited
+    benchmark_workspace_limit = ContextProp(
+        torch_musa._MUSAC._get_mudnn_benchmark_workspace_limit,
+        torch_musa._MUSAC._set_mudnn_benchmark_workspace_limit,
+    )
 
 
 # This plays some tricks to inject the funcitons to `torch.backends` so that it keeps consistent to
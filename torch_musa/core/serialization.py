@@ -1,6 +1,10 @@
 """MUSA model serialization features."""
 
-from typing import Any
+import threading
+import time
+from concurrent.futures import ThreadPoolExecutor
+from dataclasses import dataclass
+from typing import Any, Optional
 import torch
 
 
@@ -81,3 +85,147 @@ def register_deserialization() -> None:
         _registeration_key, _cuda_tag, _cuda_deserialize
     )
     torch.serialization._package_registry.sort()
+
+
+@dataclass
+class StreamingLoadStats:
+    """Statistics of one streaming_load call."""
+
+    num_storages: int = 0
+    num_bytes: int = 0
+    seconds: float = 0.0
+
+    @property
+    def gbps(self) -> float:
+        """Achieved host to device bandwidth in GB/s."""
+        return self.num_bytes / self.seconds / 1e9 if self.seconds > 0 else 0.0
+
+
+class _MusaCopyEngine:
+    """Stages storages through pinned chunks and copies them on a side stream."""
+
+    def __init__(self, device: torch.device):
+        self.device = device
+        self.stream = torch.musa.Stream(device=device)
+        # storages are allocated on the current stream before being filled
+        self.stream.wait_stream(torch.musa.current_stream(device))
+
+    def alloc(self, nbytes: int) -> torch.UntypedStorage:
+        with torch.musa.device(self.device):
+            return torch.UntypedStorage(nbytes, device=self.device)
+
+    def staging(self, nbytes: int) -> torch.Tensor:
+        # served by CachingHostAllocator, a chunk is only reused once the copy
+        # reading it has completed
+        return torch.empty(nbytes, dtype=torch.uint8, pin_memory=True)
+
+    def copy(self, dst: torch.Tensor, src: torch.Tensor) -> None:
+        with torch.musa.device(self.device), torch.musa.stream(self.stream):
+            dst.copy_(src, non_blocking=True)
+
+    def synchronize(self) -> None:
+        self.stream.synchronize()
+
+
+class _HostCopyEngine:
+    """Host-only stand-in of _MusaCopyEngine, exercises the same pipeline on
+    CPU memory so that it can be tested without a MUSA device."""
+
+    def __init__(self, device: torch.device):
+        self.device = device
+
+    def alloc(self, nbytes: int) -> torch.UntypedStorage:
+        return torch.UntypedStorage(nbytes)
+
+    def staging(self, nbytes: int) -> torch.Tensor:
+        return torch.empty(nbytes, dtype=torch.uint8)
+
+    def copy(self, dst: torch.Tensor, src: torch.Tensor) -> None:
+        dst.copy_(src)
+
+    def synchronize(self) -> None:
+        pass
+
+
+def _as_bytes(storage: torch.UntypedStorage) -> torch.Tensor:
+    return torch.empty(0, dtype=torch.uint8, device=storage.device).set_(storage)
+
+
+def streaming_load(
+    f,
+    map_location="musa",
+    *,
+    num_workers: int = 8,
+    chunk_bytes: int = 64 << 20,
+    fake_device: bool = False,
+    return_stats: bool = False,
+    **pickle_load_args,
+):
+    """Loads a checkpoint saved by torch.save straight into MUSA memory.
+
+    The file is memory-mapped and every storage gets its device allocation
+    while unpickling, the bytes are then read by `num_workers` threads into
+    pinned chunks of at most `chunk_bytes` and copied to the device with
+    overlapping async copies on a side stream. There is a single
+    synchronization once every storage has been issued.
+
+    Args:
+        f: path of a zipfile-format checkpoint (the torch.save default).
+        map_location: target MUSA device.
+        num_workers: threads reading and staging storages.
+        chunk_bytes: size of the pinned staging chunks.
+        fake_device: run the same pipeline on host memory only, the result
+            lives on CPU. Intended for testing without a MUSA device.
+        return_stats: also return a StreamingLoadStats with the achieved GB/s.
+        pickle_load_args: forwarded to torch.load.
+    """
+    if num_workers < 1 or chunk_bytes < 1:
+        raise ValueError("num_workers and chunk_bytes must be positive")
+    device = torch.device(map_location)
+    if fake_device:
+        engine = _HostCopyEngine(device)
+    else:
+        if device.type != "musa":
+            raise ValueError(
+                f"streaming_load expects a MUSA map_location, got {map_location}"
+            )
+        device = torch.device("musa", _validate_musa_device(str(device)))
+        engine = _MusaCopyEngine(device)
+
+    stats = StreamingLoadStats()
+    lock = threading.Lock()
+
+    def _fill(src: torch.UntypedStorage, dst: torch.UntypedStorage) -> None:
+        src_bytes, dst_bytes = _as_bytes(src), _as_bytes(dst)
+        nbytes = src_bytes.numel()
+        for offset in range(0, nbytes, chunk_bytes):
+            length = min(chunk_bytes, nbytes - offset)
+            chunk = engine.staging(length)
+            # page faults of the mapped file are taken here, in parallel
+            chunk.copy_(src_bytes[offset : offset + length])
+            engine.copy(dst_bytes[offset : offset + length], chunk)
+        with lock:
+            stats.num_storages += 1
+            stats.num_bytes += nbytes
+
+    start = time.perf_counter()
+    futures = []
+    with ThreadPoolExecutor(
+        max_workers=num_workers, thread_name_prefix="musa_streaming_load"
+    ) as pool:
+
+        def _restore(storage, _location):
+            dst = engine.alloc(storage.nbytes())
+            if storage.nbytes() > 0:
+                futures.append(pool.submit(_fill, storage, dst))
+            return dst
+
+        obj = torch.load(f, map_location=_restore, mmap=True, **pickle_load_args)
+        for future in futures:
+            future.result()
+    engine.synchronize()
+    stats.seconds = time.perf_counter() - start
+
+    if return_stats:
+        return obj, stats
+    return obj
@@ -0,0 +1,122 @@
+#include "torch_musa/csrc/aten/mudnn/ConvAlgoCache.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace at {
+namespace musa {
+namespace {
+
+void AppendDims(std::ostringstream& os, IntArrayRef dims) {
+  os << '[';
+  for (size_t i = 0; i < dims.size(); ++i) {
+    os << (i ? "," : "") << dims[i];
+  }
+  os << ']';
+}
+
+void AppendTensor(std::ostringstream& os, const Tensor& t) {
+  AppendDims(os, t.sizes());
+  AppendDims(os, t.strides());
+}
+
+} // anonymous namespace
+
+std::string ConvAlgoKey(
+    ConvAlgoDirection direction,
+    const Tensor& input,
+    const Tensor& weight,
+    const Tensor& output,
+    IntArrayRef stride,
+    IntArrayRef padding,
+    IntArrayRef dilation,
+    int64_t groups) {
+  std::ostringstream os;
+  os << static_cast<int>(direction) << ';' << input.scalar_type() << ';'
+     << static_cast<int>(GetComputeModeFromCtx(input.scalar_type())) << ';';
+  AppendTensor(os, input);
+  AppendTensor(os, weight);
+  AppendTensor(os, output);
+  os << ';';
+  AppendDims(os, stride);
+  AppendDims(os, padding);
+  AppendDims(os, dilation);
+  os << ';' << groups;
+  return os.str();
+}
+
+ConvAlgoCache& ConvAlgoCache::Instance() {
+  static ConvAlgoCache instance;
+  return instance;
+}
+
+c10::optional<int> ConvAlgoCache::Find(
+    DeviceIndex device,
+    const std::string& key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto per_device = cache_.find(device);
+  if (per_device == cache_.end()) {
+    return c10::nullopt;
+  }
+  auto it = per_device->second.find(key);
+  if (it == per_device->second.end()) {
+    return c10::nullopt;
+  }
+  return it->second;
+}
+
+void ConvAlgoCache::Insert(
+    DeviceIndex device,
+    const std::string& key,
+    int algo) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  cache_[device][key] = algo;
+}
+
+void ConvAlgoCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  cache_.clear();
+}
+
+size_t ConvAlgoCache::Size() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t size = 0;
+  for (const auto& per_device : cache_) {
+    size += per_device.second.size();
+  }
+  return size;
+}
+
+void ConvAlgoCache::Save(const std::string& path) {
+  std::ofstream file(path, std::ios::trunc);
+  TORCH_CHECK(file.is_open(), "Cannot open conv algorithm cache file ", path);
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& per_device : cache_) {
+    for (const auto& entry : per_device.second) {
+      file << static_cast<int>(per_device.first) << '\t' << entry.first << '\t'
+           << entry.second << '\n';
+    }
+  }
+  TORCH_CHECK(file.good(), "Failed to write conv algorithm cache file ", path);
+}
+
+void ConvAlgoCache::Load(const std::string& path) {
+  std::ifstream file(path);
+  TORCH_CHECK(file.is_open(), "Cannot open conv algorithm cache file ", path);
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::string line;
+  while (std::getline(file, line)) {
+    const auto first_tab = line.find('\t');
+    const auto last_tab = line.rfind('\t');
+    if (first_tab == std::string::npos || first_tab == last_tab) {
+      continue;
+    }
+    const int device = std::stoi(line.substr(0, first_tab));
+    const int algo = std::stoi(line.substr(last_tab + 1));
+    cache_[static_cast<DeviceIndex>(device)]
+          [line.substr(first_tab + 1, last_tab - first_tab - 1)] = algo;
+  }
+}
+
+} // namespace musa
+} // namespace at
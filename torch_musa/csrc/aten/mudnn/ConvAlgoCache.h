@@ -0,0 +1,166 @@
+#ifndef TORCH_MUSA_CSRC_ATEN_MUDNN_CONVALGOCACHE_H
+#define TORCH_MUSA_CSRC_ATEN_MUDNN_CONVALGOCACHE_H
+
+#include <ATen/Tensor.h>
+#include <c10/core/Device.h>
+#include <c10/util/Optional.h>
+
+#include <limits>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "mudnn.h"
+#include "torch_musa/csrc/aten/musa/MUSAGraphsUtils.muh"
+#include "torch_musa/csrc/aten/utils/Context.h"
+#include "torch_musa/csrc/core/MUSAEvent.h"
+#include "torch_musa/csrc/core/MUSAStream.h"
+
+namespace at {
+namespace musa {
+
+// Number of algorithms of each muDNN convolution direction, whose values are
+// [0, count). Derived from the last enumerator muDNN declares, so the count
+// follows the header rather than a copy of it.
+template <typename Algo>
+struct ConvAlgoCount;
+
+template <>
+struct ConvAlgoCount<::musa::dnn::Convolution::Algorithm> {
+  // IMPLICIT_GEMM, IMPLICIT_PRECOMP_GEMM, GEMM, DIRECT, FFT, FFT_TILING,
+  // WINOGRAD, WINOGRAD_NONFUSED
+  static constexpr int value = static_cast<int>(
+                                   ::musa::dnn::Convolution::Algorithm::
+                                       WINOGRAD_NONFUSED) +
+      1;
+};
+
+template <>
+struct ConvAlgoCount<::musa::dnn::Convolution::AlgorithmBwdData> {
+  // ALGO_0, ALGO_1, FFT, FFT_TILING, WINOGRAD, WINOGRAD_NONFUSED
+  static constexpr int value = static_cast<int>(
+                                   ::musa::dnn::Convolution::AlgorithmBwdData::
+                                       WINOGRAD_NONFUSED) +
+      1;
+};
+
+template <>
+struct ConvAlgoCount<::musa::dnn::Convolution::AlgorithmBwdFilter> {
+  // ALGO_0, ALGO_1, FFT, ALGO_3, WINOGRAD, WINOGRAD_NONFUSED, FFT_TILING
+  static constexpr int value = static_cast<int>(
+                                   ::musa::dnn::Convolution::
+                                       AlgorithmBwdFilter::FFT_TILING) +
+      1;
+};
+
+static_assert(
+    ConvAlgoCount<::musa::dnn::Convolution::Algorithm>::value == 8 &&
+        ConvAlgoCount<::musa::dnn::Convolution::AlgorithmBwdData>::value ==
+            6 &&
+        ConvAlgoCount<::musa::dnn::Convolution::AlgorithmBwdFilter>::value ==
+            7,
+    "muDNN convolution algorithms changed, review the ConvAlgoCount "
+    "enumerator lists");
+
+enum class ConvAlgoDirection { FWD, BWD_DATA, BWD_FILTER };
+
+// Builds the cache key of one convolution problem: direction, dtype, compute
+// mode and the sizes/strides (layout) of all three operands together with
+// stride, padding, dilation and groups.
+std::string ConvAlgoKey(
+    ConvAlgoDirection direction,
+    const Tensor& input,
+    const Tensor& weight,
+    const Tensor& output,
+    IntArrayRef stride,
+    IntArrayRef padding,
+    IntArrayRef dilation,
+    int64_t groups);
+
+// Process-wide, per-device map from ConvAlgoKey to the fastest algorithm.
+// Lookups and inserts are serialized by a mutex, the benchmark itself runs
+// unlocked so that concurrent misses of different keys do not block each
+// other.
+class ConvAlgoCache {
+ public:
+  static ConvAlgoCache& Instance();
+
+  c10::optional<int> Find(DeviceIndex device, const std::string& key);
+  void Insert(DeviceIndex device, const std::string& key, int algo);
+  void Clear();
+  size_t Size();
+
+  // plain text, one "<device>\t<key>\t<algo>" entry per line
+  void Save(const std::string& path);
+  void Load(const std::string& path);
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<DeviceIndex, std::unordered_map<std::string, int>> cache_;
+};
+
+// Returns `recommended` unless benchmark mode is enabled. Otherwise returns
+// the cached winner for `key`, timing every candidate on the current stream
+// on a miss. `workspace_fn(algo, size)` queries the workspace of a candidate,
+// candidates above the configured workspace limit are never run.
+// `run_fn(algo)` launches the convolution with that algorithm through the
+// same entry point (Run or RunFusion) the caller uses afterwards. A miss
+// while the stream is capturing a graph returns `recommended` uncached, the
+// timing would have to wait for kernels that are only recorded.
+template <typename Algo, typename WorkspaceFn, typename RunFn>
+Algo FindConvAlgorithm(
+    const std::string& key,
+    Algo recommended,
+    WorkspaceFn&& workspace_fn,
+    RunFn&& run_fn) {
+  auto& ctx = GlobalContext();
+  if (!ctx.GetBenchmark()) {
+    return recommended;
+  }
+  auto stream = c10::musa::getCurrentMUSAStream();
+  const DeviceIndex device = stream.device_index();
+  auto& cache = ConvAlgoCache::Instance();
+  if (auto hit = cache.Find(device, key)) {
+    return static_cast<Algo>(*hit);
+  }
+  if (currentStreamCaptureStatus() != CaptureStatus::None) {
+    return recommended;
+  }
+
+  const size_t workspace_limit = ctx.GetBenchmarkWorkspaceLimit();
+  Algo best = recommended;
+  float best_ms = std::numeric_limits<float>::max();
+  for (int i = 0; i < ConvAlgoCount<Algo>::value; ++i) {
+    const auto algo = static_cast<Algo>(i);
+    size_t workspace = 0;
+    if (workspace_fn(algo, workspace) != ::musa::dnn::Status::SUCCESS ||
+        (workspace_limit != 0 && workspace > workspace_limit)) {
+      continue;
+    }
+    // the first launch warms up kernel loading and the workspace allocation
+    if (run_fn(algo) != ::musa::dnn::Status::SUCCESS) {
+      continue;
+    }
+    MUSAEvent start(musaEventDefault);
+    MUSAEvent stop(musaEventDefault);
+    start.record(stream);
+    const auto status = run_fn(algo);
+    stop.record(stream);
+    stop.synchronize();
+    if (status != ::musa::dnn::Status::SUCCESS) {
+      continue;
+    }
+    const float ms = start.elapsed_time(stop);
+    if (ms < best_ms) {
+      best_ms = ms;
+      best = algo;
+    }
+  }
+  cache.Insert(device, key, static_cast<int>(best));
+  return best;
+}
+
+} // namespace musa
+} // namespace at
+
+#endif // TORCH_MUSA_CSRC_ATEN_MUDNN_CONVALGOCACHE_H
@@ -1,7 +1,10 @@
 #include "torch_musa/csrc/aten/mudnn/Handle.h"
 #include "torch_musa/csrc/aten/mudnn/DeviceThreadHandles.h"
+#include "torch_musa/csrc/core/Device.h"
 #include "torch_musa/csrc/core/MUSAStream.h"
 
+#include <vector>
+
 namespace at {
 namespace {
 
@@ -27,22 +30,42 @@ using MudnnPoolType = at::musa::DeviceThreadHandlePool<
 
 } // namespace
 
+// Handle reserved by this thread for one device together with the stream it
+// was last bound to.
+struct MudnnHandleSlot {
+  mudnnHandle_t handle = nullptr;
+  musaStream_t stream = nullptr;
+};
+
 ::musa::dnn::Handle& GetMudnnHandle() {
-  int device;
-  TORCH_MUSA_CHECK(musaGetDevice(&device));
+  const auto device = c10::musa::current_device();
+
+  // Handles stay reserved by a thread's PoolWindow until the thread exits, so
+  // the handle of a device is looked up once per thread and kept in `slots`.
+  // SetStream only runs when the current stream of the device has changed.
+  thread_local std::vector<MudnnHandleSlot> slots;
+  if (C10_UNLIKELY(static_cast<size_t>(device) >= slots.size())) {
+    slots.resize(device + 1);
+  }
+  auto& slot = slots[device];
+  if (C10_UNLIKELY(slot.handle == nullptr)) {
+    // Thread local PoolWindows are lazily-initialized
+    // to avoid initialization issues that caused hangs on Windows.
+    // See: https://github.com/pytorch/pytorch/pull/22405
+    // This thread local unique_ptrs will be destroyed when the thread
+    // terminates, releasing its reserved handles back to the pool.
+    static auto pool = std::make_shared<MudnnPoolType>();
+    thread_local std::unique_ptr<MudnnPoolType::PoolWindow> myPoolWindow(
+        pool->NewPoolWindow());
+    slot.handle = myPoolWindow->reserve(device);
+  }
 
-  // Thread local PoolWindows are lazily-initialized
-  // to avoid initialization issues that caused hangs on Windows.
-  // See: https://github.com/pytorch/pytorch/pull/22405
-  // This thread local unique_ptrs will be destroyed when the thread terminates,
-  // releasing its reserved handles back to the pool.
-  static auto pool = std::make_shared<MudnnPoolType>();
-  thread_local std::unique_ptr<MudnnPoolType::PoolWindow> myPoolWindow(
-      pool->NewPoolWindow());
-
-  mudnnHandle_t handle = myPoolWindow->reserve(device);
-  handle->SetStream(c10::musa::getCurrentMUSAStream());
-  return *handle;
+  const musaStream_t stream = c10::musa::getCurrentMUSAStream(device).stream();
+  if (slot.stream != stream) {
+    slot.handle->SetStream(stream);
+    slot.stream = stream;
+  }
+  return *slot.handle;
 }
 
 } // namespace at
@@ -0,0 +1,160 @@
+#ifndef TORCH_MUSA_CSRC_ATEN_MUDNN_OPCACHE_H
+#define TORCH_MUSA_CSRC_ATEN_MUDNN_OPCACHE_H
+
+#include <ATen/Tensor.h>
+#include <c10/util/ArrayRef.h>
+#include <c10/util/SmallVector.h>
+#include <c10/util/hash.h>
+
+#include <cstring>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+#include "torch_musa/csrc/aten/utils/Context.h"
+#include "torch_musa/csrc/core/Device.h"
+
+namespace at {
+namespace musa {
+
+// Entries kept per thread and per cached type before the least recently used
+// one is evicted.
+constexpr size_t kMudnnOpCacheCapacity = 256;
+
+enum class MudnnOpKind : int64_t {
+  TENSOR_LAYOUT,
+  REDUCE,
+  SOFTMAX,
+  CONVOLUTION,
+  MATMUL,
+  SDPA,
+};
+
+// Flat signature of a cached object: the op kind followed by every value its
+// configuration depends on. Array-like values are prefixed with their length
+// so that adjacent fields cannot alias.
+class MudnnOpKey {
+ public:
+  explicit MudnnOpKey(MudnnOpKind kind) {
+    data_.push_back(static_cast<int64_t>(kind));
+  }
+
+  MudnnOpKey& Add(int64_t v) {
+    data_.push_back(v);
+    return *this;
+  }
+
+  MudnnOpKey& Add(double v) {
+    int64_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    data_.push_back(bits);
+    return *this;
+  }
+
+  MudnnOpKey& Add(IntArrayRef values) {
+    data_.push_back(static_cast<int64_t>(values.size()));
+    data_.append(values.begin(), values.end());
+    return *this;
+  }
+
+  // dtype, sizes and strides, the address is deliberately left out
+  MudnnOpKey& Add(const Tensor& t) {
+    Add(static_cast<int64_t>(t.scalar_type()));
+    Add(t.sizes());
+    return Add(t.strides());
+  }
+
+  bool operator==(const MudnnOpKey& other) const {
+    return data_ == other.data_;
+  }
+
+  size_t Hash() const {
+    size_t seed = 0;
+    for (const auto v : data_) {
+      seed = c10::hash_combine(seed, std::hash<int64_t>()(v));
+    }
+    return seed;
+  }
+
+ private:
+  c10::SmallVector<int64_t, 24> data_;
+};
+
+struct MudnnOpKeyHash {
+  size_t operator()(const MudnnOpKey& key) const {
+    return key.Hash();
+  }
+};
+
+template <typename Value>
+class MudnnOpLRUCache {
+ public:
+  // Returns the cached value of `key`, building it with `make()` on a miss.
+  // The reference stays valid until kMudnnOpCacheCapacity other keys have
+  // been inserted, callers use it immediately and never keep it.
+  template <typename Factory>
+  Value& GetOrCreate(const MudnnOpKey& key, Factory&& make) {
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+      items_.splice(items_.begin(), items_, it->second);
+      return it->second->second;
+    }
+    items_.emplace_front(key, make());
+    index_.emplace(key, items_.begin());
+    if (items_.size() > kMudnnOpCacheCapacity) {
+      index_.erase(items_.back().first);
+      items_.pop_back();
+    }
+    return items_.front().second;
+  }
+
+  void Clear() {
+    index_.clear();
+    items_.clear();
+  }
+
+  size_t Size() const {
+    return items_.size();
+  }
+
+ private:
+  std::list<std::pair<MudnnOpKey, Value>> items_;
+  std::unordered_map<
+      MudnnOpKey,
+      typename std::list<std::pair<MudnnOpKey, Value>>::iterator,
+      MudnnOpKeyHash>
+      index_;
+};
+
+template <typename Value>
+MudnnOpLRUCache<Value>& ThreadLocalMudnnOpCache() {
+  thread_local MudnnOpLRUCache<Value> cache;
+  return cache;
+}
+
+// Returns a configured muDNN operator descriptor of type `Op` for `key`.
+// `configure(op)` runs once per key and thread, later calls with an equal key
+// reuse the descriptor and skip every Set* call. With the op cache disabled
+// (torch.backends.mudnn.op_cache = False) a fresh descriptor is configured
+// into `scratch` on every call. The current device is part of the key.
+template <typename Op, typename Configure>
+Op& CachedMudnnOp(MudnnOpKey& key, Op& scratch, Configure&& configure) {
+  if (!GlobalContext().GetOpCache()) {
+    configure(scratch);
+    return scratch;
+  }
+  key.Add(static_cast<int64_t>(c10::musa::current_device()));
+  auto& op = ThreadLocalMudnnOpCache<std::unique_ptr<Op>>().GetOrCreate(
+      key, [&configure]() {
+        auto op = std::make_unique<Op>();
+        configure(*op);
+        return op;
+      });
+  return *op;
+}
+
+} // namespace musa
+} // namespace at
+
+#endif // TORCH_MUSA_CSRC_ATEN_MUDNN_OPCACHE_H
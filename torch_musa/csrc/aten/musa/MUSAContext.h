@@ -11,6 +11,7 @@
 #include <ATen/core/ATenGeneral.h>
 
 #include "torch_musa/csrc/aten/musa/Exceptions.h"
+#include "torch_musa/csrc/core/Allocator.h"
 #include "torch_musa/csrc/core/MUSAFunctions.h"
 #include "torch_musa/csrc/core/MUSAHooksInterface.h"
 #include "torch_musa/csrc/core/MUSAStream.h"
@@ -65,6 +66,21 @@ Allocator* getMUSADeviceAllocator();
 
 mublasHandle_t getCurrentMUSABlasHandle();
 
+// Size of the workspace bound to each (mublas handle, stream) pair, see
+// MUBLAS_WORKSPACE_CONFIG.
+size_t getChosenWorkspaceSize();
+
+void clearMublasWorkspaces();
+
+void unbindMublasHandleStreams();
+
+void releaseMublasWorkspaces(c10::musa::CaptureId_t capture_id);
+
+// Bytes of mublas workspace held on `device`, also part of allocated_bytes.
+c10::musa::MUSACachingAllocator::Stat getMublasWorkspaceStat(int device);
+
+void resetPeakMublasWorkspaceStat(int device);
+
 inline void lazyInitMUSA() {
   static c10::once_flag thm_init;
   c10::call_once(thm_init, [&] { at::detail::getMUSAHooks().initMUSA(); });
@@ -0,0 +1,271 @@
+#include "torch_musa/csrc/aten/musa/MUSAGraph.h"
+
+#include <ATen/Functions.h>
+#include <c10/core/DeviceGuard.h>
+
+#include <atomic>
+#include <mutex>
+
+#include "torch_musa/csrc/aten/musa/Exceptions.h"
+#include "torch_musa/csrc/aten/musa/MUSAContext.h"
+#include "torch_musa/csrc/aten/musa/MUSAGeneratorImpl.h"
+#include "torch_musa/csrc/aten/musa/MUSAGraphsUtils.muh"
+#include "torch_musa/csrc/core/Allocator.h"
+#include "torch_musa/csrc/core/Device.h"
+
+namespace at {
+namespace musa {
+
+MempoolId_t graph_pool_handle() {
+  // uuid count starts at 1. 0 is reserved to mean "wasn't set by
+  // graph_pool_handle".
+  static std::atomic<CaptureId_t> uid{1};
+  // Sets just the second value, to distinguish it from MempoolId_ts created
+  // from musaStreamGetCaptureInfo id_s in capture_begin.
+  return {0, uid++};
+}
+
+// Get the expected id of a capture sequence so that we can call
+// NotifyCaptureBegin before starting a graph capture
+CaptureId_t capture_sequence_id() {
+  // id starts at 1:
+  // Ensures uuid count starts at 1. 0 is reserved to mean "not set by
+  // musaStreamGetCaptureInfo". (But how do we know GetCaptureInfo never sets
+  // id_ to 0? Because that's the current behavior, and it stays consistent
+  // with graph_pool_handle.)
+  static std::atomic<CaptureId_t> uuid{1};
+  return uuid++;
+}
+
+/**
+ * Note [MUSA Graph Wrapper Class]
+ *
+ * MUSAGraph mirrors the CUDAGraph of upstream PyTorch on top of the MUSA
+ * runtime graph API:
+ *   capture_begin  musaStreamBeginCapture on the current (side) stream, the
+ *                  caching allocator routes the capture's allocations into a
+ *                  private pool and the default generator switches to its
+ *                  graph-safe mode.
+ *   capture_end    musaStreamEndCapture + musaGraphInstantiate. The philox
+ *                  offset consumed by the whole graph is read back from the
+ *                  generator.
+ *   replay         advances the generator by that offset like any RNG
+ *                  consumer, writes seed and offset into the device tensors
+ *                  the captured kernels read, then musaGraphLaunch.
+ */
+
+MUSAGraph::MUSAGraph()
+    // MUSAStreams may not be default-constructed.
+    : capture_stream_(c10::musa::getCurrentMUSAStream()) {}
+
+void MUSAGraph::capture_begin(
+    MempoolId_t pool /*=0*/,
+    musaStreamCaptureMode capture_mode) {
+  TORCH_CHECK(
+      !has_graph_exec_,
+      "This MUSAGraph instance already owns a captured graph. "
+      "To capture a new graph, create a new instance.");
+
+  // Validate the stream before the generator enters its graph-safe mode, a
+  // failed check must leave it usable outside capture.
+  auto stream = c10::musa::getCurrentMUSAStream();
+
+  TORCH_CHECK(
+      stream != c10::musa::getDefaultMUSAStream(),
+      "MUSA graphs must be captured on a non-default stream. "
+      "(However, after capture, it's ok to replay them on the "
+      "default stream.)");
+
+  // For now, a MUSAGraph instance only accommodates the default generator on
+  // the device that's current when capture begins. If any op in the captured
+  // region uses a non-default generator, or a generator on another device,
+  // the offending generator will throw an error.
+  auto* gen = get_generator_or_default<MUSAGeneratorImpl>(
+      c10::nullopt, musa::detail::getDefaultMUSAGenerator());
+
+  auto options = TensorOptions().device(kMUSA).dtype(at::kLong);
+  seed_extragraph_ = at::empty({1}, options);
+  offset_extragraph_ = at::empty({1}, options);
+
+  seed_extragraph_.fill_(int64_t(gen->current_seed()));
+  {
+    std::lock_guard<std::mutex> lock(gen->mutex_);
+    gen->capture_prologue(
+        seed_extragraph_.data_ptr<int64_t>(),
+        offset_extragraph_.data_ptr<int64_t>());
+  }
+
+  capture_stream_ = stream;
+  capture_gen_ = gen;
+  capture_dev_ = c10::musa::current_device();
+
+  id_ = capture_sequence_id();
+
+  if (pool.first != 0 || pool.second != 0) {
+    // Either value being nonzero means the user supplied a pool to share.
+    // But only one should be nonzero.
+    // If pool was created by another graph's capture_begin, first should be
+    // nonzero. If pool was created by graph_pool_handle, second should be
+    // nonzero.
+    TORCH_INTERNAL_ASSERT(!(pool.first && pool.second));
+    mempool_id_ = pool;
+  } else {
+    // User did not ask us to share a mempool. Use our own id_ as our
+    // mempool_id_. Sets just the first value, to distinguish it from
+    // MempoolId_ts created by graph_pool_handle().
+    mempool_id_ = {id_, 0};
+  }
+
+  // musaStreamCaptureModeGlobal is the most conservative option to
+  // prevent potentially unsafe MUSA API calls during capture.
+  const musaError_t begin_err =
+      musaStreamBeginCapture(capture_stream_, capture_mode);
+  if (begin_err != musaSuccess) {
+    // no capture started, take the generator out of its graph-safe mode
+    std::lock_guard<std::mutex> lock(gen->mutex_);
+    gen->capture_epilogue();
+  }
+  AT_MUSA_CHECK(begin_err);
+
+  musaStreamCaptureStatus status;
+  AT_MUSA_CHECK(musaStreamGetCaptureInfo(stream, &status, &capture_id_));
+  TORCH_INTERNAL_ASSERT(status == musaStreamCaptureStatusActive);
+
+  // The allocator keys private pools by the runtime's capture id, which is
+  // what it sees when asked to allocate on a capturing stream.
+  c10::musa::MUSACachingAllocator::NotifyCaptureBegin(
+      capture_dev_, capture_id_, mempool_id_);
+
+  // mublas calls of the capture must see it to keep their workspace alive
+  unbindMublasHandleStreams();
+}
+
+void MUSAGraph::capture_end() {
+  auto stream = c10::musa::getCurrentMUSAStream();
+
+  TORCH_CHECK(
+      stream == capture_stream_,
+      "Capture must end on the same stream it began on.");
+
+  c10::musa::MUSACachingAllocator::NotifyCaptureAboutToEnd(
+      capture_dev_, capture_id_);
+
+  AT_MUSA_CHECK(musaStreamEndCapture(capture_stream_, &graph_));
+
+  TORCH_CHECK(graph_ != nullptr, "Invalid capture.");
+  has_graph_ = true;
+
+  AT_MUSA_CHECK(musaGraphInstantiate(&graph_exec_, graph_, nullptr, nullptr, 0));
+  has_graph_exec_ = true;
+
+  auto* gen = get_generator_or_default<MUSAGeneratorImpl>(
+      c10::nullopt, musa::detail::getDefaultMUSAGenerator());
+  TORCH_CHECK(
+      gen == capture_gen_,
+      "Default MUSA RNG generator on current device at capture end "
+      "is different from default generator on current device "
+      "when capture began");
+  {
+    std::lock_guard<std::mutex> lock(gen->mutex_);
+    wholegraph_increment_ = gen->capture_epilogue();
+  }
+
+  size_t num_graph_nodes = 0;
+  AT_MUSA_CHECK(musaGraphGetNodes(graph_, nullptr, &num_graph_nodes));
+  if (num_graph_nodes == 0) {
+    TORCH_WARN(
+        "The MUSA Graph is empty. This usually means that the graph was ",
+        "attempted to be captured on wrong device or stream.");
+  }
+
+  // the graph_exec_ holds everything replay needs, graph_ is only kept for
+  // debug_dump
+  if (!debug_mode_) {
+    AT_MUSA_CHECK(musaGraphDestroy(graph_));
+    has_graph_ = false;
+  }
+
+  c10::musa::MUSACachingAllocator::NotifyCaptureEnded(
+      capture_dev_, capture_id_);
+
+  // eager mublas calls on the capture stream must leave the graph's pool
+  unbindMublasHandleStreams();
+}
+
+void MUSAGraph::replay() {
+  TORCH_CHECK(
+      has_graph_exec_,
+      "Called MUSAGraph::replay without a preceding successful capture.");
+
+  c10::OptionalDeviceGuard device_guard{capture_stream_.device()};
+
+  // Just like any RNG consumer kernel!
+  auto* gen = get_generator_or_default<MUSAGeneratorImpl>(
+      c10::nullopt, musa::detail::getDefaultMUSAGenerator());
+  PhiloxMusaState rng_engine_inputs;
+  {
+    std::lock_guard<std::mutex> lock(gen->mutex_);
+    rng_engine_inputs = gen->philox_musa_state(wholegraph_increment_);
+  }
+  seed_extragraph_.fill_(int64_t(gen->current_seed()));
+  offset_extragraph_.fill_(int64_t(rng_engine_inputs.offset_.val));
+
+  AT_MUSA_CHECK(
+      musaGraphLaunch(graph_exec_, c10::musa::getCurrentMUSAStream()));
+}
+
+void MUSAGraph::enable_debug_mode() {
+  debug_mode_ = true;
+}
+
+void MUSAGraph::debug_dump(const std::string& debug_path) {
+  TORCH_CHECK(
+      has_graph_,
+      "MUSAGraph::debug_dump needs a graph captured after enable_debug_mode()");
+  TORCH_WARN("DEBUG: calling debug_dump()");
+  AT_MUSA_CHECK(musaGraphDebugDotPrint(graph_, debug_path.c_str(), 1));
+}
+
+void MUSAGraph::reset() {
+  // I'd prefer these checks throw exceptions, not print warnings,
+  // but the destructor calls reset(), and at least one CI build
+  // refuses to compile with a throwing destructor.
+  //
+  // If capture_begin, the capture, or capture_end failed at some point, this
+  // MUSAGraph, the generator, and the allocator could end up in all kinds of
+  // weird states depending where failure occurred. If the user catches the
+  // failure exception in a script, or is running in REPL or (god forbid) a
+  // Jupyter notebook, I don't see an easy way for reset() to gracefully fix
+  // all such possible error states.
+  if (has_graph_ || has_graph_exec_) {
+    // the mublas workspaces the graph replays into, some in its private pool
+    releaseMublasWorkspaces(capture_id_);
+    // notifyCaptureDestroy may throw. How should we handle this?
+    c10::musa::MUSACachingAllocator::NotifyCaptureDestroy(
+        capture_dev_, mempool_id_);
+  }
+  if (has_graph_) {
+    TORCH_MUSA_CHECK_WARN(musaGraphDestroy(graph_));
+    has_graph_ = false;
+  }
+  if (has_graph_exec_) {
+    TORCH_MUSA_CHECK_WARN(musaGraphExecDestroy(graph_exec_));
+    has_graph_exec_ = false;
+  }
+}
+
+// Returns an id another graph's capture_begin can use to share the same
+// memory pool as this graph.
+MempoolId_t MUSAGraph::pool() {
+  TORCH_CHECK(
+      has_graph_exec_,
+      "Called MUSAGraph::pool() without a preceding successful capture.");
+  return mempool_id_;
+}
+
+MUSAGraph::~MUSAGraph() {
+  reset();
+}
+
+} // namespace musa
+} // namespace at
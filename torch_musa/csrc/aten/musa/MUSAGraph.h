@@ -0,0 +1,99 @@
+#ifndef TORCH_MUSA_CSRC_ATEN_MUSA_MUSAGRAPH_H_
+#define TORCH_MUSA_CSRC_ATEN_MUSA_MUSAGRAPH_H_
+
+#include <ATen/Tensor.h>
+#include <c10/core/Device.h>
+
+#include <string>
+
+#include "musa_runtime_api.h"
+#include "torch_musa/csrc/core/MUSAGraphsC10Utils.h"
+#include "torch_musa/csrc/core/MUSAStream.h"
+
+namespace at {
+
+struct MUSAGeneratorImpl;
+
+namespace musa {
+
+using c10::musa::CaptureId_t;
+using c10::musa::MempoolId_t;
+
+// Standalone way to get a unique mempool id usable as a pool=... argument
+// to MUSAGraph::capture_begin
+MempoolId_t graph_pool_handle();
+
+// Records the work issued on a side stream into a musaGraph_t and replays it
+// with a single musaGraphLaunch. Allocations made during capture come from a
+// private pool of the caching allocator that lives as long as the graph, RNG
+// consumers read seed and offset from device tensors refreshed before every
+// replay (see Note [MUSA Graph-safe RNG states]).
+struct MUSAGraph {
+  MUSAGraph();
+  ~MUSAGraph();
+
+  void capture_begin(
+      MempoolId_t pool = {0, 0},
+      musaStreamCaptureMode capture_mode = musaStreamCaptureModeGlobal);
+  void capture_end();
+  void replay();
+  void reset();
+  MempoolId_t pool();
+  void enable_debug_mode();
+  void debug_dump(const std::string& debug_path);
+
+ protected:
+  musaGraph_t graph_ = nullptr;
+  musaGraphExec_t graph_exec_ = nullptr;
+
+  // internal states so reset() can do its best cleaning up
+  // Set to true in capture_end if musaStreamEndCapture succeeded
+  // Set back to false soon after, when graph_ is consumed by
+  // musaGraphInstantiate to create graph_exec_, then graph_ is deleted
+  bool has_graph_ = false;
+  // Set to true in capture_end if musaGraphInstantiate succeeded
+  bool has_graph_exec_ = false;
+  // keeps graph_ alive after instantiation for debug_dump
+  bool debug_mode_ = false;
+
+  // uuid of this instance's current capture, used to
+  // specify the pool.
+  CaptureId_t id_ = 0;
+
+  // the ID assigned by musa during graph capture,
+  // used to identify when a stream is participating in capture
+  CaptureId_t capture_id_ = 0;
+
+  // uuid used to request a particular private mempool from
+  // MUSACachingAllocator. By default, this will be set to {id_, 0}.
+  //
+  // If capture_begin is called with "pool=other_graph.pool()", this graph's
+  // mempool_id_ will be set to the other graph's mempool_id_, and therefore
+  // share a mempool with the other graph.
+  //
+  // If capture_begin is called with "pool=handle" where "handle" came from
+  // graph_pool_handle(), it will share a mempool with any other captures that
+  // used "pool=handle".
+  MempoolId_t mempool_id_;
+
+  // Stream on which capture began
+  c10::musa::MUSAStream capture_stream_;
+
+  // Default generator on device where capture began
+  at::MUSAGeneratorImpl* capture_gen_ = nullptr;
+
+  // Device where capture occurred. Right now, for simplicity, we require all
+  // ops in a capture to run on the same device, but this is a limitation of
+  // MUSAGraph, not MUSA itself.
+  int capture_dev_ = -1;
+
+  // RNG state trackers
+  at::Tensor seed_extragraph_;
+  at::Tensor offset_extragraph_;
+  uint64_t wholegraph_increment_ = 0;
+};
+
+} // namespace musa
+} // namespace at
+
+#endif // TORCH_MUSA_CSRC_ATEN_MUSA_MUSAGRAPH_H_
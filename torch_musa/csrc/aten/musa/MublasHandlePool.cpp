@@ -1,23 +1,197 @@
 #include "torch_musa/csrc/aten/musa/MUSAContext.h"
 
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <regex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <ATen/musa/detail/DeviceThreadHandles.h>
+#include <c10/util/SmallVector.h>
 
 #include "torch_musa/csrc/aten/musa/Exceptions.h"
+#include "torch_musa/csrc/aten/musa/MUSAGraphsUtils.muh"
 #include "torch_musa/csrc/core/Allocator.h"
+#include "torch_musa/csrc/core/Device.h"
 
 namespace at {
 namespace musa {
 
 namespace {
 
-std::map<std::tuple<void*, void*>, at::DataPtr>&
-mublas_handle_stream_to_workspace() {
-  static auto& instance = *new std::map<std::tuple<void*, void*>, at::DataPtr>;
+// Workspaces kept per handle before the least recently bound one is freed.
+constexpr size_t kMublasWorkspacesPerHandle = 4;
+
+// Bytes of mublas workspace held per device, guarded by `mutex`.
+struct MublasWorkspaceStats {
+  std::mutex mutex;
+  std::vector<c10::musa::MUSACachingAllocator::Stat> per_device;
+
+  c10::musa::MUSACachingAllocator::Stat& get(int device) {
+    if (static_cast<size_t>(device) >= per_device.size()) {
+      per_device.resize(device + 1);
+    }
+    return per_device[device];
+  }
+};
+
+MublasWorkspaceStats& mublas_workspace_stats() {
+  // leaked, workspaces of exiting threads may be freed after static
+  // destruction began
+  static auto& instance = *new MublasWorkspaceStats;
   return instance;
 }
 
+void update_workspace_stat(int device, int64_t amount) {
+  auto& stats = mublas_workspace_stats();
+  std::lock_guard<std::mutex> lock(stats.mutex);
+  auto& stat = stats.get(device);
+  stat.current += amount;
+  stat.peak = std::max(stat.current, stat.peak);
+  if (amount > 0) {
+    stat.allocated += amount;
+  } else {
+    stat.freed -= amount;
+  }
+}
+
+// Workspace of one (handle, stream) pair, allocated from the caching
+// allocator on that stream. Freeing it is stream-ordered like any other
+// block, so it may be dropped while kernels using it are still in flight.
+class MublasWorkspace {
+ public:
+  MublasWorkspace(int device, size_t size, bool from_capture)
+      : data_(c10::musa::MUSACachingAllocator::get()->allocate(size)),
+        device_(device),
+        size_(size),
+        from_capture_(from_capture) {
+    update_workspace_stat(device_, size_);
+  }
+  ~MublasWorkspace() {
+    update_workspace_stat(device_, -static_cast<int64_t>(size_));
+  }
+  MublasWorkspace(const MublasWorkspace&) = delete;
+  MublasWorkspace& operator=(const MublasWorkspace&) = delete;
+
+  void* get() const {
+    return data_.get();
+  }
+  size_t size() const {
+    return size_;
+  }
+  // Allocated while its stream was capturing, so from the private pool of
+  // that capture's graph.
+  bool from_capture() const {
+    return from_capture_;
+  }
+
+ private:
+  at::DataPtr data_;
+  int device_;
+  size_t size_;
+  bool from_capture_;
+};
+
+// Workspaces bound during each capture that still has a graph, guarded by
+// `mutex`. A graph replays into these, so they are kept alive until the graph
+// is reset, whichever thread captured it.
+struct CapturedMublasWorkspaces {
+  std::mutex mutex;
+  std::unordered_map<
+      CaptureId_t,
+      std::vector<std::shared_ptr<MublasWorkspace>>>
+      by_capture;
+};
+
+CapturedMublasWorkspaces& captured_mublas_workspaces() {
+  // leaked like the stats, graphs may be reset during static destruction
+  static auto& instance = *new CapturedMublasWorkspaces;
+  return instance;
+}
+
+void pinMublasWorkspace(
+    CaptureId_t capture_id,
+    const std::shared_ptr<MublasWorkspace>& workspace) {
+  auto& captured = captured_mublas_workspaces();
+  std::lock_guard<std::mutex> lock(captured.mutex);
+  auto& pinned = captured.by_capture[capture_id];
+  if (std::find(pinned.begin(), pinned.end(), workspace) == pinned.end()) {
+    pinned.push_back(workspace);
+  }
+}
+
+// Handle reserved by this thread for one device, the stream it was last bound
+// to, and the workspaces of the streams it ran on, most recently bound last.
+// The workspace of a stream is only ever used by kernels on that stream, so
+// it needs no cross-stream synchronization.
+struct MublasHandleSlot {
+  mublasHandle_t handle = nullptr;
+  musaStream_t stream = nullptr;
+  c10::SmallVector<
+      std::pair<musaStream_t, std::shared_ptr<MublasWorkspace>>,
+      kMublasWorkspacesPerHandle>
+      workspaces;
+};
+
+std::vector<MublasHandleSlot>& mublas_handle_slots() {
+  thread_local std::vector<MublasHandleSlot> slots;
+  return slots;
+}
+
+// Binds the workspace of `stream` to the handle of `slot`, allocating it on
+// first use. Past kMublasWorkspacesPerHandle workspaces the least recently
+// bound one is dropped, so a thread that cycles through many side streams
+// keeps a bounded amount of memory. A workspace bound while its stream is
+// capturing is also held by the capture until its graph is reset, whether it
+// was allocated now or before the capture began. One allocated during a
+// capture lives in the graph's private pool and is not reused outside it.
+void bindMublasWorkspace(
+    MublasHandleSlot& slot,
+    int device,
+    musaStream_t stream) {
+  bool capturing =
+      at::musa::currentStreamCaptureStatus() != at::musa::CaptureStatus::None;
+  CaptureId_t capture_id = 0;
+  if (capturing) {
+    musaStreamCaptureStatus status;
+    AT_MUSA_CHECK(musaStreamGetCaptureInfo(stream, &status, &capture_id));
+    capturing = status == musaStreamCaptureStatusActive;
+  }
+  auto& workspaces = slot.workspaces;
+  auto it = std::find_if(
+      workspaces.begin(), workspaces.end(), [stream](const auto& entry) {
+        return entry.first == stream;
+      });
+  if (it != workspaces.end() && !capturing && it->second->from_capture()) {
+    workspaces.erase(it);
+    it = workspaces.end();
+  }
+  if (it == workspaces.end()) {
+    workspaces.emplace_back(
+        stream,
+        std::make_shared<MublasWorkspace>(
+            device, getChosenWorkspaceSize(), capturing));
+    if (workspaces.size() > kMublasWorkspacesPerHandle) {
+      workspaces.erase(workspaces.begin());
+    }
+  } else if (it != std::prev(workspaces.end())) {
+    std::rotate(it, std::next(it), workspaces.end());
+  }
+  const auto& workspace = workspaces.back().second;
+  if (capturing) {
+    pinMublasWorkspace(capture_id, workspace);
+  }
+  TORCH_MUSABLAS_CHECK(
+      mublas_set_workspace(slot.handle, workspace->get(), workspace->size()));
+}
+
 void createMublasHandle(mublasHandle_t* handle) {
   TORCH_MUSABLAS_CHECK(mublasCreate(handle));
 }
@@ -33,60 +207,154 @@ using MuBlasPoolType = DeviceThreadHandlePool<
 
 } // namespace
 
+// Frees the workspaces of the calling thread, except the ones a captured
+// graph still holds. The next getCurrentMUSABlasHandle call on that thread
+// allocates and binds a new one.
 void clearMublasWorkspaces() {
-  mublas_handle_stream_to_workspace().clear();
+  for (auto& slot : mublas_handle_slots()) {
+    slot.workspaces.clear();
+    slot.stream = nullptr;
+  }
+}
+
+// Forgets the stream bound to each handle of the calling thread, so the next
+// getCurrentMUSABlasHandle call rebinds it. Called when a capture begins and
+// ends, so a capture on the stream the handle is already bound to holds that
+// stream's workspace, and eager calls after it leave the graph's pool.
+void unbindMublasHandleStreams() {
+  for (auto& slot : mublas_handle_slots()) {
+    slot.stream = nullptr;
+  }
+}
+
+// Drops the workspaces held by the graph of `capture_id`, called when the
+// graph is reset. Ones allocated during the capture return to its pool.
+void releaseMublasWorkspaces(CaptureId_t capture_id) {
+  std::vector<std::shared_ptr<MublasWorkspace>> released;
+  {
+    auto& captured = captured_mublas_workspaces();
+    std::lock_guard<std::mutex> lock(captured.mutex);
+    auto it = captured.by_capture.find(capture_id);
+    if (it == captured.by_capture.end()) {
+      return;
+    }
+    released = std::move(it->second);
+    captured.by_capture.erase(it);
+  }
+  // freed here, outside the lock, unless a thread still has them bound
+}
+
+c10::musa::MUSACachingAllocator::Stat getMublasWorkspaceStat(int device) {
+  auto& stats = mublas_workspace_stats();
+  std::lock_guard<std::mutex> lock(stats.mutex);
+  return stats.get(device);
 }
 
+void resetPeakMublasWorkspaceStat(int device) {
+  auto& stats = mublas_workspace_stats();
+  std::lock_guard<std::mutex> lock(stats.mutex);
+  auto& stat = stats.get(device);
+  stat.peak = stat.current;
+}
+
+// MUBLAS_WORKSPACE_CONFIG follows CUBLAS_WORKSPACE_CONFIG: a list of
+// ":SIZE:COUNT" pairs, SIZE in KiB, e.g. ":4096:2:16:8". The workspace of
+// each (handle, stream) pair is the sum of SIZE * COUNT over all pairs,
+// 4096 KiB * 8 = 32 MiB by default.
 size_t parseChosenWorkspaceSize() {
+  const char* val = getenv("MUBLAS_WORKSPACE_CONFIG");
   const size_t default_size = 4096 * 8 * 1024;
-  return default_size;
+  if (!val) {
+    return default_size;
+  }
+  size_t total_size = 0;
+  const std::string config(val);
+  std::regex exp(":([0-9]+):([0-9]+)");
+  std::sregex_iterator next(config.begin(), config.end(), exp);
+  std::sregex_iterator end;
+  if (next == end) {
+    TORCH_WARN(
+        "Could not parse MUBLAS_WORKSPACE_CONFIG \"",
+        config,
+        "\", using default workspace size of ",
+        default_size,
+        " bytes.");
+    return default_size;
+  }
+  while (next != end) {
+    std::smatch match = *next;
+    TORCH_CHECK(
+        match.size() == 3,
+        "Expected MUBLAS_WORKSPACE_CONFIG match of size 3 (Format :SIZE:COUNT)");
+    size_t curr_size = 0;
+    size_t count = 0;
+    try {
+      curr_size = std::stoull(match.str(1));
+      count = std::stoull(match.str(2));
+    } catch (const std::out_of_range&) {
+      TORCH_CHECK(
+          false,
+          "MUBLAS_WORKSPACE_CONFIG \"",
+          config,
+          "\" holds a SIZE or COUNT out of range");
+    }
+    TORCH_CHECK(
+        count == 0 ||
+            curr_size <=
+                (std::numeric_limits<size_t>::max() - total_size) / 1024 /
+                    count,
+        "MUBLAS_WORKSPACE_CONFIG \"",
+        config,
+        "\" asks for a workspace larger than the address space");
+    total_size += curr_size * 1024 * count;
+    next++;
+  }
+  return total_size;
 }
 
 size_t getChosenWorkspaceSize() {
-  size_t pool_size = parseChosenWorkspaceSize();
+  static size_t pool_size = parseChosenWorkspaceSize();
   return pool_size;
 }
 
-at::DataPtr getNewWorkspace() {
-  return c10::musa::MUSACachingAllocator::get()->allocate(
-      getChosenWorkspaceSize());
-}
-
 mublasHandle_t getCurrentMUSABlasHandle() {
-  int device;
-  AT_MUSA_CHECK(musaGetDevice(&device));
-
-  // Use a leaky singleton for the pool following standard practice around
-  // singletons: https://isocpp.org/wiki/faq/ctors#construct-on-first-use-v2
-  static auto pool = std::shared_ptr<MuBlasPoolType>(
-      new MuBlasPoolType(), [](MuBlasPoolType* p) {
-        // Leak the memory.
-      });
-  thread_local std::unique_ptr<MuBlasPoolType::PoolWindow> myPoolWindow(
-      pool->newPoolWindow());
-
-  auto handle = myPoolWindow->reserve(device);
-  auto stream = c10::musa::getCurrentMUSAStream();
-  TORCH_MUSABLAS_CHECK(mublasSetStream(handle, stream));
-  musaStream_t key_stream = stream;
-  auto key = std::make_tuple(
-      static_cast<void*>(handle), static_cast<void*>(key_stream));
-  auto workspace_it = mublas_handle_stream_to_workspace().find(key);
-  if (workspace_it == mublas_handle_stream_to_workspace().end()) {
-    workspace_it = mublas_handle_stream_to_workspace().insert(
-        workspace_it, {key, getNewWorkspace()});
-  }
-  TORCH_MUSABLAS_CHECK(mublas_set_workspace(
-      handle, workspace_it->second.get(), getChosenWorkspaceSize()));
-  // TODO(MTAI): TF32 is not supported by MUBLAS now!
-  // if (!NoTF32Guard::should_disable_tf32() &&
-  //  at::globalContext().allowTF32MuBLAS()) {
-  //   TORCH_MUSABLAS_CHECK(mublasSetMathMode(handle,
-  //   MUBLAS_MATH_MODE_TP32_TENSOR));
-  // }
-
-  TORCH_MUSABLAS_CHECK(mublasSetMathMode(handle, MUBLAS_MATH_MODE_DEFAULT));
-  return handle;
+  const auto device = c10::musa::current_device();
+
+  // Handles stay reserved by a thread's PoolWindow until the thread exits, so
+  // the handle of a device is looked up once per thread and kept in its slot.
+  // Stream and workspace are only rebound when the current stream changed.
+  auto& slots = mublas_handle_slots();
+  if (C10_UNLIKELY(static_cast<size_t>(device) >= slots.size())) {
+    slots.resize(device + 1);
+  }
+  auto& slot = slots[device];
+  if (C10_UNLIKELY(slot.handle == nullptr)) {
+    // Use a leaky singleton for the pool following standard practice around
+    // singletons: https://isocpp.org/wiki/faq/ctors#construct-on-first-use-v2
+    static auto pool = std::shared_ptr<MuBlasPoolType>(
+        new MuBlasPoolType(), [](MuBlasPoolType* p) {
+          // Leak the memory.
+        });
+    thread_local std::unique_ptr<MuBlasPoolType::PoolWindow> myPoolWindow(
+        pool->newPoolWindow());
+    slot.handle = myPoolWindow->reserve(device);
+    // TODO(MTAI): TF32 is not supported by MUBLAS now!
+    // if (!NoTF32Guard::should_disable_tf32() &&
+    //  at::globalContext().allowTF32MuBLAS()) {
+    //   TORCH_MUSABLAS_CHECK(mublasSetMathMode(handle,
+    //   MUBLAS_MATH_MODE_TP32_TENSOR));
+    // }
+    TORCH_MUSABLAS_CHECK(
+        mublasSetMathMode(slot.handle, MUBLAS_MATH_MODE_DEFAULT));
+  }
+
+  const musaStream_t stream = c10::musa::getCurrentMUSAStream(device).stream();
+  if (slot.stream != stream) {
+    TORCH_MUSABLAS_CHECK(mublasSetStream(slot.handle, stream));
+    bindMublasWorkspace(slot, device, stream);
+    slot.stream = stream;
+  }
+  return slot.handle;
 }
 
 } // namespace musa
@@ -2,15 +2,33 @@
 #include <ATen/Config.h>
 #include <ATen/NativeFunctions.h>
 #include <ATen/core/op_registration/adaption.h>
+#include <ATen/native/Resize.h>
 #include <ATen/native/layer_norm.h>
 #include <torch/library.h>
 
+#include "torch_musa/csrc/aten/ops/BatchNorm.h"
 #include "torch_musa/csrc/aten/ops/TensorFactory.h"
 #include "torch_musa/csrc/aten/utils/Utils.h"
 
 #include <mudnn.h>
 
 namespace at {
+namespace native {
+
+DEFINE_DISPATCH(batch_norm_stats_stub);
+DEFINE_DISPATCH(batch_norm_gather_stats_stub);
+DEFINE_DISPATCH(batch_norm_elemt_stub);
+DEFINE_DISPATCH(batch_norm_backward_reduce_stub);
+DEFINE_DISPATCH(batch_norm_backward_elemt_stub);
+
+REGISTER_NO_CPU_DISPATCH(batch_norm_stats_stub);
+REGISTER_NO_CPU_DISPATCH(batch_norm_gather_stats_stub);
+REGISTER_NO_CPU_DISPATCH(batch_norm_elemt_stub);
+REGISTER_NO_CPU_DISPATCH(batch_norm_backward_reduce_stub);
+REGISTER_NO_CPU_DISPATCH(batch_norm_backward_elemt_stub);
+
+} // namespace native
+
 namespace musa {
 
 void check_dims_match_num_input_features(
@@ -293,5 +311,305 @@ std::tuple<Tensor, Tensor, Tensor> NativeBatchNormBwd(
   return std::make_tuple(grad_input, grad_weight, grad_bias);
 }
 
+// SyncBatchNorm primitives. nn.SyncBatchNorm computes the local statistics
+// with batch_norm_stats, all-gathers them, merges them with
+// batch_norm_gather_stats_with_counts and normalizes with batch_norm_elemt.
+// Its backward all-reduces the sums of batch_norm_backward_reduce before
+// batch_norm_backward_elemt. The per-channel statistics are float.
+namespace {
+
+void CheckSyncBatchNormInput(const Tensor& input, const char* name) {
+  TORCH_CHECK(
+      input.dim() >= 2,
+      name,
+      ": expected input with at least 2 dims, but got ",
+      input.dim());
+  TORCH_CHECK(
+      input.scalar_type() == at::ScalarType::Float ||
+          input.scalar_type() == at::ScalarType::Half ||
+          input.scalar_type() == at::ScalarType::BFloat16,
+      name,
+      " supports Float or Half/BFloat16 tensor dtype, now got: ",
+      input.scalar_type());
+}
+
+// Per-channel tensors as the contiguous float [C] the kernels read.
+Tensor FloatChannels(const Tensor& t) {
+  if (!t.defined()) {
+    return t;
+  }
+  return FormatContiguous(
+      t.to(at::ScalarType::Float), MemoryFormat::Contiguous);
+}
+
+void SyncBatchNormElemt(
+    Tensor& out,
+    const Tensor& contiguous_input,
+    const c10::optional<Tensor>& weight_opt,
+    const c10::optional<Tensor>& bias_opt,
+    const Tensor& mean,
+    const Tensor& invstd) {
+  const Tensor& weight =
+      c10::value_or_else(weight_opt, [] { return Tensor(); });
+  const Tensor& bias = c10::value_or_else(bias_opt, [] { return Tensor(); });
+  const auto num_features = contiguous_input.size(1);
+  if (weight.defined()) {
+    check_dims_match_num_input_features("weight", num_features, weight.numel());
+  }
+  if (bias.defined()) {
+    check_dims_match_num_input_features("bias", num_features, bias.numel());
+  }
+  check_dims_match_num_input_features("mean", num_features, mean.numel());
+  check_dims_match_num_input_features("invstd", num_features, invstd.numel());
+  at::native::batch_norm_elemt_stub(
+      kMUSA,
+      out,
+      contiguous_input,
+      FloatChannels(weight),
+      FloatChannels(bias),
+      FloatChannels(mean),
+      FloatChannels(invstd));
+}
+
+} // anonymous namespace
+
+std::tuple<Tensor, Tensor> BatchNormStats(const Tensor& input, double eps) {
+  CheckSyncBatchNormInput(input, "batch_norm_stats");
+  const c10::musa::MUSAGuard device_guard(input.device());
+  const auto contiguous_input =
+      FormatContiguous(input, input.suggest_memory_format());
+  const auto options = input.options().dtype(at::ScalarType::Float);
+  Tensor mean = at::empty({input.size(1)}, options);
+  Tensor invstd = at::empty({input.size(1)}, options);
+  at::native::batch_norm_stats_stub(
+      kMUSA, mean, invstd, contiguous_input, eps);
+  return std::make_tuple(mean, invstd);
+}
+
+std::tuple<Tensor, Tensor> BatchNormGatherStatsWithCounts(
+    const Tensor& input,
+    const Tensor& mean,
+    const Tensor& invstd,
+    const c10::optional<Tensor>& running_mean_opt,
+    const c10::optional<Tensor>& running_var_opt,
+    double momentum,
+    double eps,
+    const Tensor& counts) {
+  TORCH_CHECK(
+      mean.dim() == 2 && invstd.sizes() == mean.sizes(),
+      "batch_norm_gather_stats: expected mean and invstd of shape ",
+      "[world_size, C], but got ",
+      mean.sizes(),
+      " and ",
+      invstd.sizes());
+  TORCH_CHECK(
+      counts.numel() == mean.size(0),
+      "batch_norm_gather_stats: expected ",
+      mean.size(0),
+      " counts, but got ",
+      counts.numel());
+  const c10::musa::MUSAGuard device_guard(mean.device());
+  const Tensor& running_mean =
+      c10::value_or_else(running_mean_opt, [] { return Tensor(); });
+  const Tensor& running_var =
+      c10::value_or_else(running_var_opt, [] { return Tensor(); });
+  const auto num_features = mean.size(1);
+  if (running_mean.defined()) {
+    check_dims_match_num_input_features(
+        "running_mean", num_features, running_mean.numel());
+  }
+  if (running_var.defined()) {
+    check_dims_match_num_input_features(
+        "running_var", num_features, running_var.numel());
+  }
+
+  const auto options = mean.options().dtype(at::ScalarType::Float);
+  Tensor save_mean = at::empty({num_features}, options);
+  Tensor save_invstd = at::empty({num_features}, options);
+  // The kernel updates contiguous float running stats in place, any other
+  // running stats through a float copy.
+  Tensor float_running_mean = FloatChannels(running_mean);
+  Tensor float_running_var = FloatChannels(running_var);
+  at::native::batch_norm_gather_stats_stub(
+      kMUSA,
+      save_mean,
+      save_invstd,
+      float_running_mean,
+      float_running_var,
+      FloatChannels(mean),
+      FloatChannels(invstd),
+      FloatChannels(counts),
+      momentum,
+      eps);
+  if (running_mean.defined() && !float_running_mean.is_same(running_mean)) {
+    running_mean.copy_(float_running_mean);
+  }
+  if (running_var.defined() && !float_running_var.is_same(running_var)) {
+    running_var.copy_(float_running_var);
+  }
+  return std::make_tuple(save_mean, save_invstd);
+}
+
+std::tuple<Tensor, Tensor> BatchNormGatherStats(
+    const Tensor& input,
+    const Tensor& mean,
+    const Tensor& invstd,
+    const c10::optional<Tensor>& running_mean_opt,
+    const c10::optional<Tensor>& running_var_opt,
+    double momentum,
+    double eps,
+    int64_t count) {
+  const Tensor counts = at::full(
+      {mean.size(0)},
+      static_cast<double>(count),
+      mean.options().dtype(at::ScalarType::Float));
+  return BatchNormGatherStatsWithCounts(
+      input,
+      mean,
+      invstd,
+      running_mean_opt,
+      running_var_opt,
+      momentum,
+      eps,
+      counts);
+}
+
+Tensor BatchNormElemt(
+    const Tensor& input,
+    const c10::optional<Tensor>& weight_opt,
+    const c10::optional<Tensor>& bias_opt,
+    const Tensor& mean,
+    const Tensor& invstd,
+    double eps) {
+  CheckSyncBatchNormInput(input, "batch_norm_elemt");
+  const c10::musa::MUSAGuard device_guard(input.device());
+  const auto contiguous_input =
+      FormatContiguous(input, input.suggest_memory_format());
+  Tensor output = at::empty_like(contiguous_input);
+  SyncBatchNormElemt(
+      output, contiguous_input, weight_opt, bias_opt, mean, invstd);
+  return output;
+}
+
+Tensor& BatchNormElemtOut(
+    const Tensor& input,
+    const c10::optional<Tensor>& weight_opt,
+    const c10::optional<Tensor>& bias_opt,
+    const Tensor& mean,
+    const Tensor& invstd,
+    double eps,
+    Tensor& out) {
+  CheckSyncBatchNormInput(input, "batch_norm_elemt");
+  TORCH_CHECK(
+      out.scalar_type() == input.scalar_type(),
+      "batch_norm_elemt: expected out of dtype ",
+      input.scalar_type(),
+      ", but got ",
+      out.scalar_type());
+  const c10::musa::MUSAGuard device_guard(input.device());
+  const auto memory_format = input.suggest_memory_format();
+  const auto contiguous_input = FormatContiguous(input, memory_format);
+  at::native::resize_output(out, input.sizes());
+  if (out.is_contiguous(memory_format)) {
+    SyncBatchNormElemt(
+        out, contiguous_input, weight_opt, bias_opt, mean, invstd);
+  } else {
+    Tensor output = at::empty_like(contiguous_input);
+    SyncBatchNormElemt(
+        output, contiguous_input, weight_opt, bias_opt, mean, invstd);
+    out.copy_(output);
+  }
+  return out;
+}
+
+std::tuple<Tensor, Tensor, Tensor, Tensor> BatchNormBackwardReduce(
+    const Tensor& grad_out,
+    const Tensor& input,
+    const Tensor& mean,
+    const Tensor& invstd,
+    const c10::optional<Tensor>& weight_opt,
+    bool input_g,
+    bool weight_g,
+    bool bias_g) {
+  CheckSyncBatchNormInput(input, "batch_norm_backward_reduce");
+  TORCH_CHECK(
+      grad_out.sizes() == input.sizes() &&
+          grad_out.scalar_type() == input.scalar_type(),
+      "batch_norm_backward_reduce: grad_out and input must have the same ",
+      "shape and dtype");
+  const c10::musa::MUSAGuard device_guard(input.device());
+  const Tensor& weight =
+      c10::value_or_else(weight_opt, [] { return Tensor(); });
+  const auto memory_format = input.suggest_memory_format();
+  const auto contiguous_input = FormatContiguous(input, memory_format);
+  const auto contiguous_grad_out = FormatContiguous(grad_out, memory_format);
+
+  const auto num_features = input.size(1);
+  const auto options = input.options().dtype(at::ScalarType::Float);
+  Tensor sum_dy = input_g ? at::empty({num_features}, options) : Tensor();
+  Tensor sum_dy_xmu = input_g ? at::empty({num_features}, options) : Tensor();
+  Tensor grad_weight = weight_g ? at::empty({num_features}, options) : Tensor();
+  Tensor grad_bias = bias_g ? at::empty({num_features}, options) : Tensor();
+  if (!input_g && !weight_g && !bias_g) {
+    return std::make_tuple(sum_dy, sum_dy_xmu, grad_weight, grad_bias);
+  }
+  at::native::batch_norm_backward_reduce_stub(
+      kMUSA,
+      sum_dy,
+      sum_dy_xmu,
+      grad_weight,
+      grad_bias,
+      contiguous_grad_out,
+      contiguous_input,
+      FloatChannels(mean),
+      FloatChannels(invstd));
+  // weight and bias gradients in the dtype of weight
+  if (weight.defined() && weight.scalar_type() != at::ScalarType::Float) {
+    if (grad_weight.defined()) {
+      grad_weight = grad_weight.to(weight.scalar_type());
+    }
+    if (grad_bias.defined()) {
+      grad_bias = grad_bias.to(weight.scalar_type());
+    }
+  }
+  return std::make_tuple(sum_dy, sum_dy_xmu, grad_weight, grad_bias);
+}
+
+Tensor BatchNormBackwardElemt(
+    const Tensor& grad_out,
+    const Tensor& input,
+    const Tensor& mean,
+    const Tensor& invstd,
+    const c10::optional<Tensor>& weight_opt,
+    const Tensor& sum_dy,
+    const Tensor& sum_dy_xmu,
+    const Tensor& count) {
+  CheckSyncBatchNormInput(input, "batch_norm_backward_elemt");
+  TORCH_CHECK(
+      grad_out.sizes() == input.sizes() &&
+          grad_out.scalar_type() == input.scalar_type(),
+      "batch_norm_backward_elemt: grad_out and input must have the same ",
+      "shape and dtype");
+  const c10::musa::MUSAGuard device_guard(input.device());
+  const Tensor& weight =
+      c10::value_or_else(weight_opt, [] { return Tensor(); });
+  const auto memory_format = input.suggest_memory_format();
+  const auto contiguous_input = FormatContiguous(input, memory_format);
+  const auto contiguous_grad_out = FormatContiguous(grad_out, memory_format);
+  Tensor grad_input = at::empty_like(contiguous_input);
+  at::native::batch_norm_backward_elemt_stub(
+      kMUSA,
+      grad_input,
+      contiguous_grad_out,
+      contiguous_input,
+      FloatChannels(mean),
+      FloatChannels(invstd),
+      FloatChannels(weight),
+      FloatChannels(sum_dy),
+      FloatChannels(sum_dy_xmu),
+      FloatChannels(count));
+  return grad_input;
+}
+
 } // namespace musa
 } // namespace at
@@ -0,0 +1,75 @@
+#ifndef ATEN_SRC_ATEN_NATIVE_MUSA_BATCHNORM_H_
+#define ATEN_SRC_ATEN_NATIVE_MUSA_BATCHNORM_H_
+
+#include <ATen/core/Tensor.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at {
+namespace native {
+
+// Kernels of the SyncBatchNorm primitives. input and grad_out are [N, C, *]
+// and either contiguous or contiguous in a channels-last memory format, the
+// per-channel tensors are contiguous float [C] and counts are float
+// [world_size]. Optional tensors may be undefined.
+
+// (mean, invstd, input, eps)
+using batch_norm_stats_fn = void (*)(Tensor&, Tensor&, const Tensor&, double);
+
+// (mean, invstd, running_mean, running_var, mean_all, invstd_all, counts,
+//  momentum, eps), mean_all and invstd_all are [world_size, C].
+using batch_norm_gather_stats_fn = void (*)(
+    Tensor&,
+    Tensor&,
+    Tensor&,
+    Tensor&,
+    const Tensor&,
+    const Tensor&,
+    const Tensor&,
+    double,
+    double);
+
+// (out, input, weight, bias, mean, invstd)
+using batch_norm_elemt_fn = void (*)(
+    Tensor&,
+    const Tensor&,
+    const Tensor&,
+    const Tensor&,
+    const Tensor&,
+    const Tensor&);
+
+// (sum_dy, sum_dy_xmu, grad_weight, grad_bias, grad_out, input, mean, invstd)
+using batch_norm_backward_reduce_fn = void (*)(
+    Tensor&,
+    Tensor&,
+    Tensor&,
+    Tensor&,
+    const Tensor&,
+    const Tensor&,
+    const Tensor&,
+    const Tensor&);
+
+// (grad_input, grad_out, input, mean, invstd, weight, sum_dy, sum_dy_xmu,
+//  counts)
+using batch_norm_backward_elemt_fn = void (*)(
+    Tensor&,
+    const Tensor&,
+    const Tensor&,
+    const Tensor&,
+    const Tensor&,
+    const Tensor&,
+    const Tensor&,
+    const Tensor&,
+    const Tensor&);
+
+DECLARE_DISPATCH(batch_norm_stats_fn, batch_norm_stats_stub);
+DECLARE_DISPATCH(batch_norm_gather_stats_fn, batch_norm_gather_stats_stub);
+DECLARE_DISPATCH(batch_norm_elemt_fn, batch_norm_elemt_stub);
+DECLARE_DISPATCH(
+    batch_norm_backward_reduce_fn,
+    batch_norm_backward_reduce_stub);
+DECLARE_DISPATCH(batch_norm_backward_elemt_fn, batch_norm_backward_elemt_stub);
+
+} // namespace native
+} // namespace at
+
+#endif // ATEN_SRC_ATEN_NATIVE_MUSA_BATCHNORM_H_
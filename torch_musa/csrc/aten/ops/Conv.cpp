@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <utility>
 
 #include <ATen/Config.h>
 #include <ATen/native/ConvUtils.h>
@@ -16,6 +17,7 @@
 #include <ATen/ops/_convolution_mode_native.h>
 #include <ATen/ops/_convolution_native.h>
 #include <ATen/ops/_unsafe_view.h>
+#include <ATen/ops/addmm.h>
 #include <ATen/ops/cat.h>
 #include <ATen/ops/constant_pad_nd.h>
 #include <ATen/ops/conv1d_native.h>
@@ -35,7 +37,11 @@
 #include <ATen/ops/empty.h>
 #include <ATen/ops/empty_like.h>
 #include <ATen/ops/empty_native.h>
+#include <ATen/ops/gelu.h>
+#include <ATen/ops/linear.h>
 #include <ATen/ops/pad.h>
+#include <ATen/ops/relu.h>
+#include <ATen/ops/silu.h>
 #include <ATen/ops/sum.h>
 #include <ATen/ops/view_as_real.h>
 #include <ATen/ops/zeros.h>
@@ -43,6 +49,8 @@
 #endif
 #include <ATen/native/ConvUtils.h>
 #include <mudnn.h>
+#include "torch_musa/csrc/aten/mudnn/ConvAlgoCache.h"
+#include "torch_musa/csrc/aten/mudnn/OpCache.h"
 #include "torch_musa/csrc/aten/ops/TensorFactory.h"
 #include "torch_musa/csrc/aten/utils/Context.h"
 #include "torch_musa/csrc/aten/utils/Utils.h"
@@ -93,6 +101,172 @@ void AddBias(Tensor& out, const Tensor& bias) {
   out.add_(at::native::reshape_bias(out.dim(), bias));
 }
 
+// The Select*Algorithm helpers return muDNN's recommendation unless
+// torch.backends.mudnn.benchmark is set, in which case every candidate is
+// timed once per problem and the winner is cached, see ConvAlgoCache.h.
+// The forward is timed through `run_fn(algo)`, which must launch the entry
+// point (Run or RunFusion) the caller runs with the selected algorithm.
+template <typename RunFn>
+::musa::dnn::Convolution::Algorithm SelectForwardAlgorithm(
+    ::musa::dnn::Convolution& c,
+    muHandle& h,
+    muTensor& out,
+    muTensor& in,
+    muTensor& ke,
+    const Tensor& input,
+    const Tensor& weight,
+    const Tensor& output,
+    IntArrayRef stride,
+    IntArrayRef padding,
+    IntArrayRef dilation,
+    int64_t groups,
+    RunFn&& run_fn) {
+  ::musa::dnn::Convolution::Algorithm algo;
+  c.GetRecommendForwardAlgorithm(h, algo, out, in, ke);
+  if (!GlobalContext().GetBenchmark()) {
+    return algo;
+  }
+  return FindConvAlgorithm(
+      ConvAlgoKey(
+          ConvAlgoDirection::FWD,
+          input,
+          weight,
+          output,
+          stride,
+          padding,
+          dilation,
+          groups),
+      algo,
+      [&](::musa::dnn::Convolution::Algorithm candidate, size_t& size) {
+        return c.GetForwardWorkspaceSize(h, size, out, in, ke, candidate);
+      },
+      std::forward<RunFn>(run_fn));
+}
+
+::musa::dnn::Convolution::AlgorithmBwdData SelectBwdDataAlgorithm(
+    ::musa::dnn::Convolution& c,
+    muHandle& h,
+    muTensor& gin,
+    muTensor& gout,
+    muTensor& w,
+    const Tensor& grad_input,
+    const Tensor& weight,
+    const Tensor& grad_output,
+    IntArrayRef stride,
+    IntArrayRef padding,
+    IntArrayRef dilation,
+    int64_t groups) {
+  ::musa::dnn::Convolution::AlgorithmBwdData algo;
+  c.GetRecommendBackwardDataAlgorithm(h, algo, gin, gout, w);
+  if (!GlobalContext().GetBenchmark()) {
+    return algo;
+  }
+  return FindConvAlgorithm(
+      ConvAlgoKey(
+          ConvAlgoDirection::BWD_DATA,
+          grad_input,
+          weight,
+          grad_output,
+          stride,
+          padding,
+          dilation,
+          groups),
+      algo,
+      [&](::musa::dnn::Convolution::AlgorithmBwdData candidate,
+          size_t& size) {
+        return c.GetBackwardDataWorkspaceSize(
+            h, size, gin, gout, w, candidate);
+      },
+      [&](::musa::dnn::Convolution::AlgorithmBwdData candidate) {
+        return c.RunBwdData(h, gin, gout, w, candidate, InternalMemAlloc);
+      });
+}
+
+::musa::dnn::Convolution::AlgorithmBwdFilter SelectBwdFilterAlgorithm(
+    ::musa::dnn::Convolution& c,
+    muHandle& h,
+    muTensor& gw,
+    muTensor& in,
+    muTensor& gout,
+    const Tensor& input,
+    const Tensor& grad_weight,
+    const Tensor& grad_output,
+    IntArrayRef stride,
+    IntArrayRef padding,
+    IntArrayRef dilation,
+    int64_t groups) {
+  ::musa::dnn::Convolution::AlgorithmBwdFilter algo;
+  c.GetRecommendBackwardFilterAlgorithm(h, algo, gw, in, gout);
+  if (!GlobalContext().GetBenchmark()) {
+    return algo;
+  }
+  return FindConvAlgorithm(
+      ConvAlgoKey(
+          ConvAlgoDirection::BWD_FILTER,
+          input,
+          grad_weight,
+          grad_output,
+          stride,
+          padding,
+          dilation,
+          groups),
+      algo,
+      [&](::musa::dnn::Convolution::AlgorithmBwdFilter candidate,
+          size_t& size) {
+        return c.GetBackwardFilterWorkspaceSize(
+            h, size, gw, in, gout, candidate);
+      },
+      [&](::musa::dnn::Convolution::AlgorithmBwdFilter candidate) {
+        return c.RunBwdFilter(h, gw, in, gout, candidate, InternalMemAlloc);
+      });
+}
+
+// Activations applied in the epilogue of fused conv/linear. RELU and SILU map
+// onto muDNN fused activation modes, GELU has no fused mode and runs in place
+// on the output right after the fused bias.
+enum class EpilogueAct { IDENTITY, RELU, SILU, GELU };
+
+EpilogueAct ParseEpilogueAct(c10::string_view act) {
+  if (act == "none" || act == "identity") {
+    return EpilogueAct::IDENTITY;
+  } else if (act == "relu") {
+    return EpilogueAct::RELU;
+  } else if (act == "silu") {
+    return EpilogueAct::SILU;
+  } else if (act == "gelu") {
+    return EpilogueAct::GELU;
+  }
+  TORCH_CHECK(
+      false,
+      "Unsupported fused activation: ",
+      act,
+      ", expected one of none/relu/silu/gelu");
+}
+
+::musa::dnn::Convolution::FusedActivationDesc::Mode MuDNNFusedActMode(
+    EpilogueAct act) {
+  using Mode = ::musa::dnn::Convolution::FusedActivationDesc::Mode;
+  switch (act) {
+    case EpilogueAct::RELU:
+      return Mode::RELU;
+    case EpilogueAct::SILU:
+      return Mode::SILU;
+    default:
+      return Mode::IDENTITY;
+  }
+}
+
+// applies whatever part of the activation muDNN did not fuse
+void ApplyUnfusedEpilogueAct(Tensor& out, EpilogueAct act, bool fused) {
+  if (act == EpilogueAct::GELU) {
+    at::gelu_(out);
+  } else if (!fused && act == EpilogueAct::RELU) {
+    at::relu_(out);
+  } else if (!fused && act == EpilogueAct::SILU) {
+    at::silu_(out);
+  }
+}
+
 template <int N>
 Tensor ConvNd(
     const Tensor& input,
@@ -101,7 +275,8 @@ Tensor ConvNd(
     IntArrayRef stride,
     IntArrayRef padding,
     IntArrayRef dilation,
-    int64_t groups) {
+    int64_t groups,
+    EpilogueAct epilogue_act = EpilogueAct::IDENTITY) {
   static_assert(N == 2 || N == 3);
   const auto weight_memory_format = weight.suggest_memory_format();
 
@@ -124,15 +299,21 @@ Tensor ConvNd(
   auto ke = CreateMUTensor(contiguous_weight);
 
   muHandle& h = GetMudnnHandle();
-  ::musa::dnn::Convolution c;
-  ConfigConv(c, input.scalar_type(), stride, padding, dilation, groups);
-
-  ::musa::dnn::Convolution::Algorithm algo;
-  c.GetRecommendForwardAlgorithm(h, algo, out, in, ke);
+  MudnnOpKey key(MudnnOpKind::CONVOLUTION);
+  key.Add(static_cast<int64_t>(input.scalar_type()))
+      .Add(static_cast<int64_t>(GetComputeModeFromCtx(input.scalar_type())))
+      .Add(stride)
+      .Add(padding)
+      .Add(dilation)
+      .Add(groups);
+  ::musa::dnn::Convolution scratch;
+  auto& c = CachedMudnnOp(key, scratch, [&](::musa::dnn::Convolution& op) {
+    ConfigConv(op, input.scalar_type(), stride, padding, dilation, groups);
+  });
 
   if constexpr (N == 2) {
     ::musa::dnn::Convolution::FusedActivationDesc act;
-    act.SetMode(::musa::dnn::Convolution::FusedActivationDesc::Mode::IDENTITY);
+    act.SetMode(MuDNNFusedActMode(epilogue_act));
 
     at::musa::muTensor bias;
     if (bias_opt.has_value() && bias_opt.value().numel() != 0) {
@@ -142,20 +323,316 @@ Tensor ConvNd(
       bias = CreateEmptyMUTensor();
     }
     muTensor add = at::musa::CreateEmptyMUTensor();
-    CHECK_MUDNN_STATUS(
-        c.RunFusion(h, out, in, ke, bias, add, act, algo, InternalMemAlloc),
-        "RunFusion");
+    const auto run = [&](::musa::dnn::Convolution::Algorithm algo) {
+      return c.RunFusion(
+          h, out, in, ke, bias, add, act, algo, InternalMemAlloc);
+    };
+    const auto algo = SelectForwardAlgorithm(
+        c,
+        h,
+        out,
+        in,
+        ke,
+        contiguous_input,
+        contiguous_weight,
+        output,
+        stride,
+        padding,
+        dilation,
+        groups,
+        run);
+    CHECK_MUDNN_STATUS(run(algo), "RunFusion");
+    ApplyUnfusedEpilogueAct(output, epilogue_act, /*fused=*/true);
   } else {
     // conv3d
-    CHECK_MUDNN_STATUS(c.Run(h, out, in, ke, algo, InternalMemAlloc), "Run");
+    const auto run = [&](::musa::dnn::Convolution::Algorithm algo) {
+      return c.Run(h, out, in, ke, algo, InternalMemAlloc);
+    };
+    const auto algo = SelectForwardAlgorithm(
+        c,
+        h,
+        out,
+        in,
+        ke,
+        contiguous_input,
+        contiguous_weight,
+        output,
+        stride,
+        padding,
+        dilation,
+        groups,
+        run);
+    CHECK_MUDNN_STATUS(run(algo), "Run");
     if (bias_opt.has_value()) {
       AddBias(output, *bias_opt);
     }
+    ApplyUnfusedEpilogueAct(output, epilogue_act, /*fused=*/false);
   }
 
   return output;
 }
 
+// output[M, N] = act(input[M, K] @ weight[N, K]^T + bias + residual), issued
+// as a 1x1 NHWC convolution so that bias, the optional [M, N] residual and
+// the activation run in the RunFusion epilogue instead of extra passes over
+// the output. All tensors are contiguous and M, N > 0.
+void LinearActAsConv(
+    Tensor& output,
+    const Tensor& input,
+    const Tensor& weight,
+    const c10::optional<Tensor>& bias_opt,
+    const Tensor& residual,
+    EpilogueAct epilogue_act) {
+  const int64_t M = input.size(0);
+  const int64_t K = input.size(1);
+  const int64_t N = weight.size(0);
+
+  auto in = CreateMUTensor(input.view({M, 1, 1, K}));
+  auto ke = CreateMUTensor(weight.view({N, 1, 1, K}));
+  auto out = CreateMUTensor(output.view({M, 1, 1, N}));
+  CHECK_MUDNN_STATUS(
+      in.SetFormat(muTensor::Format::NHWC), "Set input muTensor format");
+  CHECK_MUDNN_STATUS(
+      ke.SetFormat(muTensor::Format::NHWC), "Set weight muTensor format");
+  CHECK_MUDNN_STATUS(
+      out.SetFormat(muTensor::Format::NHWC), "Set output muTensor format");
+
+  muHandle& h = GetMudnnHandle();
+  ::musa::dnn::Convolution c;
+  const int64_t unit[2] = {1, 1};
+  const int64_t zero[2] = {0, 0};
+  ConfigConv(c, input.scalar_type(), unit, zero, unit, 1);
+
+  ::musa::dnn::Convolution::FusedActivationDesc act_desc;
+  act_desc.SetMode(MuDNNFusedActMode(epilogue_act));
+  muTensor bias = (bias_opt.has_value() && bias_opt->numel() != 0)
+      ? CreateMUTensor(bias_opt->contiguous())
+      : CreateEmptyMUTensor();
+  muTensor add = CreateEmptyMUTensor();
+  if (residual.defined()) {
+    add = CreateMUTensor(residual.view({M, 1, 1, N}));
+    CHECK_MUDNN_STATUS(
+        add.SetFormat(muTensor::Format::NHWC), "Set add muTensor format");
+  }
+  const auto run = [&](::musa::dnn::Convolution::Algorithm algo) {
+    return c.RunFusion(
+        h, out, in, ke, bias, add, act_desc, algo, InternalMemAlloc);
+  };
+  const auto algo = SelectForwardAlgorithm(
+      c,
+      h,
+      out,
+      in,
+      ke,
+      input,
+      weight,
+      output,
+      unit,
+      zero,
+      unit,
+      1,
+      run);
+  CHECK_MUDNN_STATUS(run(algo), "RunFusion");
+  ApplyUnfusedEpilogueAct(output, epilogue_act, /*fused=*/true);
+}
+
+Tensor FusedLinearAct(
+    const Tensor& input,
+    const Tensor& weight,
+    const c10::optional<Tensor>& bias_opt,
+    c10::string_view act) {
+  TORCH_CHECK(
+      weight.device() == input.device(),
+      "Expected weight tensor and input tensor to be on the same MUSA device, ",
+      "but got weight on ",
+      weight.device(),
+      " and input on ",
+      input.device());
+  TORCH_MUSA_CHECK_FLOATING_TYPES(input.scalar_type(), "fused_linear_act");
+  TORCH_CHECK(
+      input.scalar_type() == weight.scalar_type(),
+      "input dtype and weight dtype must be the same in fused_linear_act");
+  TORCH_CHECK(weight.dim() == 2, "fused_linear_act expects a 2D weight");
+  TORCH_CHECK(
+      input.dim() >= 1 && input.size(-1) == weight.size(1),
+      "fused_linear_act: input last dim ",
+      input.size(-1),
+      " mismatches weight in_features ",
+      weight.size(1));
+  const auto epilogue_act = ParseEpilogueAct(act);
+  c10::musa::MUSAGuard device_guard(input.device());
+
+  const int64_t K = weight.size(1);
+  const int64_t N = weight.size(0);
+  std::vector<int64_t> output_shape{input.sizes().vec()};
+  output_shape.back() = N;
+
+  const auto input_2d = input.reshape({-1, K}).contiguous();
+  const int64_t M = input_2d.size(0);
+  Tensor output = at::empty({M, N}, input.options());
+  if (C10_UNLIKELY(M == 0 || N == 0)) {
+    return output.view(output_shape);
+  }
+  LinearActAsConv(
+      output, input_2d, weight.contiguous(), bias_opt, Tensor(), epilogue_act);
+  return output.view(output_shape);
+}
+
+// act(beta * self + alpha * mat1 @ mat2). With unit beta and alpha, a self
+// that broadcasts along the rows is the fused bias and a full [M, N] self the
+// fused residual add of the RunFusion epilogue. Other cases run addmm and
+// apply the activation in place.
+Tensor FusedAddmmAct(
+    const Tensor& self,
+    const Tensor& mat1,
+    const Tensor& mat2,
+    const Scalar& beta,
+    const Scalar& alpha,
+    c10::string_view act) {
+  TORCH_CHECK(
+      mat1.dim() == 2 && mat2.dim() == 2 && mat1.size(1) == mat2.size(0),
+      "fused_addmm_act expects [M, K] and [K, N] matrices, got ",
+      mat1.sizes(),
+      " and ",
+      mat2.sizes());
+  TORCH_CHECK(
+      self.device() == mat1.device() && mat2.device() == mat1.device(),
+      "fused_addmm_act expects self, mat1 and mat2 on the same device");
+  TORCH_MUSA_CHECK_FLOATING_TYPES(mat1.scalar_type(), "fused_addmm_act");
+  TORCH_CHECK(
+      self.scalar_type() == mat1.scalar_type() &&
+          mat2.scalar_type() == mat1.scalar_type(),
+      "self, mat1 and mat2 must have the same dtype in fused_addmm_act");
+  const auto epilogue_act = ParseEpilogueAct(act);
+  c10::musa::MUSAGuard device_guard(mat1.device());
+
+  const int64_t M = mat1.size(0);
+  const int64_t N = mat2.size(1);
+  const bool unit_scales = beta.equal(1) && alpha.equal(1);
+  const bool row_bias = self.numel() == N &&
+      (self.dim() == 1 || (self.dim() == 2 && self.size(0) == 1));
+  const bool full_residual = self.dim() == 2 && self.size(0) == M &&
+      self.size(1) == N && !row_bias;
+  if (!unit_scales || !(row_bias || full_residual) || M == 0 || N == 0) {
+    auto output = at::addmm(self, mat1, mat2, beta, alpha);
+    ApplyUnfusedEpilogueAct(output, epilogue_act, /*fused=*/false);
+    return output;
+  }
+
+  Tensor output = at::empty({M, N}, mat1.options());
+  // mat2 is often the transposed view of a [N, K] weight, making this free
+  const auto weight = mat2.t().contiguous();
+  LinearActAsConv(
+      output,
+      mat1.contiguous(),
+      weight,
+      row_bias ? c10::optional<Tensor>(self.reshape({N})) : c10::nullopt,
+      full_residual ? self.contiguous() : Tensor(),
+      epilogue_act);
+  return output;
+}
+
+Tensor FusedConvBiasAct(
+    const Tensor& input,
+    const Tensor& weight,
+    const c10::optional<Tensor>& bias_opt,
+    IntArrayRef stride,
+    IntArrayRef padding,
+    IntArrayRef dilation,
+    int64_t groups,
+    c10::string_view act) {
+  TORCH_CHECK(
+      weight.device() == input.device(),
+      "Expected weight tensor and input tensor to be on the same MUSA device, ",
+      "but got weight on ",
+      weight.device(),
+      " and input on ",
+      input.device());
+  TORCH_MUSA_CHECK_FLOATING_TYPES(input.scalar_type(), "fused_conv_bias_act");
+  TORCH_CHECK(
+      input.scalar_type() == weight.scalar_type(),
+      "input dtype and weight dtype must be the same in fused_conv_bias_act");
+  TORCH_CHECK(
+      (input.dim() == 4 || input.dim() == 5) && weight.dim() == input.dim(),
+      "fused_conv_bias_act supports batched conv2d and conv3d only");
+  const auto epilogue_act = ParseEpilogueAct(act);
+  c10::musa::MUSAGuard device_guard(input.device());
+
+  const size_t spatial = input.dim() - 2;
+  auto expand = [spatial](IntArrayRef param) {
+    return param.size() == 1 ? std::vector<int64_t>(spatial, param[0])
+                             : param.vec();
+  };
+  const auto stride_ = expand(stride);
+  const auto padding_ = expand(padding);
+  const auto dilation_ = expand(dilation);
+  TORCH_CHECK(
+      stride_.size() == spatial && padding_.size() == spatial &&
+          dilation_.size() == spatial,
+      "fused_conv_bias_act: stride, padding and dilation must have ",
+      spatial,
+      " elements");
+
+  if (input.dim() == 4) {
+    return ConvNd<2>(
+        input,
+        weight,
+        bias_opt,
+        stride_,
+        padding_,
+        dilation_,
+        groups,
+        epilogue_act);
+  }
+  return ConvNd<3>(
+      input,
+      weight,
+      bias_opt,
+      stride_,
+      padding_,
+      dilation_,
+      groups,
+      epilogue_act);
+}
+
+// host references, the unfused composition of the same ops
+Tensor FusedLinearActCPU(
+    const Tensor& input,
+    const Tensor& weight,
+    const c10::optional<Tensor>& bias_opt,
+    c10::string_view act) {
+  auto output = at::linear(input, weight, bias_opt);
+  ApplyUnfusedEpilogueAct(output, ParseEpilogueAct(act), /*fused=*/false);
+  return output;
+}
+
+Tensor FusedAddmmActCPU(
+    const Tensor& self,
+    const Tensor& mat1,
+    const Tensor& mat2,
+    const Scalar& beta,
+    const Scalar& alpha,
+    c10::string_view act) {
+  auto output = at::addmm(self, mat1, mat2, beta, alpha);
+  ApplyUnfusedEpilogueAct(output, ParseEpilogueAct(act), /*fused=*/false);
+  return output;
+}
+
+Tensor FusedConvBiasActCPU(
+    const Tensor& input,
+    const Tensor& weight,
+    const c10::optional<Tensor>& bias_opt,
+    IntArrayRef stride,
+    IntArrayRef padding,
+    IntArrayRef dilation,
+    int64_t groups,
+    c10::string_view act) {
+  auto output = at::convolution(
+      input, weight, bias_opt, stride, padding, dilation, false, {0}, groups);
+  ApplyUnfusedEpilogueAct(output, ParseEpilogueAct(act), /*fused=*/false);
+  return output;
+}
+
 template <int ND>
 Tensor ConvDataBwd(
     const Tensor&,
@@ -371,8 +848,19 @@ Tensor ConvDataBwd(
   muHandle& h = GetMudnnHandle();
   ::musa::dnn::Convolution c;
   ConfigConv(c, weight.scalar_type(), stride, padding, dilation, groups);
-  ::musa::dnn::Convolution::AlgorithmBwdData algo;
-  c.GetRecommendBackwardDataAlgorithm(h, algo, gin, gout, w);
+  const auto algo = SelectBwdDataAlgorithm(
+      c,
+      h,
+      gin,
+      gout,
+      w,
+      grad_input_t,
+      weight,
+      contiguous_grad_output,
+      stride,
+      padding,
+      dilation,
+      groups);
   CHECK_MUDNN_STATUS(
       c.RunBwdData(h, gin, gout, w, algo, InternalMemAlloc), "ConvBwdData");
   return grad_input_t;
@@ -417,8 +905,19 @@ Tensor ConvDataBwd<3>(
   muHandle& h = GetMudnnHandle();
   ::musa::dnn::Convolution c;
   ConfigConv(c, weight.scalar_type(), stride, padding, dilation, groups);
-  ::musa::dnn::Convolution::AlgorithmBwdData algo;
-  c.GetRecommendBackwardDataAlgorithm(h, algo, gin, gout, w);
+  const auto algo = SelectBwdDataAlgorithm(
+      c,
+      h,
+      gin,
+      gout,
+      w,
+      grad_input_t,
+      weight,
+      contiguous_grad_output,
+      stride,
+      padding,
+      dilation,
+      groups);
   CHECK_MUDNN_STATUS(
       c.RunBwdData(h, gin, gout, w, algo, InternalMemAlloc), "ConvBwdData");
   return grad_input_t;
@@ -449,8 +948,19 @@ Tensor ConvWeightBwd(
   muHandle& h = GetMudnnHandle();
   ::musa::dnn::Convolution c;
   ConfigConv(c, input.scalar_type(), stride, padding, dilation, groups);
-  ::musa::dnn::Convolution::AlgorithmBwdFilter algo;
-  c.GetRecommendBackwardFilterAlgorithm(h, algo, gw, in, gout);
+  const auto algo = SelectBwdFilterAlgorithm(
+      c,
+      h,
+      gw,
+      in,
+      gout,
+      contiguous_input,
+      grad_weight_t,
+      contiguous_grad_output,
+      stride,
+      padding,
+      dilation,
+      groups);
   CHECK_MUDNN_STATUS(
       c.RunBwdFilter(h, gw, in, gout, algo, InternalMemAlloc), "ConvBwdFilter");
   return grad_weight_t;
@@ -627,5 +1137,26 @@ template <int N>
                           output_mask);
 }
 
+TORCH_LIBRARY_FRAGMENT(musa, m) {
+  m.def(
+      "fused_linear_act(Tensor input, Tensor weight, Tensor? bias=None, str act=\"relu\") -> Tensor");
+  m.def(
+      "fused_addmm_act(Tensor self, Tensor mat1, Tensor mat2, *, Scalar beta=1, Scalar alpha=1, str act=\"relu\") -> Tensor");
+  m.def(
+      "fused_conv_bias_act(Tensor input, Tensor weight, Tensor? bias, int[] stride=1, int[] padding=0, int[] dilation=1, int groups=1, str act=\"relu\") -> Tensor");
+}
+
+TORCH_LIBRARY_IMPL(musa, PrivateUse1, m) {
+  m.impl("fused_linear_act", &FusedLinearAct);
+  m.impl("fused_addmm_act", &FusedAddmmAct);
+  m.impl("fused_conv_bias_act", &FusedConvBiasAct);
+}
+
+TORCH_LIBRARY_IMPL(musa, CPU, m) {
+  m.impl("fused_linear_act", &FusedLinearActCPU);
+  m.impl("fused_addmm_act", &FusedAddmmActCPU);
+  m.impl("fused_conv_bias_act", &FusedConvBiasActCPU);
+}
+
 } // namespace musa
 } // namespace at
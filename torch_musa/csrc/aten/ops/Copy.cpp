@@ -362,6 +362,7 @@ Tensor MUSACopyFrom(const Tensor& src, const Tensor& self, bool non_blocking) {
       auto* ctx = host_tensor.storage().data_ptr().get_context();
       CachingHostAllocator_recordEvent(ptr, ctx, stream);
     } else {
+      c10::musa::maybe_warn_or_error_on_sync();
       musaStreamSynchronize(stream);
     }
 
@@ -56,6 +56,28 @@ namespace musa {
         input, input.options().dtype(c10::CppTypeToScalarType<bool>::value));
     return std::tuple<Tensor, Tensor>(ret, mask);
   }
+  // muDNN takes seed and offset by value, but during graph capture they only
+  // exist in device memory (see Note [MUSA Graph-safe RNG states]). Draw the
+  // mask with the bernoulli kernel instead, which unpacks them on device.
+  if (at::musa::currentStreamCaptureStatus() !=
+      at::musa::CaptureStatus::None) {
+#if TORCH_MUSA_ARCH < 210
+    // bernoulli_ draws on the host here, the captured graph would replay a
+    // frozen mask
+    TORCH_CHECK(
+        false,
+        "Dropout cannot be captured into a MUSA graph on this GPU "
+        "architecture, its random mask is drawn on the host");
+#endif
+    Tensor mask = at::empty_like(
+                      input,
+                      input.options().dtype(
+                          c10::CppTypeToScalarType<bool>::value),
+                      at::MemoryFormat::Contiguous)
+                      .bernoulli_(1 - p);
+    Tensor output = input.mul(mask).mul_(1. / (1 - p));
+    return std::make_tuple(output, mask);
+  }
 
   Tensor mask = at::empty_like(
       input,
@@ -1,4 +1,6 @@
 #include <ATen/Config.h>
+#include <ATen/core/dispatch/Dispatcher.h>
+#include <torch/csrc/autograd/custom_function.h>
 #include <torch/library.h>
 
 #ifndef AT_PER_OPERATOR_HEADERS
@@ -27,9 +29,15 @@ namespace native {
 
 DEFINE_DISPATCH(embedding_bag_stub);
 DEFINE_DISPATCH(embedding_dense_backward_stub);
+DEFINE_DISPATCH(grouped_embedding_bag_stub);
+DEFINE_DISPATCH(grouped_embedding_bag_backward_stub);
+DEFINE_DISPATCH(embedding_sparse_update_stub);
 
 REGISTER_NO_CPU_DISPATCH(embedding_bag_stub);
 REGISTER_NO_CPU_DISPATCH(embedding_dense_backward_stub);
+REGISTER_NO_CPU_DISPATCH(grouped_embedding_bag_stub);
+REGISTER_NO_CPU_DISPATCH(grouped_embedding_bag_backward_stub);
+REGISTER_NO_CPU_DISPATCH(embedding_sparse_update_stub);
 } // namespace native
 
 namespace musa {
@@ -169,5 +177,546 @@ std::tuple<Tensor, Tensor, Tensor, Tensor> EmbeddingBag(
       /*requires_grad*/ true);
 }
 
+namespace {
+
+using at::native::GroupedEmbeddingBagMeta;
+
+// Everything the grouped kernels need about a list of tables, with indices
+// and offsets of all tables concatenated into one int64 tensor each.
+struct GroupedEmbeddingBagPlan {
+  Tensor meta;
+  Tensor indices;
+  Tensor offsets;
+  int64_t num_bags = 0;
+  int64_t output_numel = 0;
+  int64_t grad_numel = 0;
+  std::vector<int64_t> bags;
+};
+
+GroupedEmbeddingBagPlan MakeGroupedEmbeddingBagPlan(
+    TensorList indices,
+    TensorList offsets,
+    IntArrayRef num_rows,
+    IntArrayRef dims,
+    const std::vector<int64_t>& weight_ptrs,
+    bool include_last_offset,
+    const Device& device) {
+  const int64_t num_tables = indices.size();
+  TORCH_CHECK(num_tables > 0, "grouped_embedding_bag expects at least 1 table");
+  TORCH_CHECK(
+      offsets.size() == num_tables,
+      "grouped_embedding_bag expects one offsets tensor per table, got ",
+      offsets.size(),
+      " for ",
+      num_tables,
+      " tables");
+
+  constexpr int kNumFields =
+      static_cast<int>(GroupedEmbeddingBagMeta::NUM_FIELDS);
+  Tensor meta_cpu = at::zeros(
+      {kNumFields, num_tables + 1},
+      TensorOptions().dtype(kLong).pinned_memory(device.is_privateuseone()));
+  auto meta_acc = meta_cpu.accessor<int64_t, 2>();
+  auto row = [&](GroupedEmbeddingBagMeta field) {
+    return meta_acc[static_cast<int>(field)];
+  };
+
+  GroupedEmbeddingBagPlan plan;
+  std::vector<Tensor> flat_indices, flat_offsets;
+  flat_indices.reserve(num_tables);
+  flat_offsets.reserve(num_tables);
+  for (int64_t t = 0; t < num_tables; ++t) {
+    TORCH_CHECK(
+        indices[t].dim() == 1 && offsets[t].dim() == 1,
+        "grouped_embedding_bag expects 1D indices and offsets, table ",
+        t,
+        " got ",
+        indices[t].dim(),
+        "D indices and ",
+        offsets[t].dim(),
+        "D offsets");
+    TORCH_CHECK(
+        indices[t].device() == device && offsets[t].device() == device,
+        "indices and offsets of table ",
+        t,
+        " must be on ",
+        device);
+    const int64_t bags = include_last_offset
+        ? std::max<int64_t>(offsets[t].numel() - 1, 0)
+        : offsets[t].numel();
+    plan.bags.push_back(bags);
+    row(GroupedEmbeddingBagMeta::BAG_BEGIN)[t + 1] =
+        row(GroupedEmbeddingBagMeta::BAG_BEGIN)[t] + bags;
+    row(GroupedEmbeddingBagMeta::INDEX_BEGIN)[t + 1] =
+        row(GroupedEmbeddingBagMeta::INDEX_BEGIN)[t] + indices[t].numel();
+    row(GroupedEmbeddingBagMeta::OFFSET_BEGIN)[t + 1] =
+        row(GroupedEmbeddingBagMeta::OFFSET_BEGIN)[t] + offsets[t].numel();
+    row(GroupedEmbeddingBagMeta::OUTPUT_BEGIN)[t + 1] =
+        row(GroupedEmbeddingBagMeta::OUTPUT_BEGIN)[t] + bags * dims[t];
+    row(GroupedEmbeddingBagMeta::ROW_BEGIN)[t + 1] =
+        row(GroupedEmbeddingBagMeta::ROW_BEGIN)[t] + num_rows[t];
+    row(GroupedEmbeddingBagMeta::GRAD_BEGIN)[t + 1] =
+        row(GroupedEmbeddingBagMeta::GRAD_BEGIN)[t] + num_rows[t] * dims[t];
+    row(GroupedEmbeddingBagMeta::DIM)[t] = dims[t];
+    row(GroupedEmbeddingBagMeta::WEIGHT_PTR)[t] = weight_ptrs[t];
+    flat_indices.push_back(indices[t].to(kLong));
+    flat_offsets.push_back(offsets[t].to(kLong));
+  }
+  plan.num_bags = row(GroupedEmbeddingBagMeta::BAG_BEGIN)[num_tables];
+  plan.output_numel = row(GroupedEmbeddingBagMeta::OUTPUT_BEGIN)[num_tables];
+  plan.grad_numel = row(GroupedEmbeddingBagMeta::GRAD_BEGIN)[num_tables];
+  // one H2D copy for all tables, the pinned source keeps it asynchronous
+  plan.meta = meta_cpu.to(device, /*non_blocking=*/true);
+  plan.indices = at::cat(flat_indices);
+  plan.offsets = at::cat(flat_offsets);
+  return plan;
+}
+
+void CheckGroupedEmbeddingBagMode(int64_t mode) {
+  TORCH_CHECK(
+      mode == 0 || mode == 1,
+      "grouped_embedding_bag supports mode 0 (sum) and 1 (mean), got ",
+      mode);
+}
+
+} // namespace
+
+// Embedding bags of many tables in one launch. Table t reads weights[t] with
+// the 1D indices[t] and offsets[t] (the layout of torch.embedding_bag), and
+// produces a [num_bags_t, dim_t] output. All outputs are views of one buffer.
+std::vector<Tensor> GroupedEmbeddingBag(
+    TensorList weights,
+    TensorList indices,
+    TensorList offsets,
+    int64_t mode,
+    bool include_last_offset) {
+  CheckGroupedEmbeddingBagMode(mode);
+  TORCH_CHECK(
+      weights.size() == indices.size(),
+      "grouped_embedding_bag expects one indices tensor per table, got ",
+      indices.size(),
+      " for ",
+      weights.size(),
+      " tables");
+  TORCH_CHECK(!weights.empty(), "grouped_embedding_bag expects 1 table");
+  const Device device = weights[0].device();
+  c10::musa::MUSAGuard device_guard(device);
+
+  std::vector<Tensor> contiguous_weights;
+  std::vector<int64_t> num_rows, dims, weight_ptrs;
+  for (const auto& w : weights) {
+    TORCH_CHECK(
+        w.dim() == 2 && w.device() == device &&
+            w.scalar_type() == weights[0].scalar_type(),
+        "grouped_embedding_bag expects 2D weights of the same dtype on ",
+        device);
+    contiguous_weights.push_back(w.contiguous());
+    num_rows.push_back(w.size(0));
+    dims.push_back(w.size(1));
+    weight_ptrs.push_back(
+        reinterpret_cast<int64_t>(contiguous_weights.back().data_ptr()));
+  }
+  auto plan = MakeGroupedEmbeddingBagPlan(
+      indices,
+      offsets,
+      num_rows,
+      dims,
+      weight_ptrs,
+      include_last_offset,
+      device);
+
+  Tensor output = at::empty({plan.output_numel}, weights[0].options());
+  at::native::grouped_embedding_bag_stub(
+      kMUSA,
+      output,
+      plan.meta,
+      plan.indices,
+      plan.offsets,
+      weights.size(),
+      plan.num_bags,
+      mode);
+
+  std::vector<Tensor> outputs;
+  int64_t begin = 0;
+  for (size_t t = 0; t < weights.size(); ++t) {
+    const int64_t numel = plan.bags[t] * dims[t];
+    outputs.push_back(
+        output.narrow(0, begin, numel).view({plan.bags[t], dims[t]}));
+    begin += numel;
+  }
+  return outputs;
+}
+
+// Dense weight gradients of GroupedEmbeddingBag. One sort over the rows of
+// all tables followed by one segment reduction, the gradients are views of a
+// single zero-initialized buffer.
+std::vector<Tensor> GroupedEmbeddingBagBackward(
+    TensorList grads,
+    TensorList indices,
+    TensorList offsets,
+    IntArrayRef num_weights,
+    int64_t mode,
+    bool include_last_offset) {
+  CheckGroupedEmbeddingBagMode(mode);
+  TORCH_CHECK(
+      grads.size() == indices.size() && num_weights.size() == indices.size(),
+      "grouped_embedding_bag_backward expects one grad and num_weights per "
+      "table");
+  TORCH_CHECK(
+      !grads.empty(), "grouped_embedding_bag_backward expects 1 table");
+  const Device device = grads[0].device();
+  c10::musa::MUSAGuard device_guard(device);
+
+  std::vector<int64_t> dims, weight_ptrs(grads.size(), 0);
+  std::vector<Tensor> flat_grads;
+  for (const auto& g : grads) {
+    TORCH_CHECK(
+        g.dim() == 2 && g.scalar_type() == grads[0].scalar_type(),
+        "grouped_embedding_bag_backward expects 2D grads of the same dtype");
+    dims.push_back(g.size(1));
+    flat_grads.push_back(g.reshape(-1));
+  }
+  auto plan = MakeGroupedEmbeddingBagPlan(
+      indices,
+      offsets,
+      num_weights,
+      dims,
+      weight_ptrs,
+      include_last_offset,
+      device);
+  for (size_t t = 0; t < grads.size(); ++t) {
+    TORCH_CHECK(
+        grads[t].size(0) == plan.bags[t],
+        "grad of table ",
+        t,
+        " has ",
+        grads[t].size(0),
+        " bags, expected ",
+        plan.bags[t]);
+  }
+
+  Tensor grad_output = at::cat(flat_grads);
+  Tensor grad_weight = at::zeros({plan.grad_numel}, grads[0].options());
+  at::native::grouped_embedding_bag_backward_stub(
+      kMUSA,
+      grad_weight,
+      grad_output,
+      plan.meta,
+      plan.indices,
+      plan.offsets,
+      grads.size(),
+      plan.num_bags,
+      mode);
+
+  std::vector<Tensor> grad_weights;
+  int64_t begin = 0;
+  for (size_t t = 0; t < grads.size(); ++t) {
+    const int64_t numel = num_weights[t] * dims[t];
+    grad_weights.push_back(
+        grad_weight.narrow(0, begin, numel).view({num_weights[t], dims[t]}));
+    begin += numel;
+  }
+  return grad_weights;
+}
+
+namespace {
+
+class GroupedEmbeddingBagFunction
+    : public torch::autograd::Function<GroupedEmbeddingBagFunction> {
+ public:
+  static torch::autograd::variable_list forward(
+      torch::autograd::AutogradContext* ctx,
+      TensorList weights,
+      TensorList indices,
+      TensorList offsets,
+      int64_t mode,
+      bool include_last_offset) {
+    at::AutoDispatchBelowADInplaceOrView guard;
+    static auto op =
+        c10::Dispatcher::singleton()
+            .findSchemaOrThrow("musa::grouped_embedding_bag", "")
+            .typed<decltype(GroupedEmbeddingBag)>();
+    auto outputs =
+        op.call(weights, indices, offsets, mode, include_last_offset);
+    std::vector<int64_t> num_weights, dims, output_sizes;
+    for (size_t t = 0; t < weights.size(); ++t) {
+      num_weights.push_back(weights[t].size(0));
+      dims.push_back(weights[t].size(1));
+      output_sizes.push_back(outputs[t].size(0));
+    }
+    std::vector<Tensor> saved(indices.begin(), indices.end());
+    saved.insert(saved.end(), offsets.begin(), offsets.end());
+    ctx->save_for_backward(saved);
+    ctx->saved_data["num_weights"] = num_weights;
+    ctx->saved_data["dims"] = dims;
+    ctx->saved_data["output_sizes"] = output_sizes;
+    ctx->saved_data["mode"] = mode;
+    ctx->saved_data["include_last_offset"] = include_last_offset;
+    return outputs;
+  }
+
+  static torch::autograd::variable_list backward(
+      torch::autograd::AutogradContext* ctx,
+      torch::autograd::variable_list grad_outputs) {
+    static auto op =
+        c10::Dispatcher::singleton()
+            .findSchemaOrThrow("musa::grouped_embedding_bag_backward", "")
+            .typed<decltype(GroupedEmbeddingBagBackward)>();
+    const auto saved = ctx->get_saved_variables();
+    const size_t num_tables = saved.size() / 2;
+    const auto num_weights = ctx->saved_data["num_weights"].toIntVector();
+    std::vector<Tensor> indices(saved.begin(), saved.begin() + num_tables);
+    std::vector<Tensor> offsets(saved.begin() + num_tables, saved.end());
+    // outputs that did not take part in the loss come without a gradient
+    const auto output_sizes = ctx->saved_data["output_sizes"].toIntVector();
+    TensorOptions grad_options;
+    for (const auto& g : grad_outputs) {
+      if (g.defined()) {
+        grad_options = g.options();
+        break;
+      }
+    }
+    for (size_t t = 0; t < num_tables; ++t) {
+      if (!grad_outputs[t].defined()) {
+        grad_outputs[t] = at::zeros(
+            {output_sizes[t], ctx->saved_data["dims"].toIntVector()[t]},
+            grad_options);
+      }
+    }
+    auto grad_weights = op.call(
+        grad_outputs,
+        indices,
+        offsets,
+        num_weights,
+        ctx->saved_data["mode"].toInt(),
+        ctx->saved_data["include_last_offset"].toBool());
+    // weights, then no gradient for indices, offsets, mode and the flag
+    torch::autograd::variable_list grads(
+        grad_weights.begin(), grad_weights.end());
+    grads.resize(3 * num_tables + 2);
+    return grads;
+  }
+};
+
+std::vector<Tensor> GroupedEmbeddingBagAutograd(
+    TensorList weights,
+    TensorList indices,
+    TensorList offsets,
+    int64_t mode,
+    bool include_last_offset) {
+  return GroupedEmbeddingBagFunction::apply(
+      weights, indices, offsets, mode, include_last_offset);
+}
+
+} // namespace
+
+namespace {
+
+using at::native::EmbeddingSparseOptimizer;
+
+void CheckEmbeddingSparseUpdate(
+    const Tensor& weight,
+    const Tensor& momentum,
+    const Tensor& grad_output,
+    const Tensor& indices,
+    EmbeddingSparseOptimizer optimizer) {
+  TORCH_CHECK(
+      weight.dim() == 2 && weight.is_contiguous(),
+      "sparse embedding update expects a contiguous 2D weight");
+  TORCH_CHECK(
+      indices.scalar_type() == kLong || indices.scalar_type() == kInt,
+      "sparse embedding update expects int or long indices, got ",
+      indices.scalar_type());
+  TORCH_CHECK(
+      grad_output.scalar_type() == weight.scalar_type() &&
+          grad_output.dim() == indices.dim() + 1 &&
+          grad_output.size(-1) == weight.size(1) &&
+          grad_output.numel() == indices.numel() * weight.size(1),
+      "sparse embedding update expects grad_output of shape ",
+      "indices.shape + [",
+      weight.size(1),
+      "] and dtype ",
+      weight.scalar_type(),
+      ", got ",
+      grad_output.sizes(),
+      " ",
+      grad_output.scalar_type());
+  TORCH_CHECK(
+      grad_output.device() == weight.device() &&
+          indices.device() == weight.device(),
+      "sparse embedding update expects all tensors on ",
+      weight.device());
+  if (optimizer == EmbeddingSparseOptimizer::ROWWISE_ADAGRAD) {
+    TORCH_CHECK(
+        momentum.scalar_type() == kFloat && momentum.is_contiguous() &&
+            momentum.dim() == 1 && momentum.size(0) == weight.size(0) &&
+            momentum.device() == weight.device(),
+        "rowwise adagrad expects a contiguous float momentum of shape [",
+        weight.size(0),
+        "]");
+  }
+}
+
+// Composite CPU reference: the gradient rows of every touched index are
+// summed and only those rows of weight (and momentum) are rewritten.
+void EmbeddingSparseUpdateReference(
+    Tensor& weight,
+    Tensor& momentum,
+    const Tensor& grad_output,
+    const Tensor& indices,
+    EmbeddingSparseOptimizer optimizer,
+    double lr,
+    double eps,
+    double weight_decay,
+    int64_t padding_idx) {
+  at::NoGradGuard no_grad;
+  Tensor flat_indices = indices.reshape(-1).to(kLong);
+  Tensor grad = grad_output.reshape({-1, weight.size(1)});
+  if (padding_idx >= 0) {
+    const Tensor keep = (flat_indices != padding_idx).nonzero().squeeze(1);
+    flat_indices = flat_indices.index_select(0, keep);
+    grad = grad.index_select(0, keep);
+  }
+  Tensor rows, inverse;
+  std::tie(rows, inverse, std::ignore) =
+      at::_unique2(flat_indices, true, true, false);
+  Tensor row_grad =
+      at::zeros({rows.numel(), weight.size(1)}, grad.options().dtype(kFloat))
+          .index_add_(0, inverse, grad.to(kFloat));
+  const Tensor old_rows = weight.index_select(0, rows).to(kFloat);
+  if (weight_decay != 0) {
+    row_grad.add_(old_rows, weight_decay);
+  }
+  Tensor new_rows;
+  if (optimizer == EmbeddingSparseOptimizer::ROWWISE_ADAGRAD) {
+    const Tensor m = momentum.index_select(0, rows) + row_grad.pow(2).mean(1);
+    momentum.index_copy_(0, rows, m);
+    new_rows = old_rows - row_grad * (lr / (m.sqrt() + eps)).unsqueeze(1);
+  } else {
+    new_rows = old_rows - row_grad * lr;
+  }
+  weight.index_copy_(0, rows, new_rows.to(weight.scalar_type()));
+}
+
+Tensor& EmbeddingSparseUpdate(
+    Tensor& weight,
+    Tensor& momentum,
+    const Tensor& grad_output,
+    const Tensor& indices,
+    EmbeddingSparseOptimizer optimizer,
+    double lr,
+    double eps,
+    double weight_decay,
+    int64_t padding_idx) {
+  CheckEmbeddingSparseUpdate(
+      weight, momentum, grad_output, indices, optimizer);
+  if (weight.device().is_cpu()) {
+    EmbeddingSparseUpdateReference(
+        weight,
+        momentum,
+        grad_output,
+        indices,
+        optimizer,
+        lr,
+        eps,
+        weight_decay,
+        padding_idx);
+    return weight;
+  }
+  c10::musa::MUSAGuard device_guard(weight.device());
+  at::native::embedding_sparse_update_stub(
+      kMUSA,
+      weight,
+      momentum,
+      grad_output,
+      indices,
+      optimizer,
+      lr,
+      eps,
+      weight_decay,
+      padding_idx);
+  return weight;
+}
+
+} // namespace
+
+// Fused embedding backward and SGD step, w[i] -= lr * (g[i] + wd * w[i]) for
+// every row i in `indices`, where g[i] sums the grad_output rows looked up at
+// i. Untouched rows are neither read nor written.
+Tensor& EmbeddingBackwardSGD_(
+    Tensor& weight,
+    const Tensor& grad_output,
+    const Tensor& indices,
+    double lr,
+    double weight_decay,
+    int64_t padding_idx) {
+  Tensor momentum;
+  return EmbeddingSparseUpdate(
+      weight,
+      momentum,
+      grad_output,
+      indices,
+      EmbeddingSparseOptimizer::SGD,
+      lr,
+      0.0,
+      weight_decay,
+      padding_idx);
+}
+
+// Fused embedding backward and rowwise Adagrad step as in FBGEMM's
+// split_embedding_codegen: momentum keeps one accumulator per row,
+// m[i] += mean(g[i]^2) and w[i] -= lr * g[i] / (sqrt(m[i]) + eps).
+Tensor& EmbeddingBackwardRowwiseAdagrad_(
+    Tensor& weight,
+    Tensor& momentum,
+    const Tensor& grad_output,
+    const Tensor& indices,
+    double lr,
+    double eps,
+    double weight_decay,
+    int64_t padding_idx) {
+  return EmbeddingSparseUpdate(
+      weight,
+      momentum,
+      grad_output,
+      indices,
+      EmbeddingSparseOptimizer::ROWWISE_ADAGRAD,
+      lr,
+      eps,
+      weight_decay,
+      padding_idx);
+}
+
+TORCH_LIBRARY_FRAGMENT(musa, m) {
+  m.def(
+      "embedding_backward_sgd_(Tensor(a!) weight, Tensor grad_output, Tensor indices, float lr, float weight_decay=0.0, int padding_idx=-1) -> Tensor(a!)");
+  m.def(
+      "embedding_backward_rowwise_adagrad_(Tensor(a!) weight, Tensor(b!) momentum, Tensor grad_output, Tensor indices, float lr, float eps=1e-10, float weight_decay=0.0, int padding_idx=-1) -> Tensor(a!)");
+  m.def(
+      "grouped_embedding_bag(Tensor[] weights, Tensor[] indices, Tensor[] offsets, int mode=0, bool include_last_offset=False) -> Tensor[]");
+  m.def(
+      "grouped_embedding_bag_backward(Tensor[] grads, Tensor[] indices, Tensor[] offsets, int[] num_weights, int mode=0, bool include_last_offset=False) -> Tensor[]");
+}
+
+TORCH_LIBRARY_IMPL(musa, PrivateUse1, m) {
+  m.impl("grouped_embedding_bag", &GroupedEmbeddingBag);
+  m.impl("grouped_embedding_bag_backward", &GroupedEmbeddingBagBackward);
+  m.impl("embedding_backward_sgd_", &EmbeddingBackwardSGD_);
+  m.impl(
+      "embedding_backward_rowwise_adagrad_",
+      &EmbeddingBackwardRowwiseAdagrad_);
+}
+
+TORCH_LIBRARY_IMPL(musa, CPU, m) {
+  m.impl("embedding_backward_sgd_", &EmbeddingBackwardSGD_);
+  m.impl(
+      "embedding_backward_rowwise_adagrad_",
+      &EmbeddingBackwardRowwiseAdagrad_);
+}
+
+TORCH_LIBRARY_IMPL(musa, Autograd, m) {
+  m.impl("grouped_embedding_bag", &GroupedEmbeddingBagAutograd);
+}
+
 } // namespace musa
 } // namespace at
@@ -23,6 +23,66 @@ using embedding_dense_backward_fn =
 
 DECLARE_DISPATCH(embedding_dense_backward_fn, embedding_dense_backward_stub);
 
+// Optimizers that embedding_sparse_update_stub applies to the touched rows.
+enum class EmbeddingSparseOptimizer { SGD, ROWWISE_ADAGRAD };
+
+// (weight, momentum, grad_output, indices, optimizer, lr, eps, weight_decay,
+// padding_idx), momentum is only read by ROWWISE_ADAGRAD
+using embedding_sparse_update_fn = void (*)(
+    Tensor&,
+    Tensor&,
+    const Tensor&,
+    const Tensor&,
+    EmbeddingSparseOptimizer,
+    double,
+    double,
+    double,
+    int64_t);
+
+DECLARE_DISPATCH(embedding_sparse_update_fn, embedding_sparse_update_stub);
+
+// Row layout of the int64 [NUM_FIELDS, num_tables + 1] metadata tensor of a
+// grouped embedding bag. The *_BEGIN rows are exclusive prefix sums over the
+// tables (entry num_tables holds the total), DIM and WEIGHT_PTR hold the
+// embedding dim and the weight data pointer of every table.
+enum class GroupedEmbeddingBagMeta : int {
+  BAG_BEGIN,
+  INDEX_BEGIN,
+  OFFSET_BEGIN,
+  OUTPUT_BEGIN,
+  ROW_BEGIN,
+  GRAD_BEGIN,
+  DIM,
+  WEIGHT_PTR,
+  NUM_FIELDS,
+};
+
+// (output, meta, indices, offsets, num_tables, num_bags, mode)
+using grouped_embedding_bag_fn = void (*)(
+    Tensor&,
+    const Tensor&,
+    const Tensor&,
+    const Tensor&,
+    int64_t,
+    int64_t,
+    int64_t);
+// (grad_weight, grad_output, meta, indices, offsets, num_tables, num_bags,
+// mode)
+using grouped_embedding_bag_backward_fn = void (*)(
+    Tensor&,
+    const Tensor&,
+    const Tensor&,
+    const Tensor&,
+    const Tensor&,
+    int64_t,
+    int64_t,
+    int64_t);
+
+DECLARE_DISPATCH(grouped_embedding_bag_fn, grouped_embedding_bag_stub);
+DECLARE_DISPATCH(
+    grouped_embedding_bag_backward_fn,
+    grouped_embedding_bag_backward_stub);
+
 } // namespace native
 } // namespace at
 
@@ -0,0 +1,460 @@
+#include <ATen/Config.h>
+#include <ATen/core/dispatch/Dispatcher.h>
+#include <ATen/native/layer_norm.h>
+#include <c10/util/accumulate.h>
+#include <torch/csrc/autograd/custom_function.h>
+#include <torch/library.h>
+
+#ifndef AT_PER_OPERATOR_HEADERS
+#include <ATen/Functions.h>
+#include <ATen/NativeFunctions.h>
+#else
+#include <ATen/ops/_fused_rmsnorm_backward.h>
+#include <ATen/ops/add.h>
+#include <ATen/ops/empty.h>
+#include <ATen/ops/empty_like.h>
+#include <ATen/ops/native_layer_norm.h>
+#include <ATen/ops/native_layer_norm_backward.h>
+#include <ATen/ops/rsqrt.h>
+#endif
+
+#include <numeric>
+
+#include "torch_musa/csrc/aten/ops/FusedAddNorm.h"
+#include "torch_musa/csrc/aten/utils/Utils.h"
+#include "torch_musa/csrc/core/MUSAGuard.h"
+
+namespace at {
+namespace native {
+
+DEFINE_DISPATCH(fused_add_norm_stub);
+
+REGISTER_NO_CPU_DISPATCH(fused_add_norm_stub);
+
+} // namespace native
+
+namespace musa {
+
+namespace {
+
+const char* NormName(bool rms) {
+  return rms ? "fused_add_rmsnorm" : "fused_add_layernorm";
+}
+
+void CheckFusedAddNorm(
+    const Tensor& input,
+    const Tensor& residual,
+    IntArrayRef normalized_shape,
+    const Tensor& weight,
+    const Tensor& bias,
+    bool rms) {
+  (void)native::_check_layer_norm_inputs(
+      input, normalized_shape, weight, bias);
+  TORCH_CHECK(
+      input.sizes() == residual.sizes(),
+      NormName(rms),
+      ": input and residual must have the same shape, but got ",
+      input.sizes(),
+      " and ",
+      residual.sizes());
+  const auto dtype = input.scalar_type();
+  TORCH_CHECK(
+      dtype == ScalarType::Float || dtype == ScalarType::Half ||
+          dtype == ScalarType::BFloat16,
+      NormName(rms),
+      " only supports Float32, Half and BFloat16, but got ",
+      dtype);
+  TORCH_CHECK(
+      residual.scalar_type() == dtype,
+      NormName(rms),
+      ": input and residual must have the same dtype");
+  // Float32 weight and bias of Half/BFloat16 activations, as kept under AMP,
+  // are read as they are.
+  auto param_ok = [dtype](const Tensor& param) {
+    return !param.defined() || param.scalar_type() == dtype ||
+        param.scalar_type() == ScalarType::Float;
+  };
+  TORCH_CHECK(
+      param_ok(weight) && param_ok(bias) &&
+          (!weight.defined() || !bias.defined() ||
+           weight.scalar_type() == bias.scalar_type()),
+      NormName(rms),
+      ": weight and bias must have the dtype of input or Float32, and the ",
+      "same one");
+  TORCH_CHECK(
+      residual.device() == input.device() &&
+          (!weight.defined() || weight.device() == input.device()) &&
+          (!bias.defined() || bias.device() == input.device()),
+      NormName(rms),
+      ": input, residual, weight and bias must be on the same device");
+}
+
+// Float32 weight or bias of a Half/BFloat16 input.
+bool HasMixedParams(
+    const Tensor& input,
+    const Tensor& weight,
+    const Tensor& bias) {
+  const Tensor& param = weight.defined() ? weight : bias;
+  return param.defined() && param.scalar_type() != input.scalar_type();
+}
+
+int64_t NormRows(const Tensor& input, IntArrayRef normalized_shape) {
+  const auto sizes = input.sizes();
+  return c10::multiply_integers(
+      sizes.begin(), sizes.end() - normalized_shape.size());
+}
+
+// [rows..., 1, ..., 1], the stat shape of native_layer_norm
+std::vector<int64_t> StatShape(
+    const Tensor& input,
+    IntArrayRef normalized_shape) {
+  std::vector<int64_t> shape(input.sizes().begin(), input.sizes().end());
+  std::fill(shape.end() - normalized_shape.size(), shape.end(), 1);
+  return shape;
+}
+
+std::vector<int64_t> ReduceDims(
+    const Tensor& input,
+    IntArrayRef normalized_shape) {
+  std::vector<int64_t> dims(normalized_shape.size());
+  std::iota(
+      dims.begin(),
+      dims.end(),
+      input.dim() - static_cast<int64_t>(normalized_shape.size()));
+  return dims;
+}
+
+// Unfused reference: the add in the input dtype, then the norm.
+void FusedAddNormCPU(
+    Tensor& out,
+    Tensor& residual_out,
+    Tensor& mean,
+    Tensor& rstd,
+    const Tensor& input,
+    const Tensor& residual,
+    IntArrayRef normalized_shape,
+    const Tensor& weight,
+    const Tensor& bias,
+    double eps,
+    bool rms) {
+  residual_out = at::add(input, residual);
+  if (!rms) {
+    const bool mixed = HasMixedParams(input, weight, bias);
+    Tensor stat_mean, stat_rstd;
+    std::tie(out, stat_mean, stat_rstd) = at::native_layer_norm(
+        mixed ? residual_out.to(kFloat) : residual_out,
+        normalized_shape,
+        weight,
+        bias,
+        eps);
+    out = out.to(input.scalar_type());
+    mean = stat_mean.flatten();
+    rstd = stat_rstd.flatten();
+    return;
+  }
+  const Tensor h = residual_out.to(kFloat);
+  const Tensor stat_rstd = at::rsqrt(
+      h.pow(2).mean(ReduceDims(input, normalized_shape), true).add_(eps));
+  Tensor y = h * stat_rstd;
+  if (weight.defined()) {
+    y.mul_(weight);
+  }
+  out = y.to(input.scalar_type());
+  rstd = stat_rstd.flatten();
+}
+
+std::tuple<Tensor, Tensor, Tensor, Tensor> FusedAddNormForward(
+    const Tensor& input,
+    const Tensor& residual,
+    IntArrayRef normalized_shape,
+    const c10::optional<Tensor>& weight_opt,
+    const c10::optional<Tensor>& bias_opt,
+    double eps,
+    bool rms) {
+  const Tensor weight = weight_opt.value_or(Tensor());
+  const Tensor bias = rms ? Tensor() : bias_opt.value_or(Tensor());
+  CheckFusedAddNorm(input, residual, normalized_shape, weight, bias, rms);
+  Tensor out, residual_out, mean, rstd;
+  if (input.device().is_cpu()) {
+    FusedAddNormCPU(
+        out,
+        residual_out,
+        mean,
+        rstd,
+        input,
+        residual,
+        normalized_shape,
+        weight,
+        bias,
+        eps,
+        rms);
+    return std::make_tuple(out, residual_out, mean, rstd);
+  }
+
+  const c10::musa::MUSAGuard device_guard(input.device());
+  const auto contig_input = FormatContiguous(input, MemoryFormat::Contiguous);
+  const auto contig_residual =
+      FormatContiguous(residual, MemoryFormat::Contiguous);
+  const auto contig_weight = weight.defined()
+      ? FormatContiguous(weight, MemoryFormat::Contiguous)
+      : Tensor();
+  const auto contig_bias = bias.defined()
+      ? FormatContiguous(bias, MemoryFormat::Contiguous)
+      : Tensor();
+  out = at::empty_like(contig_input);
+  residual_out = at::empty_like(contig_input);
+  const auto stat_options = input.options().dtype(kFloat);
+  const int64_t rows = NormRows(input, normalized_shape);
+  mean = rms ? Tensor() : at::empty({rows}, stat_options);
+  rstd = at::empty({rows}, stat_options);
+  at::native::fused_add_norm_stub(
+      kMUSA,
+      out,
+      residual_out,
+      mean,
+      rstd,
+      contig_input,
+      contig_residual,
+      contig_weight,
+      contig_bias,
+      eps,
+      rms);
+  return std::make_tuple(out, residual_out, mean, rstd);
+}
+
+// Gradients of the norm input h = input + residual, which are also those of
+// input and residual, plus the weight and bias gradients. grad_residual_out
+// is the gradient flowing into the returned residual.
+std::tuple<Tensor, Tensor, Tensor> FusedAddNormBackward(
+    const Tensor& grad_out,
+    const Tensor& grad_residual_out,
+    const Tensor& residual_out,
+    const Tensor& mean,
+    const Tensor& rstd,
+    IntArrayRef normalized_shape,
+    const c10::optional<Tensor>& weight_opt,
+    const c10::optional<Tensor>& bias_opt,
+    double eps,
+    bool rms) {
+  const Tensor weight = weight_opt.value_or(Tensor());
+  const Tensor bias = rms ? Tensor() : bias_opt.value_or(Tensor());
+  // Float32 parameters of Half/BFloat16 activations take the backward in
+  // float, the fused kernels read one dtype.
+  const bool mixed = HasMixedParams(residual_out, weight, bias);
+  Tensor grad_h, grad_weight, grad_bias;
+  if (!rms) {
+    const auto stat_shape = StatShape(residual_out, normalized_shape);
+    std::tie(grad_h, grad_weight, grad_bias) = at::native_layer_norm_backward(
+        mixed ? grad_out.to(kFloat) : grad_out,
+        mixed ? residual_out.to(kFloat) : residual_out,
+        normalized_shape,
+        mean.view(stat_shape),
+        rstd.view(stat_shape),
+        weight,
+        bias,
+        {true, weight.defined(), bias.defined()});
+    grad_h = grad_h.to(residual_out.scalar_type());
+  } else if (residual_out.device().is_cpu() || mixed) {
+    const auto dims = ReduceDims(residual_out, normalized_shape);
+    const Tensor stat_rstd =
+        rstd.view(StatShape(residual_out, normalized_shape));
+    const Tensor x_hat = residual_out.to(kFloat) * stat_rstd;
+    const Tensor dy = grad_out.to(kFloat);
+    const Tensor dx_hat = weight.defined() ? dy * weight.to(kFloat) : dy;
+    grad_h = (stat_rstd * (dx_hat - x_hat * (dx_hat * x_hat).mean(dims, true)))
+                 .to(residual_out.scalar_type());
+    if (weight.defined()) {
+      grad_weight = (dy * x_hat)
+                        .reshape({-1, weight.numel()})
+                        .sum(0)
+                        .view(weight.sizes())
+                        .to(weight.scalar_type());
+    }
+  } else {
+    std::vector<int64_t> rows_shape(
+        residual_out.sizes().begin(),
+        residual_out.sizes().end() - normalized_shape.size());
+    std::tie(grad_h, grad_weight) = at::_fused_rmsnorm_backward(
+        grad_out,
+        rstd.view(rows_shape),
+        residual_out,
+        normalized_shape,
+        eps,
+        weight_opt);
+  }
+  if (grad_residual_out.defined()) {
+    grad_h = grad_h + grad_residual_out;
+  }
+  return std::make_tuple(grad_h, grad_weight, grad_bias);
+}
+
+std::tuple<Tensor, Tensor, Tensor, Tensor> CallFusedAddNormForward(
+    const Tensor& input,
+    const Tensor& residual,
+    IntArrayRef normalized_shape,
+    const c10::optional<Tensor>& weight,
+    const c10::optional<Tensor>& bias,
+    double eps,
+    bool rms) {
+  static auto op = c10::Dispatcher::singleton()
+                       .findSchemaOrThrow("musa::_fused_add_norm_forward", "")
+                       .typed<decltype(FusedAddNormForward)>();
+  return op.call(input, residual, normalized_shape, weight, bias, eps, rms);
+}
+
+std::tuple<Tensor, Tensor, Tensor> CallFusedAddNormBackward(
+    const Tensor& grad_out,
+    const Tensor& grad_residual_out,
+    const Tensor& residual_out,
+    const Tensor& mean,
+    const Tensor& rstd,
+    IntArrayRef normalized_shape,
+    const c10::optional<Tensor>& weight,
+    const c10::optional<Tensor>& bias,
+    double eps,
+    bool rms) {
+  static auto op = c10::Dispatcher::singleton()
+                       .findSchemaOrThrow("musa::_fused_add_norm_backward", "")
+                       .typed<decltype(FusedAddNormBackward)>();
+  return op.call(
+      grad_out,
+      grad_residual_out,
+      residual_out,
+      mean,
+      rstd,
+      normalized_shape,
+      weight,
+      bias,
+      eps,
+      rms);
+}
+
+// Only the sum and the per-row statistics are saved, the sum doubles as the
+// norm input the backward needs.
+class FusedAddNormFunction
+    : public torch::autograd::Function<FusedAddNormFunction> {
+ public:
+  static torch::autograd::variable_list forward(
+      torch::autograd::AutogradContext* ctx,
+      const Tensor& input,
+      const Tensor& residual,
+      IntArrayRef normalized_shape,
+      const c10::optional<Tensor>& weight,
+      const c10::optional<Tensor>& bias,
+      double eps,
+      bool rms) {
+    at::AutoDispatchBelowADInplaceOrView guard;
+    Tensor out, residual_out, mean, rstd;
+    std::tie(out, residual_out, mean, rstd) = CallFusedAddNormForward(
+        input, residual, normalized_shape, weight, bias, eps, rms);
+    ctx->save_for_backward(
+        {residual_out,
+         mean,
+         rstd,
+         weight.value_or(Tensor()),
+         bias.value_or(Tensor())});
+    ctx->saved_data["normalized_shape"] = normalized_shape;
+    ctx->saved_data["eps"] = eps;
+    ctx->saved_data["rms"] = rms;
+    return {out, residual_out};
+  }
+
+  static torch::autograd::variable_list backward(
+      torch::autograd::AutogradContext* ctx,
+      torch::autograd::variable_list grad_outputs) {
+    const auto saved = ctx->get_saved_variables();
+    auto optional_of = [](const Tensor& t) {
+      return t.defined() ? c10::optional<Tensor>(t) : c10::nullopt;
+    };
+    Tensor grad_h, grad_weight, grad_bias;
+    std::tie(grad_h, grad_weight, grad_bias) = CallFusedAddNormBackward(
+        grad_outputs[0],
+        grad_outputs[1],
+        saved[0],
+        saved[1],
+        saved[2],
+        ctx->saved_data["normalized_shape"].toIntVector(),
+        optional_of(saved[3]),
+        optional_of(saved[4]),
+        ctx->saved_data["eps"].toDouble(),
+        ctx->saved_data["rms"].toBool());
+    return {
+        grad_h, grad_h, Tensor(), grad_weight, grad_bias, Tensor(), Tensor()};
+  }
+};
+
+} // anonymous namespace
+
+// residual_out = input + residual and output = rms_norm(residual_out) in one
+// pass over the hidden state, as run at every transformer block.
+std::tuple<Tensor, Tensor> FusedAddRMSNorm(
+    const Tensor& input,
+    const Tensor& residual,
+    IntArrayRef normalized_shape,
+    const c10::optional<Tensor>& weight,
+    double eps) {
+  auto outputs = CallFusedAddNormForward(
+      input, residual, normalized_shape, weight, c10::nullopt, eps, true);
+  return std::make_tuple(std::get<0>(outputs), std::get<1>(outputs));
+}
+
+std::tuple<Tensor, Tensor> FusedAddLayerNorm(
+    const Tensor& input,
+    const Tensor& residual,
+    IntArrayRef normalized_shape,
+    const c10::optional<Tensor>& weight,
+    const c10::optional<Tensor>& bias,
+    double eps) {
+  auto outputs = CallFusedAddNormForward(
+      input, residual, normalized_shape, weight, bias, eps, false);
+  return std::make_tuple(std::get<0>(outputs), std::get<1>(outputs));
+}
+
+std::tuple<Tensor, Tensor> FusedAddRMSNormAutograd(
+    const Tensor& input,
+    const Tensor& residual,
+    IntArrayRef normalized_shape,
+    const c10::optional<Tensor>& weight,
+    double eps) {
+  auto outputs = FusedAddNormFunction::apply(
+      input, residual, normalized_shape, weight, c10::nullopt, eps, true);
+  return std::make_tuple(outputs[0], outputs[1]);
+}
+
+std::tuple<Tensor, Tensor> FusedAddLayerNormAutograd(
+    const Tensor& input,
+    const Tensor& residual,
+    IntArrayRef normalized_shape,
+    const c10::optional<Tensor>& weight,
+    const c10::optional<Tensor>& bias,
+    double eps) {
+  auto outputs = FusedAddNormFunction::apply(
+      input, residual, normalized_shape, weight, bias, eps, false);
+  return std::make_tuple(outputs[0], outputs[1]);
+}
+
+TORCH_LIBRARY_FRAGMENT(musa, m) {
+  m.def(
+      "fused_add_rmsnorm(Tensor input, Tensor residual, int[] normalized_shape, Tensor? weight=None, float eps=1e-06) -> (Tensor output, Tensor residual_out)");
+  m.def(
+      "fused_add_layernorm(Tensor input, Tensor residual, int[] normalized_shape, Tensor? weight=None, Tensor? bias=None, float eps=1e-05) -> (Tensor output, Tensor residual_out)");
+  m.def(
+      "_fused_add_norm_forward(Tensor input, Tensor residual, int[] normalized_shape, Tensor? weight, Tensor? bias, float eps, bool rms) -> (Tensor output, Tensor residual_out, Tensor mean, Tensor rstd)");
+  m.def(
+      "_fused_add_norm_backward(Tensor grad_out, Tensor grad_residual_out, Tensor residual_out, Tensor mean, Tensor rstd, int[] normalized_shape, Tensor? weight, Tensor? bias, float eps, bool rms) -> (Tensor grad_input, Tensor grad_weight, Tensor grad_bias)");
+}
+
+TORCH_LIBRARY_IMPL(musa, CompositeExplicitAutograd, m) {
+  m.impl("fused_add_rmsnorm", &FusedAddRMSNorm);
+  m.impl("fused_add_layernorm", &FusedAddLayerNorm);
+  m.impl("_fused_add_norm_forward", &FusedAddNormForward);
+  m.impl("_fused_add_norm_backward", &FusedAddNormBackward);
+}
+
+TORCH_LIBRARY_IMPL(musa, Autograd, m) {
+  m.impl("fused_add_rmsnorm", &FusedAddRMSNormAutograd);
+  m.impl("fused_add_layernorm", &FusedAddLayerNormAutograd);
+}
+
+} // namespace musa
+} // namespace at
@@ -0,0 +1,32 @@
+#ifndef ATEN_SRC_ATEN_NATIVE_MUSA_FUSEDADDNORM_H_
+#define ATEN_SRC_ATEN_NATIVE_MUSA_FUSEDADDNORM_H_
+
+#include <ATen/core/Tensor.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at {
+namespace native {
+
+// (output, residual_out, mean, rstd, input, residual, weight, bias, eps, rms)
+// over contiguous [rows, cols] tensors: residual_out = input + residual, and
+// output normalizes every row of residual_out. mean and rstd are float [rows],
+// mean is undefined and bias ignored for RMSNorm. weight and bias may be
+// undefined.
+using fused_add_norm_fn = void (*)(
+    Tensor&,
+    Tensor&,
+    Tensor&,
+    Tensor&,
+    const Tensor&,
+    const Tensor&,
+    const Tensor&,
+    const Tensor&,
+    double,
+    bool);
+
+DECLARE_DISPATCH(fused_add_norm_fn, fused_add_norm_stub);
+
+} // namespace native
+} // namespace at
+
+#endif // ATEN_SRC_ATEN_NATIVE_MUSA_FUSEDADDNORM_H_
@@ -0,0 +1,329 @@
+#include <ATen/Config.h>
+#include <ATen/core/dispatch/Dispatcher.h>
+#include <c10/util/accumulate.h>
+#include <torch/csrc/autograd/custom_function.h>
+#include <torch/library.h>
+
+#ifndef AT_PER_OPERATOR_HEADERS
+#include <ATen/Functions.h>
+#include <ATen/NativeFunctions.h>
+#else
+#include <ATen/ops/cat.h>
+#include <ATen/ops/empty.h>
+#include <ATen/ops/erf.h>
+#include <ATen/ops/exp.h>
+#include <ATen/ops/gelu.h>
+#include <ATen/ops/sigmoid.h>
+#include <ATen/ops/silu.h>
+#include <ATen/ops/tanh.h>
+#endif
+
+#include <string>
+
+#include "torch_musa/csrc/aten/ops/GatedActivation.h"
+#include "torch_musa/csrc/aten/utils/Utils.h"
+#include "torch_musa/csrc/core/MUSAGuard.h"
+
+namespace at {
+namespace native {
+
+DEFINE_DISPATCH(gated_act_stub);
+DEFINE_DISPATCH(gated_act_backward_stub);
+
+REGISTER_NO_CPU_DISPATCH(gated_act_stub);
+REGISTER_NO_CPU_DISPATCH(gated_act_backward_stub);
+
+} // namespace native
+
+namespace musa {
+
+using native::GatedActType;
+
+namespace {
+
+GatedActType GatedActTypeFromName(c10::string_view activation) {
+  if (activation == "silu") {
+    return GatedActType::kSilu;
+  }
+  if (activation == "gelu_tanh") {
+    return GatedActType::kGeluTanh;
+  }
+  TORCH_CHECK(
+      activation == "gelu",
+      "gated activation: expected activation to be one of silu, gelu_tanh ",
+      "and gelu, but got ",
+      activation);
+  return GatedActType::kGelu;
+}
+
+void CheckGatedAct(const Tensor& input, const Tensor& up) {
+  TORCH_CHECK(
+      input.dim() >= 1, "gated activation: input must have at least 1 dim");
+  const auto dtype = input.scalar_type();
+  TORCH_CHECK(
+      dtype == ScalarType::Float || dtype == ScalarType::Half ||
+          dtype == ScalarType::BFloat16,
+      "gated activation only supports Float32, Half and BFloat16, but got ",
+      dtype);
+  if (up.defined()) {
+    TORCH_CHECK(
+        up.sizes() == input.sizes() && up.scalar_type() == dtype &&
+            up.device() == input.device(),
+        "gated activation: input and up must have the same shape, dtype and ",
+        "device");
+  } else {
+    TORCH_CHECK(
+        input.size(-1) % 2 == 0,
+        "gated activation: the last dim of input must be even when up is ",
+        "not given, but got ",
+        input.size(-1));
+  }
+}
+
+int64_t GatedHidden(const Tensor& input, const Tensor& up) {
+  return up.defined() ? input.size(-1) : input.size(-1) / 2;
+}
+
+// The [rows, hidden] halves act(a) * b is computed from: input and up, or
+// the first and the second half of the last dim of input.
+std::tuple<Tensor, Tensor> GatedHalves(const Tensor& input, const Tensor& up) {
+  const auto sizes = input.sizes();
+  const int64_t rows =
+      c10::multiply_integers(sizes.begin(), sizes.end() - 1);
+  const int64_t hidden = GatedHidden(input, up);
+  const auto contig_input = FormatContiguous(input, MemoryFormat::Contiguous);
+  if (up.defined()) {
+    const auto contig_up = FormatContiguous(up, MemoryFormat::Contiguous);
+    return std::make_tuple(
+        contig_input.view({rows, hidden}), contig_up.view({rows, hidden}));
+  }
+  const auto rows_input = contig_input.view({rows, 2 * hidden});
+  return std::make_tuple(
+      rows_input.narrow(1, 0, hidden), rows_input.narrow(1, hidden, hidden));
+}
+
+std::vector<int64_t> GatedOutputShape(const Tensor& input, const Tensor& up) {
+  std::vector<int64_t> shape(input.sizes().begin(), input.sizes().end());
+  shape.back() = GatedHidden(input, up);
+  return shape;
+}
+
+// Unfused references in float.
+Tensor ActCPU(const Tensor& x, GatedActType act) {
+  switch (act) {
+    case GatedActType::kSilu:
+      return at::silu(x);
+    case GatedActType::kGeluTanh:
+      return at::gelu(x, "tanh");
+    default:
+      return at::gelu(x);
+  }
+}
+
+Tensor ActGradCPU(const Tensor& x, GatedActType act) {
+  switch (act) {
+    case GatedActType::kSilu: {
+      const Tensor s = at::sigmoid(x);
+      return s * (1 + x * (1 - s));
+    }
+    case GatedActType::kGeluTanh: {
+      constexpr double kSqrt2_Pi = 0.79788456080286535588;
+      constexpr double kCoeff = 0.044715;
+      const Tensor t = at::tanh(kSqrt2_Pi * (x + kCoeff * x.pow(3)));
+      return 0.5 * (1 + t) +
+          0.5 * x * (1 - t * t) * kSqrt2_Pi * (1 + 3 * kCoeff * x * x);
+    }
+    default: {
+      constexpr double kSqrt1_2 = 0.70710678118654752440;
+      constexpr double kInvSqrt2Pi = 0.39894228040143267794;
+      return 0.5 * (1 + at::erf(x * kSqrt1_2)) +
+          x * kInvSqrt2Pi * at::exp(-0.5 * x * x);
+    }
+  }
+}
+
+} // anonymous namespace
+
+Tensor GatedActForward(
+    const Tensor& input,
+    const c10::optional<Tensor>& up_opt,
+    c10::string_view activation) {
+  const Tensor up = up_opt.value_or(Tensor());
+  CheckGatedAct(input, up);
+  const auto act = GatedActTypeFromName(activation);
+  Tensor a, b;
+  std::tie(a, b) = GatedHalves(input, up);
+  if (input.device().is_cpu()) {
+    return (ActCPU(a.to(kFloat), act) * b.to(kFloat))
+        .to(input.scalar_type())
+        .reshape(GatedOutputShape(input, up));
+  }
+
+  const c10::musa::MUSAGuard device_guard(input.device());
+  Tensor out = at::empty(GatedOutputShape(input, up), input.options());
+  Tensor rows_out = out.view({a.size(0), a.size(1)});
+  at::native::gated_act_stub(kMUSA, rows_out, a, b, act);
+  return out;
+}
+
+// Gradients of input and up, grad_up is undefined when both halves come from
+// input.
+std::tuple<Tensor, Tensor> GatedActBackward(
+    const Tensor& grad_out,
+    const Tensor& input,
+    const c10::optional<Tensor>& up_opt,
+    c10::string_view activation) {
+  const Tensor up = up_opt.value_or(Tensor());
+  CheckGatedAct(input, up);
+  const auto act = GatedActTypeFromName(activation);
+  Tensor a, b;
+  std::tie(a, b) = GatedHalves(input, up);
+  const int64_t rows = a.size(0);
+  const int64_t hidden = a.size(1);
+  const auto contig_grad_out =
+      FormatContiguous(grad_out, MemoryFormat::Contiguous).view({rows, hidden});
+  if (input.device().is_cpu()) {
+    const Tensor a_f = a.to(kFloat);
+    const Tensor b_f = b.to(kFloat);
+    const Tensor g = contig_grad_out.to(kFloat);
+    const Tensor grad_a =
+        (g * b_f * ActGradCPU(a_f, act)).to(input.scalar_type());
+    const Tensor grad_b = (g * ActCPU(a_f, act)).to(input.scalar_type());
+    if (up.defined()) {
+      return std::make_tuple(
+          grad_a.reshape(input.sizes()), grad_b.reshape(up.sizes()));
+    }
+    return std::make_tuple(
+        at::cat({grad_a, grad_b}, 1).reshape(input.sizes()), Tensor());
+  }
+
+  const c10::musa::MUSAGuard device_guard(input.device());
+  Tensor grad_input = at::empty(input.sizes(), input.options());
+  Tensor grad_up, grad_a, grad_b;
+  if (up.defined()) {
+    grad_up = at::empty(up.sizes(), up.options());
+    grad_a = grad_input.view({rows, hidden});
+    grad_b = grad_up.view({rows, hidden});
+  } else {
+    const auto rows_grad = grad_input.view({rows, 2 * hidden});
+    grad_a = rows_grad.narrow(1, 0, hidden);
+    grad_b = rows_grad.narrow(1, hidden, hidden);
+  }
+  at::native::gated_act_backward_stub(
+      kMUSA, grad_a, grad_b, contig_grad_out, a, b, act);
+  return std::make_tuple(grad_input, grad_up);
+}
+
+namespace {
+
+Tensor CallGatedActForward(
+    const Tensor& input,
+    const c10::optional<Tensor>& up,
+    c10::string_view activation) {
+  static auto op = c10::Dispatcher::singleton()
+                       .findSchemaOrThrow("musa::_gated_act_forward", "")
+                       .typed<decltype(GatedActForward)>();
+  return op.call(input, up, activation);
+}
+
+std::tuple<Tensor, Tensor> CallGatedActBackward(
+    const Tensor& grad_out,
+    const Tensor& input,
+    const c10::optional<Tensor>& up,
+    c10::string_view activation) {
+  static auto op = c10::Dispatcher::singleton()
+                       .findSchemaOrThrow("musa::_gated_act_backward", "")
+                       .typed<decltype(GatedActBackward)>();
+  return op.call(grad_out, input, up, activation);
+}
+
+// Only the inputs are saved, the backward recomputes act(a) instead of
+// keeping it alive from the forward.
+class GatedActFunction : public torch::autograd::Function<GatedActFunction> {
+ public:
+  static torch::autograd::variable_list forward(
+      torch::autograd::AutogradContext* ctx,
+      const Tensor& input,
+      const c10::optional<Tensor>& up,
+      const std::string& activation) {
+    at::AutoDispatchBelowADInplaceOrView guard;
+    ctx->save_for_backward({input, up.value_or(Tensor())});
+    ctx->saved_data["activation"] = activation;
+    return {CallGatedActForward(input, up, activation)};
+  }
+
+  static torch::autograd::variable_list backward(
+      torch::autograd::AutogradContext* ctx,
+      torch::autograd::variable_list grad_outputs) {
+    const auto saved = ctx->get_saved_variables();
+    const c10::optional<Tensor> up =
+        saved[1].defined() ? c10::optional<Tensor>(saved[1]) : c10::nullopt;
+    Tensor grad_input, grad_up;
+    std::tie(grad_input, grad_up) = CallGatedActBackward(
+        grad_outputs[0],
+        saved[0],
+        up,
+        ctx->saved_data["activation"].toStringRef());
+    return {grad_input, grad_up, Tensor()};
+  }
+};
+
+std::string GeluActivation(c10::string_view approximate) {
+  TORCH_CHECK(
+      approximate == "none" || approximate == "tanh",
+      "geglu: approximate must be none or tanh, but got ",
+      approximate);
+  return approximate == "tanh" ? "gelu_tanh" : "gelu";
+}
+
+} // anonymous namespace
+
+// silu(a) * b and gelu(a) * b, the gated MLP activations of LLaMA- and
+// T5-style blocks. a and b are the two halves of the last dim of input, or
+// input and up when the two projections are kept apart.
+Tensor SwiGLU(const Tensor& input, const c10::optional<Tensor>& up) {
+  return CallGatedActForward(input, up, "silu");
+}
+
+Tensor GeGLU(
+    const Tensor& input,
+    const c10::optional<Tensor>& up,
+    c10::string_view approximate) {
+  return CallGatedActForward(input, up, GeluActivation(approximate));
+}
+
+Tensor SwiGLUAutograd(const Tensor& input, const c10::optional<Tensor>& up) {
+  return GatedActFunction::apply(input, up, std::string("silu"))[0];
+}
+
+Tensor GeGLUAutograd(
+    const Tensor& input,
+    const c10::optional<Tensor>& up,
+    c10::string_view approximate) {
+  return GatedActFunction::apply(input, up, GeluActivation(approximate))[0];
+}
+
+TORCH_LIBRARY_FRAGMENT(musa, m) {
+  m.def("swiglu(Tensor input, Tensor? up=None) -> Tensor");
+  m.def(
+      "geglu(Tensor input, Tensor? up=None, str approximate=\"none\") -> Tensor");
+  m.def(
+      "_gated_act_forward(Tensor input, Tensor? up, str activation) -> Tensor");
+  m.def(
+      "_gated_act_backward(Tensor grad_out, Tensor input, Tensor? up, str activation) -> (Tensor grad_input, Tensor grad_up)");
+}
+
+TORCH_LIBRARY_IMPL(musa, CompositeExplicitAutograd, m) {
+  m.impl("swiglu", &SwiGLU);
+  m.impl("geglu", &GeGLU);
+  m.impl("_gated_act_forward", &GatedActForward);
+  m.impl("_gated_act_backward", &GatedActBackward);
+}
+
+TORCH_LIBRARY_IMPL(musa, Autograd, m) {
+  m.impl("swiglu", &SwiGLUAutograd);
+  m.impl("geglu", &GeGLUAutograd);
+}
+
+} // namespace musa
+} // namespace at
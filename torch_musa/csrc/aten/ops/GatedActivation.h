@@ -0,0 +1,35 @@
+#ifndef ATEN_SRC_ATEN_NATIVE_MUSA_GATEDACTIVATION_H_
+#define ATEN_SRC_ATEN_NATIVE_MUSA_GATEDACTIVATION_H_
+
+#include <ATen/core/Tensor.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at {
+namespace native {
+
+// Activation of the gate, act(a) * b.
+enum class GatedActType { kSilu, kGeluTanh, kGelu };
+
+// (out, a, b, act) over [rows, hidden] tensors: out = act(a) * b. a and b
+// share their row stride and have unit column stride, so they may be the two
+// halves of one [rows, 2 * hidden] tensor. out is contiguous.
+using gated_act_fn =
+    void (*)(Tensor&, const Tensor&, const Tensor&, GatedActType);
+
+// (grad_a, grad_b, grad_out, a, b, act), the activation is recomputed from a.
+// grad_a and grad_b share their row stride as a and b do.
+using gated_act_backward_fn = void (*)(
+    Tensor&,
+    Tensor&,
+    const Tensor&,
+    const Tensor&,
+    const Tensor&,
+    GatedActType);
+
+DECLARE_DISPATCH(gated_act_fn, gated_act_stub);
+DECLARE_DISPATCH(gated_act_backward_fn, gated_act_backward_stub);
+
+} // namespace native
+} // namespace at
+
+#endif // ATEN_SRC_ATEN_NATIVE_MUSA_GATEDACTIVATION_H_
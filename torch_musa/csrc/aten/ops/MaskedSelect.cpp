@@ -5,8 +5,10 @@
 #include <ATen/native/Resize.h>
 #include <torch/library.h>
 
+#include "torch_musa/csrc/aten/ops/StaticCompaction.h"
 #include "torch_musa/csrc/aten/ops/TensorFactory.h"
 #include "torch_musa/csrc/aten/utils/Utils.h"
+#include "torch_musa/csrc/core/MUSAFunctions.h"
 
 #include <mudnn.h>
 
@@ -69,6 +71,8 @@ at::Tensor& MaskedSelectOut(
   auto contiguous_mask = (*expand_mask).contiguous();
 
   out.resize_({(*expand_input).numel()});
+  // muDNN sizes the output on device and reads it back before returning
+  c10::musa::maybe_warn_or_error_on_sync();
   muHandle& h = GetMudnnHandle();
   ::musa::dnn::MaskedSelect maskedselect_op;
   auto mt_input = CreateMUTensor(contiguous_self);
@@ -97,6 +101,34 @@ at::Tensor& MaskedSelectOut(
   return out;
 }
 
+// masked_select with a caller-provided upper bound: the first `size` selected
+// elements are returned, missing ones are `fill_value`, and the true number of
+// selected elements is returned as a 0-dim device tensor without any sync.
+std::tuple<Tensor, Tensor> MaskedSelectStatic(
+    const Tensor& self,
+    const Tensor& mask,
+    int64_t size,
+    const Scalar& fill_value) {
+  TORCH_CHECK(
+      mask.scalar_type() == ScalarType::Byte ||
+          mask.scalar_type() == ScalarType::Bool,
+      "masked_select_static: expected BoolTensor or ByteTensor for mask,",
+      " but now is ",
+      mask.scalar_type());
+  TORCH_CHECK(
+      size >= 0,
+      "masked_select_static: 'size' must be an non-negative integer, but got ",
+      size);
+  const OptionalDeviceGuard device_guard(device_of(self));
+  c10::MaybeOwned<Tensor> expand_mask, expand_input;
+  std::tie(expand_mask, expand_input) = expand_outplace(mask, self);
+  Tensor flat_mask = expand_mask->ne(0).flatten();
+  Tensor out = at::full({size + 1}, fill_value, self.options());
+  out.scatter_(
+      0, StaticCompactionIndex(flat_mask, size), expand_input->flatten());
+  return std::make_tuple(out.narrow(0, 0, size), flat_mask.sum(kLong));
+}
+
 at::Tensor MaskedSelect(const at::Tensor& input, const at::Tensor& mask) {
   c10::musa::MUSAGuard device_guard(input.device());
   auto result = at::empty({0}, input.options());
@@ -162,5 +194,18 @@ at::Tensor& MaskedScatter(
   return self;
 }
 
+TORCH_LIBRARY_FRAGMENT(musa, m) {
+  m.def(
+      "masked_select_static(Tensor self, Tensor mask, int size, Scalar fill_value=0) -> (Tensor, Tensor)");
+}
+
+TORCH_LIBRARY_IMPL(musa, PrivateUse1, m) {
+  m.impl("masked_select_static", &MaskedSelectStatic);
+}
+
+TORCH_LIBRARY_IMPL(musa, CPU, m) {
+  m.impl("masked_select_static", &MaskedSelectStatic);
+}
+
 } // namespace musa
 } // namespace at
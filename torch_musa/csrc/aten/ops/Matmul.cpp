@@ -4,6 +4,7 @@
 
 #include <mudnn.h>
 
+#include "torch_musa/csrc/aten/mudnn/OpCache.h"
 #include "torch_musa/csrc/aten/ops/TensorFactory.h"
 #include "torch_musa/csrc/aten/utils/Context.h"
 #include "torch_musa/csrc/aten/utils/Utils.h"
@@ -78,35 +79,52 @@ void MmCall(
                      : CreateMUTensor(ContiguousRef(r, contiguous_r));
   auto rst = CreateMUTensor(out);
 
-  ::musa::dnn::MatMul mm;
-  CHECK_MUDNN_STATUS(
-      mm.SetComputeMode(at::musa::GetComputeModeFromCtx(l.scalar_type())),
-      "SetComputeMode");
-  CHECK_MUDNN_STATUS(mm.SetTranspose(trans_l, trans_r), "SetTranspose");
+  enum class BiasMode : int64_t { FULL, BROADCAST, NONE };
+  const BiasMode bias_mode = !bias.has_value() ? BiasMode::NONE
+      : bias->sizes() == out.sizes()           ? BiasMode::FULL
+      : bias->dim() == 1                       ? BiasMode::BROADCAST
+                                               : BiasMode::NONE;
+  const double alpha_value = alpha.to<double>();
+  const double beta_value = beta.to<double>();
+  const auto compute_mode = at::musa::GetComputeModeFromCtx(l.scalar_type());
+
+  MudnnOpKey key(MudnnOpKind::MATMUL);
+  key.Add(static_cast<int64_t>(compute_mode))
+      .Add(static_cast<int64_t>(trans_l))
+      .Add(static_cast<int64_t>(trans_r))
+      .Add(static_cast<int64_t>(bias_mode))
+      .Add(alpha_value)
+      .Add(beta_value);
+  ::musa::dnn::MatMul scratch;
+  auto& mm = CachedMudnnOp(key, scratch, [&](::musa::dnn::MatMul& op) {
+    CHECK_MUDNN_STATUS(op.SetComputeMode(compute_mode), "SetComputeMode");
+    CHECK_MUDNN_STATUS(op.SetTranspose(trans_l, trans_r), "SetTranspose");
+    CHECK_MUDNN_STATUS(op.SetAlpha(alpha_value), "SetAlpha");
+    if (bias_mode == BiasMode::FULL) {
+      CHECK_MUDNN_STATUS(op.SetBeta(beta_value), "SetBeta");
+    } else if (bias_mode == BiasMode::BROADCAST) {
+      CHECK_MUDNN_STATUS(op.SetGamma(beta_value), "SetGamma");
+    }
+  });
 
-  if (bias.has_value() && bias->sizes() == out.sizes()) {
+  if (bias_mode == BiasMode::FULL) {
     // For both inplace and outplace, we run muDNN MM with `d = alpha * a @ b +
     // beta * c + gamma * bias`, of which the bias is omitted
     auto bmt = CreateMUTensor(bias.value());
-    CHECK_MUDNN_STATUS(mm.SetAlpha(alpha.to<double>()), "SetAlpha");
-    CHECK_MUDNN_STATUS(mm.SetBeta(beta.to<double>()), "SetBeta");
     CHECK_MUDNN_STATUS(
         mm.RunWithBiasAdd(h, rst, lmt, rmt, bmt, muTensor(), InternalMemAlloc),
         "RunWithBiasAdd");
-  } else if (bias.has_value() && bias->dim() == 1) {
+  } else if (bias_mode == BiasMode::BROADCAST) {
     // TODO(@mt-ai): should we check the bias is broadcastable?
     // Run muDNN MM with `d = alpha * a @ b + beta * c + gamma * bias`, of
     // which c == d
     auto bmt = CreateMUTensor(bias.value());
-    CHECK_MUDNN_STATUS(mm.SetAlpha(alpha.to<double>()), "SetAlpha");
-    CHECK_MUDNN_STATUS(mm.SetGamma(beta.to<double>()), "SetGamma");
     CHECK_MUDNN_STATUS(
         mm.RunWithBiasAdd(h, rst, lmt, rmt, rst, bmt, InternalMemAlloc),
         "RunWithBiasAdd");
   } else {
     // Run muDNN with `c = alpha * a @ b + beta * c`, then `c += gamma * bias`
     // if bias is given (scalar or [M, 1] for gemm)
-    CHECK_MUDNN_STATUS(mm.SetAlpha(alpha.to<double>()), "SetAlpha");
     CHECK_MUDNN_STATUS(mm.Run(h, rst, lmt, rmt, InternalMemAlloc), "Run");
     if (bias.has_value()) {
       out.add_(bias.value(), beta);
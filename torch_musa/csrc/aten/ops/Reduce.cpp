@@ -104,6 +104,7 @@
 #include <ATen/ops/zeros_like.h>
 #endif
 
+#include "torch_musa/csrc/aten/mudnn/OpCache.h"
 #include "torch_musa/csrc/aten/ops/TensorFactory.h"
 #include "torch_musa/csrc/aten/utils/Utils.h"
 #include "torch_musa/csrc/utils/musa_lazy_init.h"
@@ -160,33 +161,43 @@ void ReduceCall(
   auto in = CreateMUTensor(input);
 
   muHandle& h = GetMudnnHandle();
-  ::musa::dnn::Reduce r;
-  CHECK_MUDNN_STATUS(r.SetMode(m), "SetMode");
   // That input is scalar, but dim = [0] is allowed in PyTorch, in which case
   // we need pass an empty 'dim' paramter to Reduce in muDNN.
-  if (self.dim() == 0 && self.numel() == 1) {
-    CHECK_MUDNN_STATUS(r.SetDim({}), "SetDim");
-  } else {
-    std::vector<int> dim_int(dim.begin(), dim.end());
-    CHECK_MUDNN_STATUS(r.SetDim(dim_int.size(), dim_int.data()), "SetDim");
-  }
+  const bool scalar_input = self.dim() == 0 && self.numel() == 1;
   // set order parameter for norm op
-  if (is_norm) {
-    float p_value = 2.0f;
-    if (p.has_value()) {
-      auto val = p.value();
-      if (val.isIntegral(false)) {
-        p_value = static_cast<float>(val.to<int64_t>());
-      } else if (val.isFloatingPoint()) {
-        p_value = static_cast<float>(val.to<double>());
-      } else {
-        TORCH_CHECK(
-            false, "norm_kernel_musa_impl expects norm to be integer or float");
-      }
+  float p_value = 2.0f;
+  if (is_norm && p.has_value()) {
+    auto val = p.value();
+    if (val.isIntegral(false)) {
+      p_value = static_cast<float>(val.to<int64_t>());
+    } else if (val.isFloatingPoint()) {
+      p_value = static_cast<float>(val.to<double>());
+    } else {
+      TORCH_CHECK(
+          false, "norm_kernel_musa_impl expects norm to be integer or float");
     }
-    CHECK_MUDNN_STATUS(r.SetNormOrd(p_value), "SetNormOrd");
   }
 
+  MudnnOpKey key(MudnnOpKind::REDUCE);
+  key.Add(static_cast<int64_t>(m))
+      .Add(static_cast<int64_t>(scalar_input))
+      .Add(dim)
+      .Add(static_cast<int64_t>(is_norm))
+      .Add(static_cast<double>(p_value));
+  ::musa::dnn::Reduce scratch;
+  auto& r = CachedMudnnOp(key, scratch, [&](::musa::dnn::Reduce& op) {
+    CHECK_MUDNN_STATUS(op.SetMode(m), "SetMode");
+    if (scalar_input) {
+      CHECK_MUDNN_STATUS(op.SetDim({}), "SetDim");
+    } else {
+      std::vector<int> dim_int(dim.begin(), dim.end());
+      CHECK_MUDNN_STATUS(op.SetDim(dim_int.size(), dim_int.data()), "SetDim");
+    }
+    if (is_norm) {
+      CHECK_MUDNN_STATUS(op.SetNormOrd(p_value), "SetNormOrd");
+    }
+  });
+
   CHECK_MUDNN_STATUS(r.Run(h, out, in, InternalMemAlloc), "Run");
 }
 
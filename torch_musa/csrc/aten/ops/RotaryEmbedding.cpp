@@ -0,0 +1,327 @@
+#include <ATen/Config.h>
+#include <ATen/core/dispatch/Dispatcher.h>
+#include <torch/csrc/autograd/custom_function.h>
+#include <torch/csrc/autograd/variable.h>
+#include <torch/library.h>
+
+#ifndef AT_PER_OPERATOR_HEADERS
+#include <ATen/Functions.h>
+#include <ATen/NativeFunctions.h>
+#else
+#include <ATen/ops/arange.h>
+#endif
+
+#include "torch_musa/csrc/aten/ops/RotaryEmbedding.h"
+#include "torch_musa/csrc/aten/utils/Utils.h"
+#include "torch_musa/csrc/core/MUSAGuard.h"
+
+namespace at {
+namespace native {
+
+DEFINE_DISPATCH(rotary_embedding_stub);
+
+REGISTER_NO_CPU_DISPATCH(rotary_embedding_stub);
+
+} // namespace native
+
+namespace musa {
+
+namespace {
+
+void CheckRotaryEmbedding(
+    const Tensor& q,
+    const Tensor& k,
+    const Tensor& cos,
+    const Tensor& sin,
+    const c10::optional<Tensor>& position_ids) {
+  TORCH_CHECK(
+      q.dim() == 4 && k.dim() == 4,
+      "fused_rope expects q and k of shape [batch, seq_len, num_heads, ",
+      "head_dim], but got ",
+      q.sizes(),
+      " and ",
+      k.sizes());
+  TORCH_CHECK(
+      q.size(0) == k.size(0) && q.size(1) == k.size(1),
+      "fused_rope: q and k must have the same batch and seq_len");
+  TORCH_CHECK(
+      q.scalar_type() == k.scalar_type() && q.device() == k.device(),
+      "fused_rope: q and k must have the same dtype and device");
+  TORCH_CHECK(
+      q.stride(3) == 1 && k.stride(3) == 1,
+      "fused_rope: the head_dim of q and k must be contiguous");
+  TORCH_CHECK(
+      cos.dim() == 2 && cos.sizes() == sin.sizes() && cos.size(1) > 0,
+      "fused_rope expects cos and sin of shape [max_positions, rot_dim / 2], ",
+      "but got ",
+      cos.sizes(),
+      " and ",
+      sin.sizes());
+  const int64_t rot_dim = 2 * cos.size(1);
+  TORCH_CHECK(
+      rot_dim <= q.size(3) && rot_dim <= k.size(3),
+      "fused_rope: rot_dim (",
+      rot_dim,
+      ") exceeds the head_dim of q or k");
+  if (position_ids.has_value()) {
+    const Tensor& pos = *position_ids;
+    TORCH_CHECK(
+        (pos.dim() == 1 && pos.size(0) == q.size(1)) ||
+            (pos.dim() == 2 && pos.size(1) == q.size(1) &&
+             (pos.size(0) == q.size(0) || pos.size(0) == 1)),
+        "fused_rope expects position_ids of shape [seq_len] or [batch, ",
+        "seq_len], but got ",
+        pos.sizes());
+    TORCH_CHECK(
+        !isFloatingType(pos.scalar_type()),
+        "fused_rope: position_ids must be integral");
+  } else {
+    TORCH_CHECK(
+        q.size(1) <= cos.size(0),
+        "fused_rope: seq_len (",
+        q.size(1),
+        ") exceeds the max_positions of cos and sin (",
+        cos.size(0),
+        ")");
+  }
+}
+
+// int64 positions of shape [B, S] or [1, S], undefined for 0..S-1.
+Tensor Positions(
+    const c10::optional<Tensor>& position_ids,
+    const Tensor& q) {
+  if (!position_ids.has_value()) {
+    return Tensor();
+  }
+  const Tensor pos = position_ids->to(q.device(), kLong).contiguous();
+  return pos.dim() == 1 ? pos.unsqueeze(0) : pos;
+}
+
+void RotaryEmbeddingCPU(
+    Tensor& q,
+    Tensor& k,
+    const Tensor& cos,
+    const Tensor& sin,
+    const Tensor& positions,
+    bool interleaved,
+    bool inverse) {
+  const int64_t half = cos.size(1);
+  const Tensor pos = positions.defined()
+      ? positions
+      : at::arange(q.size(1), q.options().dtype(kLong)).unsqueeze(0);
+  // [B or 1, S, 1, half]
+  auto gather = [&](const Tensor& table) {
+    return table.index_select(0, pos.flatten())
+        .view({pos.size(0), pos.size(1), 1, half});
+  };
+  const Tensor c = gather(cos);
+  const Tensor s = inverse ? gather(sin).neg() : gather(sin);
+  auto rotate = [&](Tensor& x) {
+    const Tensor rot = x.narrow(-1, 0, 2 * half);
+    Tensor x1, x2;
+    if (interleaved) {
+      const Tensor pairs = rot.unflatten(-1, {half, 2});
+      x1 = pairs.select(-1, 0);
+      x2 = pairs.select(-1, 1);
+    } else {
+      x1 = rot.narrow(-1, 0, half);
+      x2 = rot.narrow(-1, half, half);
+    }
+    // copies, x1 is overwritten before x2 is computed
+    const Tensor f1 = x1.to(kFloat, /*non_blocking=*/false, /*copy=*/true);
+    const Tensor f2 = x2.to(kFloat, /*non_blocking=*/false, /*copy=*/true);
+    x1.copy_(f1 * c - f2 * s);
+    x2.copy_(f2 * c + f1 * s);
+  };
+  rotate(q);
+  rotate(k);
+}
+
+void RotaryEmbeddingInplace(
+    Tensor& q,
+    Tensor& k,
+    const Tensor& cos,
+    const Tensor& sin,
+    const c10::optional<Tensor>& position_ids,
+    bool interleaved,
+    bool inverse) {
+  CheckRotaryEmbedding(q, k, cos, sin, position_ids);
+  const Tensor positions = Positions(position_ids, q);
+  const Tensor cos_f = cos.to(q.device(), kFloat).contiguous();
+  const Tensor sin_f = sin.to(q.device(), kFloat).contiguous();
+  if (q.device().is_cpu()) {
+    RotaryEmbeddingCPU(q, k, cos_f, sin_f, positions, interleaved, inverse);
+    return;
+  }
+  c10::musa::MUSAGuard device_guard(q.device());
+  at::native::rotary_embedding_stub(
+      kMUSA, q, k, cos_f, sin_f, positions, interleaved, inverse);
+}
+
+} // anonymous namespace
+
+// Rotary position embedding of q and k in one pass, in place. Feature pairs
+// (x1, x2) of the first rot_dim = 2 * cos.size(1) features of every head
+// become (x1 * cos - x2 * sin, x2 * cos + x1 * sin) at the token's position,
+// the remaining features are left untouched.
+std::tuple<Tensor&, Tensor&> FusedRope_(
+    Tensor& q,
+    Tensor& k,
+    const Tensor& cos,
+    const Tensor& sin,
+    const c10::optional<Tensor>& position_ids,
+    bool interleaved) {
+  RotaryEmbeddingInplace(
+      q, k, cos, sin, position_ids, interleaved, /*inverse=*/false);
+  return std::forward_as_tuple(q, k);
+}
+
+// The rotation is orthogonal, its backward rotates the gradients back by the
+// same angles.
+std::tuple<Tensor, Tensor> FusedRopeBackward(
+    const Tensor& grad_q,
+    const Tensor& grad_k,
+    const Tensor& cos,
+    const Tensor& sin,
+    const c10::optional<Tensor>& position_ids,
+    bool interleaved) {
+  Tensor grad_q_in = grad_q.clone(at::MemoryFormat::Contiguous);
+  Tensor grad_k_in = grad_k.clone(at::MemoryFormat::Contiguous);
+  RotaryEmbeddingInplace(
+      grad_q_in,
+      grad_k_in,
+      cos,
+      sin,
+      position_ids,
+      interleaved,
+      /*inverse=*/true);
+  return std::make_tuple(grad_q_in, grad_k_in);
+}
+
+namespace {
+
+std::tuple<Tensor&, Tensor&> CallFusedRope_(
+    Tensor& q,
+    Tensor& k,
+    const Tensor& cos,
+    const Tensor& sin,
+    const c10::optional<Tensor>& position_ids,
+    bool interleaved) {
+  static auto op = c10::Dispatcher::singleton()
+                       .findSchemaOrThrow("musa::fused_rope_", "")
+                       .typed<decltype(FusedRope_)>();
+  return op.call(q, k, cos, sin, position_ids, interleaved);
+}
+
+std::tuple<Tensor, Tensor> CallFusedRopeBackward(
+    const Tensor& grad_q,
+    const Tensor& grad_k,
+    const Tensor& cos,
+    const Tensor& sin,
+    const c10::optional<Tensor>& position_ids,
+    bool interleaved) {
+  static auto op = c10::Dispatcher::singleton()
+                       .findSchemaOrThrow("musa::fused_rope_backward", "")
+                       .typed<decltype(FusedRopeBackward)>();
+  return op.call(grad_q, grad_k, cos, sin, position_ids, interleaved);
+}
+
+class FusedRopeFunction : public torch::autograd::Function<FusedRopeFunction> {
+ public:
+  static torch::autograd::variable_list forward(
+      torch::autograd::AutogradContext* ctx,
+      Tensor q,
+      Tensor k,
+      const Tensor& cos,
+      const Tensor& sin,
+      const c10::optional<Tensor>& position_ids,
+      bool interleaved) {
+    {
+      at::AutoDispatchBelowADInplaceOrView guard;
+      CallFusedRope_(q, k, cos, sin, position_ids, interleaved);
+    }
+    torch::autograd::impl::bump_version(q);
+    torch::autograd::impl::bump_version(k);
+    ctx->mark_dirty({q, k});
+    ctx->save_for_backward({cos, sin, position_ids.value_or(Tensor())});
+    ctx->saved_data["interleaved"] = interleaved;
+    return {q, k};
+  }
+
+  static torch::autograd::variable_list backward(
+      torch::autograd::AutogradContext* ctx,
+      torch::autograd::variable_list grad_outputs) {
+    const auto saved = ctx->get_saved_variables();
+    c10::optional<Tensor> position_ids;
+    if (saved[2].defined()) {
+      position_ids = saved[2];
+    }
+    // grads are materialized, an unused output of the pair gets zeros
+    Tensor grad_q, grad_k;
+    std::tie(grad_q, grad_k) = CallFusedRopeBackward(
+        grad_outputs[0],
+        grad_outputs[1],
+        saved[0],
+        saved[1],
+        position_ids,
+        ctx->saved_data["interleaved"].toBool());
+    return {
+        grad_q,
+        grad_k,
+        Tensor(),
+        Tensor(),
+        Tensor(),
+        Tensor()};
+  }
+};
+
+} // anonymous namespace
+
+std::tuple<Tensor&, Tensor&> FusedRopeAutograd_(
+    Tensor& q,
+    Tensor& k,
+    const Tensor& cos,
+    const Tensor& sin,
+    const c10::optional<Tensor>& position_ids,
+    bool interleaved) {
+  FusedRopeFunction::apply(q, k, cos, sin, position_ids, interleaved);
+  return std::forward_as_tuple(q, k);
+}
+
+std::tuple<Tensor, Tensor> FusedRope(
+    const Tensor& q,
+    const Tensor& k,
+    const Tensor& cos,
+    const Tensor& sin,
+    const c10::optional<Tensor>& position_ids,
+    bool interleaved) {
+  Tensor q_out = q.clone();
+  Tensor k_out = k.clone();
+  CallFusedRope_(q_out, k_out, cos, sin, position_ids, interleaved);
+  return std::make_tuple(q_out, k_out);
+}
+
+TORCH_LIBRARY_FRAGMENT(musa, m) {
+  m.def(
+      "fused_rope_(Tensor(a!) q, Tensor(b!) k, Tensor cos, Tensor sin, Tensor? position_ids=None, bool interleaved=False) -> (Tensor(a!), Tensor(b!))");
+  m.def(
+      "fused_rope(Tensor q, Tensor k, Tensor cos, Tensor sin, Tensor? position_ids=None, bool interleaved=False) -> (Tensor, Tensor)");
+  m.def(
+      "fused_rope_backward(Tensor grad_q, Tensor grad_k, Tensor cos, Tensor sin, Tensor? position_ids=None, bool interleaved=False) -> (Tensor, Tensor)");
+}
+
+TORCH_LIBRARY_IMPL(musa, CompositeExplicitAutograd, m) {
+  m.impl("fused_rope_", &FusedRope_);
+  m.impl("fused_rope_backward", &FusedRopeBackward);
+}
+
+TORCH_LIBRARY_IMPL(musa, Autograd, m) {
+  m.impl("fused_rope_", &FusedRopeAutograd_);
+}
+
+TORCH_LIBRARY_IMPL(musa, CompositeImplicitAutograd, m) {
+  m.impl("fused_rope", &FusedRope);
+}
+
+} // namespace musa
+} // namespace at
@@ -0,0 +1,29 @@
+#ifndef ATEN_SRC_ATEN_NATIVE_MUSA_ROTARYEMBEDDING_H_
+#define ATEN_SRC_ATEN_NATIVE_MUSA_ROTARYEMBEDDING_H_
+
+#include <ATen/core/Tensor.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at {
+namespace native {
+
+// (q [B, S, Hq, Dq], k [B, S, Hk, Dk], cos float [max_positions, rot_dim / 2],
+// sin, positions int64 [B, S] or [1, S] or undefined for 0..S-1,
+// interleaved, inverse). Rotates the first rot_dim features of every head in
+// place, by -angle when inverse is set. interleaved pairs features
+// (2i, 2i + 1) as in GPT-J, otherwise (i, i + rot_dim / 2) as in GPT-NeoX.
+using rotary_embedding_fn = void (*)(
+    Tensor&,
+    Tensor&,
+    const Tensor&,
+    const Tensor&,
+    const Tensor&,
+    bool,
+    bool);
+
+DECLARE_DISPATCH(rotary_embedding_fn, rotary_embedding_stub);
+
+} // namespace native
+} // namespace at
+
+#endif // ATEN_SRC_ATEN_NATIVE_MUSA_ROTARYEMBEDDING_H_
@@ -3,6 +3,7 @@
 #include <torch/library.h>
 
 #include "torch_musa/csrc/aten/utils/Utils.h"
+#include "torch_musa/csrc/core/MUSAFunctions.h"
 #include "torch_musa/csrc/core/MUSAGuard.h"
 
 #include <mudnn.h>
@@ -13,6 +14,7 @@ namespace musa {
 Scalar LocalScalarDense_(const Tensor& self) {
   Scalar r;
   c10::musa::MUSAGuard device_guard(self.device());
+  c10::musa::maybe_warn_or_error_on_sync();
   AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND4(
       kComplexHalf,
       kHalf,
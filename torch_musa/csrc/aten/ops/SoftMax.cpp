@@ -7,6 +7,7 @@
 #include <ATen/native/ReduceOpsUtils.h>
 #include <torch/library.h>
 
+#include "torch_musa/csrc/aten/mudnn/OpCache.h"
 #include "torch_musa/csrc/aten/ops/TensorFactory.h"
 #include "torch_musa/csrc/aten/utils/Utils.h"
 
@@ -25,14 +26,19 @@ void SoftMaxCall(
     SOFTMAX_MODE mode) {
   c10::musa::MUSAGuard device_guard(input.device());
   muHandle& h = GetMudnnHandle();
-  ::musa::dnn::Softmax softmax;
   auto input_m = CreateMUTensor(input);
   auto output_m = CreateMUTensor(output);
-  CHECK_MUDNN_STATUS(softmax.SetMode(mode), "SetMode");
-  CHECK_MUDNN_STATUS(softmax.SetDim(static_cast<int>(dim)), "SetDim");
-  CHECK_MUDNN_STATUS(
-      softmax.SetAlgorithm(::musa::dnn::Softmax::Algorithm::ACCURATE),
-      "SetAlgorithm");
+  MudnnOpKey key(MudnnOpKind::SOFTMAX);
+  key.Add(static_cast<int64_t>(mode)).Add(dim);
+  ::musa::dnn::Softmax scratch;
+  auto& softmax =
+      CachedMudnnOp(key, scratch, [&](::musa::dnn::Softmax& op) {
+        CHECK_MUDNN_STATUS(op.SetMode(mode), "SetMode");
+        CHECK_MUDNN_STATUS(op.SetDim(static_cast<int>(dim)), "SetDim");
+        CHECK_MUDNN_STATUS(
+            op.SetAlgorithm(::musa::dnn::Softmax::Algorithm::ACCURATE),
+            "SetAlgorithm");
+      });
   CHECK_MUDNN_STATUS(softmax.Run(h, output_m, input_m), "Run");
 }
 
@@ -0,0 +1,18 @@
+#ifndef ATEN_SRC_ATEN_NATIVE_MUSA_STATICCOMPACTION_H_
+#define ATEN_SRC_ATEN_NATIVE_MUSA_STATICCOMPACTION_H_
+
+#include <ATen/core/Tensor.h>
+
+namespace at {
+namespace musa {
+
+// Destination slot of every element of a flattened selection mask for a
+// static-size compaction: selected elements go to their rank among the
+// selected ones, everything else (and ranks beyond `size`) to the spill slot
+// `size`. Callers scatter into a buffer of size + 1 and drop the last slot.
+Tensor StaticCompactionIndex(const Tensor& flat_mask, int64_t size);
+
+} // namespace musa
+} // namespace at
+
+#endif // ATEN_SRC_ATEN_NATIVE_MUSA_STATICCOMPACTION_H_
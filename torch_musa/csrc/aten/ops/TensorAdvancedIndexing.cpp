@@ -1,4 +1,5 @@
 #include <ATen/ATen.h>
+#include <ATen/native/Resize.h>
 
 #ifndef AT_PER_OPERATOR_HEADERS
 #include <ATen/Functions.h>
@@ -7,11 +8,16 @@
 #include <ATen/ops/count_nonzero.h>
 #include <ATen/ops/count_nonzero_native.h>
 #include <ATen/ops/nonzero_native.h>
+#include <ATen/ops/nonzero_static_native.h>
 #include <ATen/ops/nonzero_numpy_native.h>
 #endif
 
+#include <torch/library.h>
+
+#include "torch_musa/csrc/aten/ops/StaticCompaction.h"
 #include "torch_musa/csrc/aten/ops/TensorFactory.h"
 #include "torch_musa/csrc/aten/utils/Utils.h"
+#include "torch_musa/csrc/core/MUSAFunctions.h"
 
 namespace at::musa {
 
@@ -52,6 +58,8 @@ at::Tensor& NonzeroOut(const at::Tensor& self, at::Tensor& out) {
       out.dtype());
   out.resize_({contiguous_self.numel(), contiguous_self.dim()});
 
+  // muDNN sizes the output on device and reads it back before returning
+  c10::musa::maybe_warn_or_error_on_sync();
   muHandle& h = GetMudnnHandle();
   ::musa::dnn::Nonzero op;
   auto mt_input = CreateMUTensor(contiguous_self);
@@ -82,4 +90,81 @@ Tensor CountNonzero(const Tensor& self, IntArrayRef dims) {
   return (self != 0).sum(dims);
 }
 
+Tensor StaticCompactionIndex(const Tensor& flat_mask, int64_t size) {
+  Tensor rank = flat_mask.cumsum(0, kLong).sub_(1);
+  return at::where(flat_mask.logical_and(rank.lt(size)), rank, size);
+}
+
+// nonzero with a caller-provided upper bound: the first `size` indices are
+// returned, missing rows are filled with `fill_value`, and the true number of
+// nonzero elements is returned as a 0-dim device tensor. Nothing is read back
+// to the host.
+std::tuple<Tensor, Tensor> NonzeroStaticWithCount(
+    const Tensor& self,
+    int64_t size,
+    int64_t fill_value) {
+  TORCH_CHECK(
+      size >= 0,
+      "nonzero_static: 'size' must be an non-negative integer, but got ",
+      size);
+  const OptionalDeviceGuard device_guard(device_of(self));
+  const int64_t ndim = self.dim();
+  const auto options = self.options().dtype(kLong);
+  if (self.numel() == 0) {
+    return std::make_tuple(
+        at::full({size, ndim}, fill_value, options), at::zeros({}, options));
+  }
+
+  Tensor flat_mask = self.ne(0).flatten();
+  Tensor count = flat_mask.sum(kLong);
+  Tensor linear = at::full({size + 1}, -1, options);
+  linear.scatter_(
+      0,
+      StaticCompactionIndex(flat_mask, size),
+      at::arange(flat_mask.numel(), options));
+  linear = linear.narrow(0, 0, size);
+
+  // unravel the row-major linear indices of the kept elements only
+  Tensor out = at::empty({size, ndim}, options);
+  Tensor rest = linear.clone();
+  for (int64_t d = ndim - 1; d >= 0; --d) {
+    out.select(1, d).copy_(rest.remainder(self.size(d)));
+    rest.div_(self.size(d), "floor");
+  }
+  out.masked_fill_(linear.lt(0).unsqueeze(1), fill_value);
+  return std::make_tuple(out, count);
+}
+
+Tensor NonzeroStatic(const Tensor& self, int64_t size, int64_t fill_value) {
+  return std::get<0>(NonzeroStaticWithCount(self, size, fill_value));
+}
+
+Tensor& NonzeroStaticOut(
+    const Tensor& self,
+    int64_t size,
+    int64_t fill_value,
+    Tensor& out) {
+  TORCH_CHECK(
+      out.scalar_type() == kLong,
+      "nonzero_static: Expected out tensor to have scalar type Long but got ",
+      out.scalar_type());
+  Tensor result = NonzeroStatic(self, size, fill_value);
+  at::native::resize_output(out, result.sizes());
+  out.copy_(result);
+  return out;
+}
+
+TORCH_LIBRARY_FRAGMENT(musa, m) {
+  m.def(
+      "nonzero_static(Tensor self, int size, int fill_value=-1) -> (Tensor, Tensor)");
+}
+
+TORCH_LIBRARY_IMPL(musa, PrivateUse1, m) {
+  m.impl("nonzero_static", &NonzeroStaticWithCount);
+}
+
+TORCH_LIBRARY_IMPL(musa, CPU, m) {
+  m.impl("nonzero_static", &NonzeroStaticWithCount);
+}
+
 } // namespace at::musa
@@ -6,6 +6,7 @@
 #include <ATen/native/Pool.h>
 #include <torch/library.h>
 
+#include "torch_musa/csrc/aten/ops/StaticCompaction.h"
 #include "torch_musa/csrc/aten/ops/TensorFactory.h"
 #include "torch_musa/csrc/aten/ops/musa/UniqueCub.muh"
 #include "torch_musa/csrc/aten/utils/Utils.h"
@@ -130,5 +131,75 @@ std::tuple<Tensor, Tensor, Tensor> UniqueConsecutive(
   return UniqueDimConsecutive(self, dim.value(), return_inverse, return_counts);
 }
 
+// Sorted unique of the flattened input with a caller-provided upper bound.
+// Returns the first `size` unique values (missing ones are `fill_value`), the
+// inverse indices, the counts of the returned values and the true number of
+// unique values as a 0-dim device tensor, without synchronizing. Inverse
+// indices of values beyond `size` are >= size.
+std::tuple<Tensor, Tensor, Tensor, Tensor> UniqueStatic(
+    const Tensor& self,
+    int64_t size,
+    bool return_inverse,
+    bool return_counts,
+    const Scalar& fill_value) {
+  TORCH_CHECK(
+      size >= 0,
+      "unique_static: 'size' must be an non-negative integer, but got ",
+      size);
+  const OptionalDeviceGuard device_guard(device_of(self));
+  const auto long_options = self.options().dtype(kLong);
+  const int64_t num_inp = self.numel();
+  Tensor values = at::full({size + 1}, fill_value, self.options());
+  Tensor inverse_indices = return_inverse
+      ? at::empty(self.sizes(), long_options)
+      : at::empty({0}, long_options);
+  Tensor counts = at::zeros({return_counts ? size + 1 : 0}, long_options);
+  if (num_inp == 0) {
+    return std::make_tuple(
+        values.narrow(0, 0, size),
+        inverse_indices,
+        counts.narrow(0, 0, return_counts ? size : 0),
+        at::zeros({}, long_options));
+  }
+
+  Tensor sorted, perm;
+  std::tie(sorted, perm) = self.flatten().sort(
+      /*stable=*/true, /*dim=*/0, /*descending=*/false);
+  Tensor is_first = at::ones({num_inp}, long_options.dtype(kBool));
+  if (num_inp > 1) {
+    at::ne_out(
+        is_first.narrow(0, 1, num_inp - 1),
+        sorted.narrow(0, 1, num_inp - 1),
+        sorted.narrow(0, 0, num_inp - 1));
+  }
+  Tensor group = is_first.cumsum(0, kLong).sub_(1);
+  values.scatter_(0, StaticCompactionIndex(is_first, size), sorted);
+  if (return_inverse) {
+    inverse_indices.view(-1).scatter_(0, perm, group);
+  }
+  if (return_counts) {
+    counts.scatter_add_(0, group.clamp_max(size), at::ones_like(group));
+    counts = counts.narrow(0, 0, size);
+  }
+  return std::make_tuple(
+      values.narrow(0, 0, size),
+      inverse_indices,
+      counts,
+      is_first.sum(kLong));
+}
+
+TORCH_LIBRARY_FRAGMENT(musa, m) {
+  m.def(
+      "unique_static(Tensor self, int size, bool return_inverse=False, bool return_counts=False, Scalar fill_value=0) -> (Tensor, Tensor, Tensor, Tensor)");
+}
+
+TORCH_LIBRARY_IMPL(musa, PrivateUse1, m) {
+  m.impl("unique_static", &UniqueStatic);
+}
+
+TORCH_LIBRARY_IMPL(musa, CPU, m) {
+  m.impl("unique_static", &UniqueStatic);
+}
+
 } // namespace musa
 } // namespace at
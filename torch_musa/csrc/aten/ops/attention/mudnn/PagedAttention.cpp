@@ -0,0 +1,248 @@
+#include <ATen/Config.h>
+#include <torch/library.h>
+
+#ifndef AT_PER_OPERATOR_HEADERS
+#include <ATen/Functions.h>
+#include <ATen/NativeFunctions.h>
+#else
+#include <ATen/ops/empty_like.h>
+#include <ATen/ops/matmul.h>
+#include <ATen/ops/softmax.h>
+#include <ATen/ops/zeros_like.h>
+#endif
+
+#include <cmath>
+
+#include "torch_musa/csrc/aten/ops/attention/mudnn/PagedAttention.h"
+#include "torch_musa/csrc/aten/utils/Utils.h"
+#include "torch_musa/csrc/core/MUSAGuard.h"
+
+namespace at {
+namespace native {
+
+DEFINE_DISPATCH(paged_attention_decode_stub);
+DEFINE_DISPATCH(reshape_and_cache_stub);
+
+REGISTER_NO_CPU_DISPATCH(paged_attention_decode_stub);
+REGISTER_NO_CPU_DISPATCH(reshape_and_cache_stub);
+
+} // namespace native
+
+namespace musa {
+
+namespace {
+
+void CheckKVCache(const Tensor& key_cache, const Tensor& value_cache) {
+  TORCH_CHECK(
+      key_cache.dim() == 4 && key_cache.sizes() == value_cache.sizes(),
+      "key_cache and value_cache must both be [num_blocks, block_size, ",
+      "num_kv_heads, head_dim], but got ",
+      key_cache.sizes(),
+      " and ",
+      value_cache.sizes());
+  TORCH_CHECK(
+      key_cache.is_contiguous() && value_cache.is_contiguous(),
+      "key_cache and value_cache must be contiguous");
+  TORCH_CHECK(
+      key_cache.scalar_type() == value_cache.scalar_type(),
+      "key_cache and value_cache must have the same dtype");
+}
+
+double CheckPagedAttentionDecode(
+    const Tensor& query,
+    const Tensor& key_cache,
+    const Tensor& value_cache,
+    const Tensor& block_tables,
+    const Tensor& context_lens,
+    const c10::optional<double>& scale) {
+  CheckKVCache(key_cache, value_cache);
+  TORCH_CHECK(
+      query.dim() == 3,
+      "paged_attention_decode expects query of shape [batch, num_heads, ",
+      "head_dim], but got ",
+      query.sizes());
+  TORCH_CHECK(
+      query.scalar_type() == key_cache.scalar_type(),
+      "paged_attention_decode: query and the KV cache must have the same ",
+      "dtype, but got ",
+      query.scalar_type(),
+      " and ",
+      key_cache.scalar_type());
+  TORCH_CHECK(
+      key_cache.size(3) == query.size(2),
+      "paged_attention_decode: head_dim of query and the KV cache differ");
+  TORCH_CHECK(
+      key_cache.size(2) > 0 && query.size(1) % key_cache.size(2) == 0,
+      "paged_attention_decode: num_heads (",
+      query.size(1),
+      ") must be a multiple of num_kv_heads (",
+      key_cache.size(2),
+      ")");
+  TORCH_CHECK(
+      block_tables.dim() == 2 && block_tables.size(0) == query.size(0) &&
+          block_tables.scalar_type() == kInt,
+      "paged_attention_decode expects int32 block_tables of shape ",
+      "[batch, max_blocks_per_seq]");
+  TORCH_CHECK(
+      context_lens.dim() == 1 && context_lens.size(0) == query.size(0) &&
+          context_lens.scalar_type() == kInt,
+      "paged_attention_decode expects int32 context_lens of shape [batch]");
+  if (scale.has_value()) {
+    return scale.value();
+  }
+  return 1.0 / std::sqrt(static_cast<double>(query.size(2)));
+}
+
+void CheckReshapeAndCache(
+    const Tensor& key,
+    const Tensor& value,
+    const Tensor& key_cache,
+    const Tensor& value_cache,
+    const Tensor& slot_mapping) {
+  CheckKVCache(key_cache, value_cache);
+  TORCH_CHECK(
+      key.dim() == 3 && key.sizes() == value.sizes() &&
+          key.size(1) == key_cache.size(2) && key.size(2) == key_cache.size(3),
+      "reshape_and_cache expects key and value of shape [num_tokens, ",
+      "num_kv_heads, head_dim] matching the KV cache, but got ",
+      key.sizes(),
+      " and ",
+      value.sizes());
+  TORCH_CHECK(
+      key.scalar_type() == key_cache.scalar_type() &&
+          value.scalar_type() == key_cache.scalar_type(),
+      "reshape_and_cache: key, value and the KV cache must have the same ",
+      "dtype");
+  TORCH_CHECK(
+      slot_mapping.dim() == 1 && slot_mapping.size(0) == key.size(0),
+      "reshape_and_cache expects one slot per token, but got slot_mapping ",
+      "of shape ",
+      slot_mapping.sizes());
+}
+
+} // anonymous namespace
+
+Tensor PagedAttentionDecodeCPU(
+    const Tensor& query,
+    const Tensor& key_cache,
+    const Tensor& value_cache,
+    const Tensor& block_tables,
+    const Tensor& context_lens,
+    int64_t max_context_len,
+    c10::optional<double> scale) {
+  const double softmax_scale = CheckPagedAttentionDecode(
+      query, key_cache, value_cache, block_tables, context_lens, scale);
+  const int64_t block_size = key_cache.size(1);
+  const int64_t groups = query.size(1) / key_cache.size(2);
+  Tensor out = at::zeros_like(query);
+  const Tensor tables = block_tables.to(kLong);
+  for (int64_t b = 0; b < query.size(0); ++b) {
+    const int64_t context_len = context_lens[b].item<int>();
+    TORCH_CHECK(
+        context_len >= 0 && context_len <= max_context_len,
+        "paged_attention_decode: context length ",
+        context_len,
+        " of sequence ",
+        b,
+        " is out of [0, max_context_len]");
+    if (context_len == 0) {
+      continue;
+    }
+    const int64_t num_blocks = (context_len + block_size - 1) / block_size;
+    const Tensor blocks = tables[b].narrow(0, 0, num_blocks);
+    // [H, context_len, D]
+    auto gather = [&](const Tensor& cache) {
+      return cache.index_select(0, blocks)
+          .flatten(0, 1)
+          .narrow(0, 0, context_len)
+          .to(kFloat)
+          .repeat_interleave(groups, 1)
+          .transpose(0, 1);
+    };
+    const Tensor q = query[b].to(kFloat).unsqueeze(1);
+    const Tensor scores =
+        at::matmul(q, gather(key_cache).transpose(1, 2)) * softmax_scale;
+    const Tensor probs = at::softmax(scores, -1);
+    out[b].copy_(at::matmul(probs, gather(value_cache)).squeeze(1));
+  }
+  return out;
+}
+
+Tensor PagedAttentionDecode(
+    const Tensor& query,
+    const Tensor& key_cache,
+    const Tensor& value_cache,
+    const Tensor& block_tables,
+    const Tensor& context_lens,
+    int64_t max_context_len,
+    c10::optional<double> scale) {
+  const double softmax_scale = CheckPagedAttentionDecode(
+      query, key_cache, value_cache, block_tables, context_lens, scale);
+  c10::musa::MUSAGuard device_guard(query.device());
+  const Tensor contiguous_query = query.contiguous();
+  Tensor out = at::empty_like(contiguous_query);
+  at::native::paged_attention_decode_stub(
+      kMUSA,
+      out,
+      contiguous_query,
+      key_cache,
+      value_cache,
+      block_tables.contiguous(),
+      context_lens.contiguous(),
+      max_context_len,
+      softmax_scale);
+  return out;
+}
+
+void ReshapeAndCacheCPU(
+    const Tensor& key,
+    const Tensor& value,
+    Tensor& key_cache,
+    Tensor& value_cache,
+    const Tensor& slot_mapping) {
+  CheckReshapeAndCache(key, value, key_cache, value_cache, slot_mapping);
+  const Tensor slots = slot_mapping.to(kLong);
+  const Tensor tokens = (slots >= 0).nonzero().squeeze(1);
+  const Tensor valid_slots = slots.index_select(0, tokens);
+  key_cache.view({-1, key.size(1), key.size(2)})
+      .index_copy_(0, valid_slots, key.index_select(0, tokens));
+  value_cache.view({-1, value.size(1), value.size(2)})
+      .index_copy_(0, valid_slots, value.index_select(0, tokens));
+}
+
+void ReshapeAndCache(
+    const Tensor& key,
+    const Tensor& value,
+    Tensor& key_cache,
+    Tensor& value_cache,
+    const Tensor& slot_mapping) {
+  CheckReshapeAndCache(key, value, key_cache, value_cache, slot_mapping);
+  c10::musa::MUSAGuard device_guard(key.device());
+  at::native::reshape_and_cache_stub(
+      kMUSA,
+      key_cache,
+      value_cache,
+      key.contiguous(),
+      value.contiguous(),
+      slot_mapping.to(kLong).contiguous());
+}
+
+TORCH_LIBRARY_FRAGMENT(musa, m) {
+  m.def(
+      "paged_attention_decode(Tensor query, Tensor key_cache, Tensor value_cache, Tensor block_tables, Tensor context_lens, int max_context_len, *, float? scale=None) -> Tensor");
+  m.def(
+      "reshape_and_cache(Tensor key, Tensor value, Tensor(a!) key_cache, Tensor(b!) value_cache, Tensor slot_mapping) -> ()");
+}
+
+TORCH_LIBRARY_IMPL(musa, PrivateUse1, m) {
+  m.impl("paged_attention_decode", &PagedAttentionDecode);
+  m.impl("reshape_and_cache", &ReshapeAndCache);
+}
+
+TORCH_LIBRARY_IMPL(musa, CPU, m) {
+  m.impl("paged_attention_decode", &PagedAttentionDecodeCPU);
+  m.impl("reshape_and_cache", &ReshapeAndCacheCPU);
+}
+
+} // namespace musa
+} // namespace at
@@ -0,0 +1,37 @@
+#ifndef TORCH_MUSA_CSRC_ATEN_OPS_ATTENTION_MUDNN_PAGEDATTENTION_H_
+#define TORCH_MUSA_CSRC_ATEN_OPS_ATTENTION_MUDNN_PAGEDATTENTION_H_
+
+#include <ATen/core/Tensor.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at {
+namespace native {
+
+// A paged KV cache holds [num_blocks, block_size, num_kv_heads, head_dim]
+// keys and values. Token t of sequence b lives in block
+// block_tables[b][t / block_size] at offset t % block_size, and a slot is
+// the flat index block * block_size + offset.
+
+// (out [B, H, D], query [B, H, D], key_cache, value_cache, block_tables int32
+// [B, max_blocks], context_lens int32 [B], max_context_len, scale)
+using paged_attention_decode_fn = void (*)(
+    Tensor&,
+    const Tensor&,
+    const Tensor&,
+    const Tensor&,
+    const Tensor&,
+    const Tensor&,
+    int64_t,
+    double);
+// (key_cache, value_cache, key [T, num_kv_heads, D], value, slot_mapping
+// int64 [T]), tokens with a negative slot are skipped
+using reshape_and_cache_fn =
+    void (*)(Tensor&, Tensor&, const Tensor&, const Tensor&, const Tensor&);
+
+DECLARE_DISPATCH(paged_attention_decode_fn, paged_attention_decode_stub);
+DECLARE_DISPATCH(reshape_and_cache_fn, reshape_and_cache_stub);
+
+} // namespace native
+} // namespace at
+
+#endif // TORCH_MUSA_CSRC_ATEN_OPS_ATTENTION_MUDNN_PAGEDATTENTION_H_
@@ -12,6 +12,7 @@
 
 #include <mudnn.h>
 
+#include "torch_musa/csrc/aten/mudnn/OpCache.h"
 #include "torch_musa/csrc/aten/ops/TensorFactory.h"
 #include "torch_musa/csrc/aten/ops/attention/mudnn/SDPUtils.h"
 #include "torch_musa/csrc/aten/utils/Context.h"
@@ -112,18 +113,40 @@ std::tuple<at::Tensor, at::Tensor, at::Tensor> MuDNNMathSDPAFwd(
   auto musa_atten_probs = at::musa::CreateMUTensor(atten_probs);
 
   musa::muHandle& h = at::GetMudnnHandle();
-  ::musa::dnn::ScaledDotProductAttention sdpa;
+  const auto compute_mode =
+      at::musa::GetComputeModeFromCtx(query.scalar_type());
+  // 0: no mask, 1: full mask, 2: padding mask
+  const int64_t mask_kind = mask.has_value()
+      ? (is_pad_mask(mask.value(), query) ? 2 : 1)
+      : 0;
 
   // Config Mudnn
-  CHECK_MUDNN_STATUS(
-      sdpa.SetComputeMode(at::musa::GetComputeModeFromCtx(query.scalar_type())),
-      "SetComputeMode");
-  CHECK_MUDNN_STATUS(sdpa.SetEmbedDim(head_dim * head_num), "SetEmbedDim");
-  CHECK_MUDNN_STATUS(sdpa.SetHeadsNum(head_num), "SetHeadsNum");
-  if (mask.has_value()) {
-    CHECK_MUDNN_STATUS(
-        sdpa.SetMaskMode(is_pad_mask(mask.value(), query)), "SetMaskMode");
+  auto configure = [&](::musa::dnn::ScaledDotProductAttention& op) {
+    CHECK_MUDNN_STATUS(op.SetComputeMode(compute_mode), "SetComputeMode");
+    CHECK_MUDNN_STATUS(op.SetEmbedDim(head_dim * head_num), "SetEmbedDim");
+    CHECK_MUDNN_STATUS(op.SetHeadsNum(head_num), "SetHeadsNum");
+    if (mask_kind != 0) {
+      CHECK_MUDNN_STATUS(op.SetMaskMode(mask_kind == 2), "SetMaskMode");
+    }
+    if (dropout_p > 0.0) {
+      op.SetDropoutP(dropout_p);
+      op.SetTraining(true);
+    }
+  };
+  ::musa::dnn::ScaledDotProductAttention scratch;
+  ::musa::dnn::ScaledDotProductAttention* sdpa_ptr = &scratch;
+  if (dropout_p > 0.0) {
+    // training descriptors own dropout state, never share them across calls
+    configure(scratch);
+  } else {
+    MudnnOpKey op_key(MudnnOpKind::SDPA);
+    op_key.Add(static_cast<int64_t>(compute_mode))
+        .Add(head_dim * head_num)
+        .Add(head_num)
+        .Add(mask_kind);
+    sdpa_ptr = &CachedMudnnOp(op_key, scratch, configure);
   }
+  auto& sdpa = *sdpa_ptr;
 
   // store dropout mask, bool data type
   auto dropout_mask =
@@ -133,9 +156,6 @@ std::tuple<at::Tensor, at::Tensor, at::Tensor> MuDNNMathSDPAFwd(
         {batch_size, head_num, q_seq_len, kv_seq_len},
         query.options().dtype(at::kBool),
         at::MemoryFormat::Contiguous);
-
-    sdpa.SetDropoutP(dropout_p);
-    sdpa.SetTraining(true);
   }
 
   auto musa_dropout_mask = at::musa::CreateMUTensor(dropout_mask);
@@ -0,0 +1,678 @@
+#include <ATen/CPUGeneratorImpl.h>
+#include <ATen/Config.h>
+#include <ATen/DeviceGuard.h>
+#include <ATen/core/DistributionsHelper.h>
+#include <ATen/core/dispatch/Dispatcher.h>
+#include <torch/csrc/autograd/custom_function.h>
+#include <torch/library.h>
+
+#ifndef AT_PER_OPERATOR_HEADERS
+#include <ATen/Functions.h>
+#include <ATen/NativeFunctions.h>
+#else
+#include <ATen/ops/arange.h>
+#include <ATen/ops/empty.h>
+#include <ATen/ops/empty_like.h>
+#include <ATen/ops/full.h>
+#include <ATen/ops/matmul.h>
+#include <ATen/ops/maximum.h>
+#include <ATen/ops/scalar_tensor.h>
+#include <ATen/ops/zeros.h>
+#include <ATen/ops/zeros_like.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "torch_musa/csrc/aten/musa/MUSAGeneratorImpl.h"
+#include "torch_musa/csrc/aten/ops/attention/mudnn/SDPMemEfficient.h"
+#include "torch_musa/csrc/aten/utils/Utils.h"
+
+namespace at {
+namespace musa {
+
+SDPTilePlan::SDPTilePlan(
+    int64_t batch_heads,
+    int64_t q_len,
+    int64_t kv_len,
+    int64_t max_tile_bytes)
+    : batch_heads(batch_heads),
+      q_len(q_len),
+      kv_len(kv_len),
+      q_tile(std::max<int64_t>(std::min(q_len, kMaxTile), 1)),
+      kv_tile(std::max<int64_t>(std::min(kv_len, kMaxTile), 1)) {
+  TORCH_CHECK(
+      max_tile_bytes > 0,
+      "memory-efficient attention: max_tile_bytes must be positive, but got ",
+      max_tile_bytes);
+  const int64_t bytes_per_score =
+      std::max<int64_t>(batch_heads, 1) * kLiveTiles * sizeof(float);
+  // halve the longer side first, keeping tiles close to square
+  while (q_tile * kv_tile * bytes_per_score > max_tile_bytes &&
+         (q_tile > 1 || kv_tile > 1)) {
+    if (q_tile >= kv_tile) {
+      q_tile = (q_tile + 1) / 2;
+    } else {
+      kv_tile = (kv_tile + 1) / 2;
+    }
+  }
+}
+
+int64_t SDPTilePlan::num_q_tiles() const {
+  return (q_len + q_tile - 1) / q_tile;
+}
+
+int64_t SDPTilePlan::num_kv_tiles() const {
+  return (kv_len + kv_tile - 1) / kv_tile;
+}
+
+int64_t SDPTilePlan::q_begin(int64_t qi) const {
+  return qi * q_tile;
+}
+
+int64_t SDPTilePlan::q_size(int64_t qi) const {
+  return std::min(q_tile, q_len - q_begin(qi));
+}
+
+int64_t SDPTilePlan::kv_begin(int64_t ki) const {
+  return ki * kv_tile;
+}
+
+int64_t SDPTilePlan::kv_size(int64_t ki) const {
+  return std::min(kv_tile, kv_len - kv_begin(ki));
+}
+
+int64_t SDPTilePlan::kv_tile_end(int64_t qi, bool is_causal) const {
+  if (!is_causal) {
+    return num_kv_tiles();
+  }
+  // the last query of the tile sees keys [0, q_end)
+  const int64_t q_end = std::min(q_begin(qi) + q_size(qi), kv_len);
+  return (q_end + kv_tile - 1) / kv_tile;
+}
+
+uint64_t SDPTilePlan::philox_offset(int64_t qi, int64_t ki) const {
+  // every tile draws at most one value per score, rounded up to the multiple
+  // of 4 the MUSA generator keeps its offsets at
+  const uint64_t stride =
+      (static_cast<uint64_t>(batch_heads * q_tile * kv_tile) + 3) / 4 * 4;
+  return static_cast<uint64_t>(qi * num_kv_tiles() + ki) * stride;
+}
+
+uint64_t SDPTilePlan::philox_increment() const {
+  return philox_offset(num_q_tiles(), 0);
+}
+
+namespace {
+
+struct MemEfficientInputs {
+  // key and value with their heads repeated up to the query heads
+  Tensor key;
+  Tensor value;
+  // attn_mask broadcast to [B, H, Sq, Skv] as a view, or undefined
+  Tensor mask;
+  double scale;
+  int64_t kv_groups;
+};
+
+MemEfficientInputs PrepareInputs(
+    const Tensor& query,
+    const Tensor& key,
+    const Tensor& value,
+    const c10::optional<Tensor>& attn_mask,
+    double dropout_p,
+    c10::optional<double> scale) {
+  TORCH_CHECK(
+      query.dim() == 4 && key.dim() == 4 && value.dim() == 4,
+      "memory-efficient attention expects 4-D query, key and value of shape ",
+      "[batch, num_heads, seq_len, head_dim], but got ",
+      query.sizes(),
+      ", ",
+      key.sizes(),
+      " and ",
+      value.sizes());
+  TORCH_CHECK(
+      key.size(0) == query.size(0) && value.size(0) == query.size(0) &&
+          key.size(1) == value.size(1) && key.size(2) == value.size(2) &&
+          key.size(3) == query.size(3),
+      "memory-efficient attention: mismatched query, key and value shapes ",
+      query.sizes(),
+      ", ",
+      key.sizes(),
+      " and ",
+      value.sizes());
+  TORCH_CHECK(
+      key.size(1) > 0 && query.size(1) % key.size(1) == 0,
+      "memory-efficient attention: num_heads (",
+      query.size(1),
+      ") must be a multiple of num_kv_heads (",
+      key.size(1),
+      ")");
+  TORCH_CHECK(
+      query.scalar_type() == key.scalar_type() &&
+          query.scalar_type() == value.scalar_type(),
+      "memory-efficient attention: query, key and value must have the same ",
+      "dtype");
+  TORCH_CHECK(
+      dropout_p >= 0.0 && dropout_p < 1.0,
+      "memory-efficient attention: dropout_p must be in [0, 1), but got ",
+      dropout_p);
+
+  MemEfficientInputs in;
+  in.kv_groups = query.size(1) / key.size(1);
+  auto repeat_heads = [&](const Tensor& t) {
+    if (in.kv_groups == 1) {
+      return t;
+    }
+    return t.unsqueeze(2)
+        .expand({t.size(0), t.size(1), in.kv_groups, t.size(2), t.size(3)})
+        .reshape({t.size(0), query.size(1), t.size(2), t.size(3)});
+  };
+  in.key = repeat_heads(key);
+  in.value = repeat_heads(value);
+
+  const std::vector<int64_t> scores_shape{
+      query.size(0), query.size(1), query.size(2), key.size(2)};
+  if (attn_mask.has_value() && attn_mask->defined()) {
+    Tensor mask = *attn_mask;
+    // [B, Skv] key padding mask, as accepted by the math kernel
+    if (mask.dim() == 2 && mask.size(0) == query.size(0) &&
+        mask.size(1) == key.size(2)) {
+      mask = mask.view({mask.size(0), 1, 1, mask.size(1)});
+    }
+    in.mask = mask.expand(scores_shape);
+  }
+  in.scale = scale.has_value()
+      ? scale.value()
+      : 1.0 / std::sqrt(static_cast<double>(query.size(3)));
+  return in;
+}
+
+SDPTilePlan MakePlan(
+    const Tensor& query,
+    const Tensor& key,
+    c10::optional<int64_t> max_tile_bytes) {
+  return SDPTilePlan(
+      query.size(0) * query.size(1),
+      query.size(2),
+      key.size(2),
+      max_tile_bytes.value_or(kMemEfficientTileBytes));
+}
+
+// Float scores of tile (qi, ki), scaled and masked. Masked-out scores are
+// -inf, a bool mask keeps the positions that are true.
+Tensor TileScores(
+    const SDPTilePlan& plan,
+    const Tensor& q_tile,
+    const Tensor& key,
+    const Tensor& mask,
+    double scale,
+    bool is_causal,
+    int64_t qi,
+    int64_t ki) {
+  const int64_t q0 = plan.q_begin(qi);
+  const int64_t tq = plan.q_size(qi);
+  const int64_t k0 = plan.kv_begin(ki);
+  const int64_t tk = plan.kv_size(ki);
+  Tensor scores =
+      at::matmul(q_tile, key.narrow(2, k0, tk).transpose(-2, -1)).to(kFloat);
+  scores.mul_(scale);
+  if (mask.defined()) {
+    const Tensor mask_tile = mask.narrow(2, q0, tq).narrow(3, k0, tk);
+    if (mask_tile.scalar_type() == kBool) {
+      scores.masked_fill_(
+          mask_tile.logical_not(), -std::numeric_limits<float>::infinity());
+    } else {
+      scores.add_(mask_tile);
+    }
+  }
+  // tiles entirely on or below the diagonal need no causal mask
+  if (is_causal && k0 + tk - 1 > q0) {
+    const auto index_options = scores.options().dtype(kLong);
+    const Tensor rows = at::arange(q0, q0 + tq, index_options).unsqueeze(1);
+    const Tensor cols = at::arange(k0, k0 + tk, index_options).unsqueeze(0);
+    scores.masked_fill_(cols > rows, -std::numeric_limits<float>::infinity());
+  }
+  return scores;
+}
+
+// Reserves the random numbers of a call. The seed and the base offset are
+// returned, the tiles then draw from disjoint offsets past the base.
+std::pair<uint64_t, uint64_t> ReservePhilox(
+    const Device& device,
+    uint64_t increment) {
+  if (device.is_cpu()) {
+    auto* gen = get_generator_or_default<CPUGeneratorImpl>(
+        c10::nullopt, at::detail::getDefaultCPUGenerator());
+    std::lock_guard<std::mutex> lock(gen->mutex_);
+    return {gen->random64(), 0};
+  }
+  auto* gen = get_generator_or_default<MUSAGeneratorImpl>(
+      c10::nullopt, detail::getDefaultMUSAGenerator(device.index()));
+  PhiloxMusaState state;
+  {
+    std::lock_guard<std::mutex> lock(gen->mutex_);
+    state = gen->philox_musa_state(increment);
+  }
+  // the backward reads the seed and offset on the host
+  TORCH_CHECK(
+      !state.captured_,
+      "memory-efficient attention with dropout cannot be captured into a ",
+      "MUSA graph");
+  return {state.seed_.val, state.offset_.val};
+}
+
+// Keep mask of tile (qi, ki). It only depends on the seed, the offset and
+// the tile, so the backward redraws exactly what the forward used.
+Tensor TileKeepMask(
+    const SDPTilePlan& plan,
+    const Tensor& scores,
+    double dropout_p,
+    uint64_t seed,
+    uint64_t offset,
+    int64_t qi,
+    int64_t ki) {
+  const uint64_t tile_offset = offset + plan.philox_offset(qi, ki);
+#if TORCH_MUSA_ARCH >= 210
+  if (!scores.is_cpu()) {
+    Generator gen = detail::createMUSAGenerator(scores.device().index());
+    auto* impl = gen.get<MUSAGeneratorImpl>();
+    impl->set_current_seed(seed);
+    impl->set_philox_offset_per_thread(tile_offset);
+    return at::empty_like(scores).bernoulli_(1.0 - dropout_p, gen);
+  }
+#endif
+  // Older archs draw bernoulli_ of MUSA tensors on the host, which takes no
+  // MUSA generator, so their masks come from a host generator as well.
+  Generator gen = at::detail::createCPUGenerator(
+      seed ^ (tile_offset * 0x9E3779B97F4A7C15ULL));
+  return at::empty(scores.sizes(), scores.options().device(kCPU))
+      .bernoulli_(1.0 - dropout_p, gen)
+      .to(scores.device());
+}
+
+uint64_t ToPhilox(const Tensor& t) {
+  return static_cast<uint64_t>(t.item<int64_t>());
+}
+
+Tensor ToPhiloxTensor(uint64_t value) {
+  return at::scalar_tensor(static_cast<int64_t>(value), at::kLong);
+}
+
+// Sums the gradient of repeated key or value heads back onto num_kv_heads.
+Tensor FoldHeads(const Tensor& grad, int64_t groups) {
+  if (groups == 1) {
+    return grad;
+  }
+  return grad
+      .view(
+          {grad.size(0),
+           grad.size(1) / groups,
+           groups,
+           grad.size(2),
+           grad.size(3)})
+      .sum(2);
+}
+
+} // anonymous namespace
+
+std::tuple<Tensor, Tensor, Tensor, Tensor> MemEfficientSDPAFwd(
+    const Tensor& query,
+    const Tensor& key,
+    const Tensor& value,
+    const c10::optional<Tensor>& attn_mask,
+    double dropout_p,
+    bool is_causal,
+    c10::optional<double> scale,
+    c10::optional<int64_t> max_tile_bytes) {
+  const MemEfficientInputs in =
+      PrepareInputs(query, key, value, attn_mask, dropout_p, scale);
+  const c10::OptionalDeviceGuard device_guard(device_of(query));
+  const SDPTilePlan plan = MakePlan(query, key, max_tile_bytes);
+  constexpr float kInf = std::numeric_limits<float>::infinity();
+
+  uint64_t seed = 0;
+  uint64_t offset = 0;
+  if (dropout_p > 0.0) {
+    std::tie(seed, offset) =
+        ReservePhilox(query.device(), plan.philox_increment());
+  }
+  const double keep_scale = 1.0 / (1.0 - dropout_p);
+
+  const auto float_options = query.options().dtype(kFloat);
+  Tensor out = at::empty(
+      {query.size(0), query.size(1), query.size(2), value.size(3)},
+      query.options());
+  Tensor logsumexp = at::empty(
+      {query.size(0), query.size(1), query.size(2)}, float_options);
+
+  for (int64_t qi = 0; qi < plan.num_q_tiles(); ++qi) {
+    const int64_t q0 = plan.q_begin(qi);
+    const int64_t tq = plan.q_size(qi);
+    const Tensor q_tile = query.narrow(2, q0, tq);
+    // running row max, softmax normalizer and unnormalized output
+    Tensor row_max =
+        at::full({query.size(0), query.size(1), tq, 1}, -kInf, float_options);
+    Tensor row_sum = at::zeros_like(row_max);
+    Tensor acc = at::zeros(
+        {query.size(0), query.size(1), tq, value.size(3)}, float_options);
+    Tensor shift = at::zeros_like(row_max);
+
+    for (int64_t ki = 0; ki < plan.kv_tile_end(qi, is_causal); ++ki) {
+      Tensor scores = TileScores(
+          plan, q_tile, in.key, in.mask, in.scale, is_causal, qi, ki);
+      const Tensor new_max = at::maximum(row_max, scores.amax(-1, true));
+      // rows without a visible key so far keep -inf, shift them by 0
+      const Tensor new_shift = new_max.masked_fill(new_max == -kInf, 0);
+      Tensor probs = scores.sub_(new_shift).exp_();
+      const Tensor correction = (row_max - new_shift).exp_();
+      row_sum.mul_(correction).add_(probs.sum(-1, true));
+      if (dropout_p > 0.0) {
+        probs.mul_(TileKeepMask(plan, probs, dropout_p, seed, offset, qi, ki))
+            .mul_(keep_scale);
+      }
+      const Tensor v_tile =
+          in.value.narrow(2, plan.kv_begin(ki), plan.kv_size(ki));
+      acc.mul_(correction).add_(
+          at::matmul(probs.to(value.scalar_type()), v_tile).to(kFloat));
+      row_max = new_max;
+      shift = new_shift;
+    }
+    // fully masked rows come out as nan, like the math backend
+    out.narrow(2, q0, tq).copy_(acc.div_(row_sum));
+    logsumexp.narrow(2, q0, tq).copy_(shift.add_(row_sum.log()).squeeze(-1));
+  }
+  return std::make_tuple(
+      out, logsumexp, ToPhiloxTensor(seed), ToPhiloxTensor(offset));
+}
+
+std::tuple<Tensor, Tensor, Tensor> MemEfficientSDPABwd(
+    const Tensor& grad_out,
+    const Tensor& query,
+    const Tensor& key,
+    const Tensor& value,
+    const Tensor& output,
+    const Tensor& logsumexp,
+    const Tensor& philox_seed,
+    const Tensor& philox_offset,
+    const c10::optional<Tensor>& attn_mask,
+    double dropout_p,
+    bool is_causal,
+    c10::optional<double> scale,
+    c10::optional<int64_t> max_tile_bytes) {
+  const MemEfficientInputs in =
+      PrepareInputs(query, key, value, attn_mask, dropout_p, scale);
+  const c10::OptionalDeviceGuard device_guard(device_of(query));
+  const SDPTilePlan plan = MakePlan(query, key, max_tile_bytes);
+  constexpr float kInf = std::numeric_limits<float>::infinity();
+  const uint64_t seed = ToPhilox(philox_seed);
+  const uint64_t offset = ToPhilox(philox_offset);
+  const double keep_scale = 1.0 / (1.0 - dropout_p);
+  const ScalarType dtype = query.scalar_type();
+
+  // rowsum(dO * O) = rowsum(dP * P), the softmax backward term
+  const Tensor delta =
+      (grad_out.to(kFloat) * output.to(kFloat)).sum(-1, true);
+  // rows that saw no key have lse -inf, +inf makes their probabilities 0
+  const Tensor lse_rows = logsumexp.unsqueeze(-1);
+  const Tensor lse = lse_rows.masked_fill(lse_rows == -kInf, kInf);
+  const auto float_options = query.options().dtype(kFloat);
+  Tensor grad_q = at::zeros(query.sizes(), float_options);
+  Tensor grad_k = at::zeros(in.key.sizes(), float_options);
+  Tensor grad_v = at::zeros(in.value.sizes(), float_options);
+
+  for (int64_t qi = 0; qi < plan.num_q_tiles(); ++qi) {
+    const int64_t q0 = plan.q_begin(qi);
+    const int64_t tq = plan.q_size(qi);
+    const Tensor q_tile = query.narrow(2, q0, tq);
+    const Tensor grad_out_tile = grad_out.narrow(2, q0, tq).to(dtype);
+    const Tensor lse_tile = lse.narrow(2, q0, tq);
+    const Tensor delta_tile = delta.narrow(2, q0, tq);
+    Tensor grad_q_tile = grad_q.narrow(2, q0, tq);
+
+    for (int64_t ki = 0; ki < plan.kv_tile_end(qi, is_causal); ++ki) {
+      const int64_t k0 = plan.kv_begin(ki);
+      const int64_t tk = plan.kv_size(ki);
+      const Tensor k_tile = in.key.narrow(2, k0, tk);
+      const Tensor v_tile = in.value.narrow(2, k0, tk);
+      Tensor probs = TileScores(
+                         plan,
+                         q_tile,
+                         in.key,
+                         in.mask,
+                         in.scale,
+                         is_causal,
+                         qi,
+                         ki)
+                         .sub_(lse_tile)
+                         .exp_();
+      Tensor grad_probs =
+          at::matmul(grad_out_tile, v_tile.transpose(-2, -1)).to(kFloat);
+      Tensor dropped = probs;
+      if (dropout_p > 0.0) {
+        const Tensor keep =
+            TileKeepMask(plan, probs, dropout_p, seed, offset, qi, ki)
+                .mul_(keep_scale);
+        dropped = probs * keep;
+        grad_probs.mul_(keep);
+      }
+      grad_v.narrow(2, k0, tk).add_(
+          at::matmul(dropped.to(dtype).transpose(-2, -1), grad_out_tile)
+              .to(kFloat));
+      // dS = P * (dP - delta), scaled for the gradient through q k^T
+      const Tensor grad_scores =
+          probs.mul_(grad_probs.sub_(delta_tile)).mul_(in.scale).to(dtype);
+      grad_q_tile.add_(at::matmul(grad_scores, k_tile).to(kFloat));
+      grad_k.narrow(2, k0, tk).add_(
+          at::matmul(grad_scores.transpose(-2, -1), q_tile).to(kFloat));
+    }
+  }
+  return std::make_tuple(
+      grad_q.to(dtype),
+      FoldHeads(grad_k, in.kv_groups).to(dtype),
+      FoldHeads(grad_v, in.kv_groups).to(dtype));
+}
+
+namespace {
+
+std::tuple<Tensor, Tensor, Tensor, Tensor> CallMemEfficientFwd(
+    const Tensor& query,
+    const Tensor& key,
+    const Tensor& value,
+    const c10::optional<Tensor>& attn_mask,
+    double dropout_p,
+    bool is_causal,
+    c10::optional<double> scale,
+    c10::optional<int64_t> max_tile_bytes) {
+  static auto op =
+      c10::Dispatcher::singleton()
+          .findSchemaOrThrow("musa::_mem_efficient_attention_forward", "")
+          .typed<decltype(MemEfficientSDPAFwd)>();
+  return op.call(
+      query,
+      key,
+      value,
+      attn_mask,
+      dropout_p,
+      is_causal,
+      scale,
+      max_tile_bytes);
+}
+
+std::tuple<Tensor, Tensor, Tensor> CallMemEfficientBwd(
+    const Tensor& grad_out,
+    const Tensor& query,
+    const Tensor& key,
+    const Tensor& value,
+    const Tensor& output,
+    const Tensor& logsumexp,
+    const Tensor& philox_seed,
+    const Tensor& philox_offset,
+    const c10::optional<Tensor>& attn_mask,
+    double dropout_p,
+    bool is_causal,
+    c10::optional<double> scale,
+    c10::optional<int64_t> max_tile_bytes) {
+  static auto op =
+      c10::Dispatcher::singleton()
+          .findSchemaOrThrow("musa::_mem_efficient_attention_backward", "")
+          .typed<decltype(MemEfficientSDPABwd)>();
+  return op.call(
+      grad_out,
+      query,
+      key,
+      value,
+      output,
+      logsumexp,
+      philox_seed,
+      philox_offset,
+      attn_mask,
+      dropout_p,
+      is_causal,
+      scale,
+      max_tile_bytes);
+}
+
+// Saves the inputs, the output and the per-row logsumexp, [B, H, Sq] floats
+// instead of the [B, H, Sq, Skv] probabilities and dropout mask.
+class MemEfficientAttentionFunction
+    : public torch::autograd::Function<MemEfficientAttentionFunction> {
+ public:
+  static Tensor forward(
+      torch::autograd::AutogradContext* ctx,
+      const Tensor& query,
+      const Tensor& key,
+      const Tensor& value,
+      const c10::optional<Tensor>& attn_mask,
+      double dropout_p,
+      bool is_causal,
+      c10::optional<double> scale,
+      c10::optional<int64_t> max_tile_bytes) {
+    at::AutoDispatchBelowADInplaceOrView guard;
+    Tensor out, logsumexp, philox_seed, philox_offset;
+    std::tie(out, logsumexp, philox_seed, philox_offset) = CallMemEfficientFwd(
+        query,
+        key,
+        value,
+        attn_mask,
+        dropout_p,
+        is_causal,
+        scale,
+        max_tile_bytes);
+    ctx->save_for_backward(
+        {query,
+         key,
+         value,
+         out,
+         logsumexp,
+         philox_seed,
+         philox_offset,
+         attn_mask.value_or(Tensor())});
+    ctx->saved_data["dropout_p"] = dropout_p;
+    ctx->saved_data["is_causal"] = is_causal;
+    ctx->saved_data["scale"] = scale;
+    ctx->saved_data["max_tile_bytes"] = max_tile_bytes;
+    return out;
+  }
+
+  static torch::autograd::variable_list backward(
+      torch::autograd::AutogradContext* ctx,
+      torch::autograd::variable_list grad_outputs) {
+    const auto saved = ctx->get_saved_variables();
+    c10::optional<Tensor> attn_mask;
+    if (saved[7].defined()) {
+      attn_mask = saved[7];
+    }
+    Tensor grad_q, grad_k, grad_v;
+    std::tie(grad_q, grad_k, grad_v) = CallMemEfficientBwd(
+        grad_outputs[0].contiguous(),
+        saved[0],
+        saved[1],
+        saved[2],
+        saved[3],
+        saved[4],
+        saved[5],
+        saved[6],
+        attn_mask,
+        ctx->saved_data["dropout_p"].toDouble(),
+        ctx->saved_data["is_causal"].toBool(),
+        ctx->saved_data["scale"].toOptional<double>(),
+        ctx->saved_data["max_tile_bytes"].toOptional<int64_t>());
+    return {
+        grad_q,
+        grad_k,
+        grad_v,
+        Tensor(),
+        Tensor(),
+        Tensor(),
+        Tensor(),
+        Tensor()};
+  }
+};
+
+} // anonymous namespace
+
+Tensor MemEfficientAttention(
+    const Tensor& query,
+    const Tensor& key,
+    const Tensor& value,
+    const c10::optional<Tensor>& attn_mask,
+    double dropout_p,
+    bool is_causal,
+    c10::optional<double> scale,
+    c10::optional<int64_t> max_tile_bytes) {
+  return std::get<0>(CallMemEfficientFwd(
+      query,
+      key,
+      value,
+      attn_mask,
+      dropout_p,
+      is_causal,
+      scale,
+      max_tile_bytes));
+}
+
+Tensor MemEfficientAttentionAutograd(
+    const Tensor& query,
+    const Tensor& key,
+    const Tensor& value,
+    const c10::optional<Tensor>& attn_mask,
+    double dropout_p,
+    bool is_causal,
+    c10::optional<double> scale,
+    c10::optional<int64_t> max_tile_bytes) {
+  return MemEfficientAttentionFunction::apply(
+      query,
+      key,
+      value,
+      attn_mask,
+      dropout_p,
+      is_causal,
+      scale,
+      max_tile_bytes);
+}
+
+TORCH_LIBRARY_FRAGMENT(musa, m) {
+  m.def(
+      "mem_efficient_attention(Tensor query, Tensor key, Tensor value, Tensor? attn_mask=None, float dropout_p=0.0, bool is_causal=False, *, float? scale=None, int? max_tile_bytes=None) -> Tensor");
+  m.def(
+      "_mem_efficient_attention_forward(Tensor query, Tensor key, Tensor value, Tensor? attn_mask, float dropout_p, bool is_causal, float? scale, int? max_tile_bytes) -> (Tensor output, Tensor logsumexp, Tensor philox_seed, Tensor philox_offset)");
+  m.def(
+      "_mem_efficient_attention_backward(Tensor grad_out, Tensor query, Tensor key, Tensor value, Tensor output, Tensor logsumexp, Tensor philox_seed, Tensor philox_offset, Tensor? attn_mask, float dropout_p, bool is_causal, float? scale, int? max_tile_bytes) -> (Tensor, Tensor, Tensor)");
+}
+
+// The tiles are plain ATen ops, so one implementation serves MUSA and CPU.
+TORCH_LIBRARY_IMPL(musa, CompositeExplicitAutograd, m) {
+  m.impl("mem_efficient_attention", &MemEfficientAttention);
+  m.impl("_mem_efficient_attention_forward", &MemEfficientSDPAFwd);
+  m.impl("_mem_efficient_attention_backward", &MemEfficientSDPABwd);
+}
+
+TORCH_LIBRARY_IMPL(musa, Autograd, m) {
+  m.impl("mem_efficient_attention", &MemEfficientAttentionAutograd);
+}
+
+} // namespace musa
+} // namespace at
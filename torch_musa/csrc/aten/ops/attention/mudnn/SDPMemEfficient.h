@@ -0,0 +1,87 @@
+#ifndef TORCH_MUSA_CSRC_ATEN_OPS_ATTENTION_MUDNN_SDPMEMEFFICIENT_H_
+#define TORCH_MUSA_CSRC_ATEN_OPS_ATTENTION_MUDNN_SDPMEMEFFICIENT_H_
+
+#include <ATen/core/Tensor.h>
+#include <c10/util/Optional.h>
+
+#include <cstdint>
+#include <tuple>
+
+namespace at {
+namespace musa {
+
+// Default budget of the float score tiles alive at once.
+constexpr int64_t kMemEfficientTileBytes = 64 << 20;
+
+// Tiling of the [batch * heads, q_len, kv_len] score matrix into
+// q_tile x kv_tile blocks whose live float intermediates fit a byte budget.
+// Plain host arithmetic: the forward and the backward build the same plan
+// from the same shapes, so they visit the same tiles and replay the same
+// dropout draws.
+struct SDPTilePlan {
+  // score-sized float tensors alive per tile in the backward: probabilities,
+  // their gradient, the dropout keep mask and a temporary
+  static constexpr int64_t kLiveTiles = 4;
+  static constexpr int64_t kMaxTile = 1024;
+
+  SDPTilePlan(
+      int64_t batch_heads,
+      int64_t q_len,
+      int64_t kv_len,
+      int64_t max_tile_bytes);
+
+  int64_t num_q_tiles() const;
+  int64_t num_kv_tiles() const;
+  int64_t q_begin(int64_t qi) const;
+  int64_t q_size(int64_t qi) const;
+  int64_t kv_begin(int64_t ki) const;
+  int64_t kv_size(int64_t ki) const;
+  // kv tiles [0, end) that q tile `qi` attends to. With is_causal query i
+  // only sees keys j <= i (top-left aligned), later tiles are skipped.
+  int64_t kv_tile_end(int64_t qi, bool is_causal) const;
+  // Philox offset of tile (qi, ki) past the base reserved for the call, and
+  // the total to reserve. Tiles get disjoint ranges.
+  uint64_t philox_offset(int64_t qi, int64_t ki) const;
+  uint64_t philox_increment() const;
+
+  int64_t batch_heads;
+  int64_t q_len;
+  int64_t kv_len;
+  int64_t q_tile;
+  int64_t kv_tile;
+};
+
+// Attention that never materializes [B, H, Sq, Skv]: tiled online-softmax
+// forward returning (output, logsumexp, philox_seed, philox_offset), and a
+// backward that recomputes the probabilities tile by tile and redraws the
+// dropout mask from the Philox seed and offset. Plain ATen ops, so both run
+// on any device.
+std::tuple<Tensor, Tensor, Tensor, Tensor> MemEfficientSDPAFwd(
+    const Tensor& query,
+    const Tensor& key,
+    const Tensor& value,
+    const c10::optional<Tensor>& attn_mask,
+    double dropout_p,
+    bool is_causal,
+    c10::optional<double> scale,
+    c10::optional<int64_t> max_tile_bytes);
+
+std::tuple<Tensor, Tensor, Tensor> MemEfficientSDPABwd(
+    const Tensor& grad_out,
+    const Tensor& query,
+    const Tensor& key,
+    const Tensor& value,
+    const Tensor& output,
+    const Tensor& logsumexp,
+    const Tensor& philox_seed,
+    const Tensor& philox_offset,
+    const c10::optional<Tensor>& attn_mask,
+    double dropout_p,
+    bool is_causal,
+    c10::optional<double> scale,
+    c10::optional<int64_t> max_tile_bytes);
+
+} // namespace musa
+} // namespace at
+
+#endif // TORCH_MUSA_CSRC_ATEN_OPS_ATTENTION_MUDNN_SDPMEMEFFICIENT_H_
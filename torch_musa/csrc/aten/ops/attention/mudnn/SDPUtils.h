@@ -6,6 +6,7 @@
 #else
 #include <ATen/ops/_fused_sdp_choice_native.h>
 #endif
+#include <ATen/core/grad_mode.h>
 #include <ATen/native/transformers/attention.h>
 #include <ATen/native/transformers/musa/sdp_utils.h>
 #include <ATen/native/transformers/sdp_utils_cpp.h>
@@ -52,12 +53,48 @@ inline bool check_musa_attention_input(
   return true;
 }
 
+inline bool has_nested_input(const sdp_params& params) {
+  return params.query.is_nested() || params.key.is_nested() ||
+      params.value.is_nested();
+}
+
+// Nested inputs are lowered onto musa::flash_attn_varlen, which takes neither
+// a mask nor mixed dense and nested operands and has no backward.
+inline bool check_musa_nested_input(const sdp_params& params, bool is_debug) {
+  if (!has_nested_input(params)) {
+    return true;
+  }
+  const char* reason = nullptr;
+  if (!(params.query.is_nested() && params.key.is_nested() &&
+        params.value.is_nested())) {
+    reason = "query, key and value must all be nested";
+  } else if (params.attn_mask.has_value()) {
+    reason = "attn_mask is not supported";
+  } else if (
+      at::GradMode::is_enabled() &&
+      (params.query.requires_grad() || params.key.requires_grad() ||
+       params.value.requires_grad())) {
+    reason = "the backward is not supported";
+  }
+  if (reason != nullptr) {
+    if (is_debug) {
+      TORCH_WARN(
+          "FlashAttention in MUSA backend cannot take these nested inputs: ",
+          reason,
+          ".");
+    }
+    return false;
+  }
+  return true;
+}
+
 inline bool use_flash_attention(const sdp_params& params) {
   using SDPParamsCheckFunc = bool (*)(const sdp_params&, bool);
-  constexpr int conditions_num = 4;
+  constexpr int conditions_num = 5;
   constexpr std::array<SDPParamsCheckFunc, conditions_num> conditions{
       {check_runtime_disabled_flash,
        check_tensor_shapes,
+       check_musa_nested_input,
        check_musa_attention_input,
        check_musa_arch}};
   auto res = std::all_of(
@@ -72,6 +109,44 @@ inline bool use_flash_attention(const sdp_params& params) {
   return check_tensor_dtype(params, musa_allowed_dtypes, true);
 }
 
+// Below this many bytes of attention probabilities the math kernel is always
+// kept, larger ones are checked against the memory left on the device.
+constexpr int64_t kMemEfficientMinProbsBytes = int64_t{256} << 20;
+
+// Whether the math kernel, which materializes the [B, H, Sq, Skv] scores and
+// probabilities plus a dropout mask, would run out of device memory. Only
+// then is the tiled musa::mem_efficient_attention, which issues several ATen
+// ops per tile, worth taking over.
+inline bool math_attention_would_oom(const sdp_params& params) {
+  const auto& query = params.query;
+  const int64_t probs_bytes = query.size(0) * query.size(1) * query.size(2) *
+      params.key.size(2) * query.element_size();
+  if (probs_bytes < kMemEfficientMinProbsBytes) {
+    return false;
+  }
+  const int64_t math_bytes = (params.dropout > 0.0 ? 3 : 2) * probs_bytes;
+  size_t device_free = 0;
+  size_t device_total = 0;
+  C10_MUSA_CHECK(musaMemGetInfo(&device_free, &device_total));
+  // blocks cached by the allocator are free for the math kernel as well
+  const auto stats = c10::musa::MUSACachingAllocator::GetDeviceStats(
+      query.device().index());
+  constexpr auto kAggregate =
+      static_cast<size_t>(c10::musa::MUSACachingAllocator::StatType::AGGREGATE);
+  const int64_t cached = stats.reserved_bytes[kAggregate].current -
+      stats.allocated_bytes[kAggregate].current;
+  return math_bytes > static_cast<int64_t>(device_free) + cached;
+}
+
+inline bool use_mem_efficient_attention(const sdp_params& params) {
+  const auto& ctx = at::globalContext();
+  if (!ctx.userEnabledMemEfficientSDP() || has_nested_input(params) ||
+      !check_tensor_shapes(params, false)) {
+    return false;
+  }
+  return !ctx.userEnabledMathSDP() || math_attention_would_oom(params);
+}
+
 inline SDPBackend select_backend(const sdp_params& params) {
   const auto& ctx = at::globalContext();
   if (!ctx.userEnabledMathSDP() && !ctx.userEnabledFlashSDP() &&
@@ -80,6 +155,13 @@ inline SDPBackend select_backend(const sdp_params& params) {
   }
   if (use_flash_attention(params)) {
     return SDPBackend::flash_attention;
+  } else if (has_nested_input(params)) {
+    TORCH_CHECK(
+        false,
+        "Nested tensor inputs of scaled_dot_product_attention on MUSA are "
+        "only supported by the flash backend, see the warnings above.")
+  } else if (use_mem_efficient_attention(params)) {
+    return SDPBackend::efficient_attention;
   } else if (ctx.userEnabledMathSDP()) {
     return SDPBackend::math;
   } else {
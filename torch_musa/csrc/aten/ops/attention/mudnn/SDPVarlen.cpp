@@ -0,0 +1,596 @@
+#include <ATen/Config.h>
+#include <ATen/NestedTensorImpl.h>
+#include <ATen/core/dispatch/Dispatcher.h>
+#include <ATen/native/nested/NestedTensorUtils.h>
+#include <torch/csrc/autograd/custom_function.h>
+#include <torch/library.h>
+
+#include <map>
+
+#ifndef AT_PER_OPERATOR_HEADERS
+#include <ATen/Functions.h>
+#include <ATen/NativeFunctions.h>
+#else
+#include <ATen/ops/cat.h>
+#include <ATen/ops/empty.h>
+#include <ATen/ops/index_select.h>
+#include <ATen/ops/scaled_dot_product_attention.h>
+#include <ATen/ops/transpose_native.h>
+#include <ATen/ops/unbind_native.h>
+#include <ATen/ops/zeros.h>
+#endif
+
+#include "torch_musa/csrc/aten/ops/attention/mudnn/SDPVarlen.h"
+#include "torch_musa/csrc/aten/utils/Utils.h"
+#include "torch_musa/csrc/core/MUSAGuard.h"
+
+namespace at {
+namespace native {
+
+DEFINE_DISPATCH(varlen_pack_stub);
+DEFINE_DISPATCH(varlen_unpack_stub);
+
+REGISTER_NO_CPU_DISPATCH(varlen_pack_stub);
+REGISTER_NO_CPU_DISPATCH(varlen_unpack_stub);
+
+} // namespace native
+
+namespace musa {
+
+namespace {
+
+void CheckCuSeqlens(const Tensor& cu_seqlens, const char* name) {
+  TORCH_CHECK(
+      cu_seqlens.dim() == 1 && cu_seqlens.numel() >= 1,
+      name,
+      " must be a 1-D tensor of batch_size + 1 offsets, but got shape ",
+      cu_seqlens.sizes());
+  TORCH_CHECK(
+      cu_seqlens.scalar_type() == kInt || cu_seqlens.scalar_type() == kLong,
+      name,
+      " must be int32 or int64, but got ",
+      cu_seqlens.scalar_type());
+}
+
+Tensor HostCuSeqlens(const Tensor& cu_seqlens) {
+  return cu_seqlens.to(kCPU, kLong).contiguous();
+}
+
+std::vector<int64_t> PaddedShape(
+    const Tensor& packed,
+    int64_t batch,
+    int64_t max_seqlen) {
+  std::vector<int64_t> shape{batch, max_seqlen};
+  shape.insert(shape.end(), packed.sizes().begin() + 1, packed.sizes().end());
+  return shape;
+}
+
+std::vector<int64_t> PackedShape(const Tensor& padded, int64_t total) {
+  std::vector<int64_t> shape{total};
+  shape.insert(shape.end(), padded.sizes().begin() + 2, padded.sizes().end());
+  return shape;
+}
+
+int64_t PackedTotal(
+    const Tensor& cu_seqlens,
+    const c10::optional<int64_t>& total) {
+  // reading the last offset of device cu_seqlens synchronizes
+  return total.has_value() ? total.value()
+                           : cu_seqlens[-1].item().to<int64_t>();
+}
+
+} // anonymous namespace
+
+Tensor VarlenPackCPU(
+    const Tensor& padded,
+    const Tensor& cu_seqlens,
+    c10::optional<int64_t> total) {
+  TORCH_CHECK(
+      padded.dim() >= 2,
+      "varlen_pack expects padded input of shape [batch, max_seqlen, *]");
+  CheckCuSeqlens(cu_seqlens, "cu_seqlens");
+  const Tensor cu = HostCuSeqlens(cu_seqlens);
+  const int64_t* offsets = cu.data_ptr<int64_t>();
+  const int64_t batch = cu.numel() - 1;
+  TORCH_CHECK(
+      padded.size(0) == batch,
+      "varlen_pack: cu_seqlens describes ",
+      batch,
+      " sequences but the padded input holds ",
+      padded.size(0));
+  Tensor packed =
+      at::zeros(PackedShape(padded, PackedTotal(cu, total)), padded.options());
+  for (int64_t b = 0; b < batch; ++b) {
+    const int64_t len = offsets[b + 1] - offsets[b];
+    TORCH_CHECK(
+        len >= 0 && len <= padded.size(1),
+        "varlen_pack: sequence ",
+        b,
+        " has length ",
+        len,
+        ", expected it in [0, ",
+        padded.size(1),
+        "]");
+    packed.narrow(0, offsets[b], len).copy_(padded[b].narrow(0, 0, len));
+  }
+  return packed;
+}
+
+Tensor VarlenUnpackCPU(
+    const Tensor& packed,
+    const Tensor& cu_seqlens,
+    int64_t max_seqlen) {
+  TORCH_CHECK(
+      packed.dim() >= 1,
+      "varlen_unpack expects packed input of shape [total, *]");
+  CheckCuSeqlens(cu_seqlens, "cu_seqlens");
+  const Tensor cu = HostCuSeqlens(cu_seqlens);
+  const int64_t* offsets = cu.data_ptr<int64_t>();
+  const int64_t batch = cu.numel() - 1;
+  Tensor padded =
+      at::zeros(PaddedShape(packed, batch, max_seqlen), packed.options());
+  for (int64_t b = 0; b < batch; ++b) {
+    const int64_t len = offsets[b + 1] - offsets[b];
+    TORCH_CHECK(
+        len >= 0 && len <= max_seqlen,
+        "varlen_unpack: sequence ",
+        b,
+        " has length ",
+        len,
+        ", expected it in [0, ",
+        max_seqlen,
+        "]");
+    padded[b].narrow(0, 0, len).copy_(packed.narrow(0, offsets[b], len));
+  }
+  return padded;
+}
+
+Tensor VarlenPack(
+    const Tensor& padded,
+    const Tensor& cu_seqlens,
+    c10::optional<int64_t> total) {
+  TORCH_CHECK(
+      padded.dim() >= 2,
+      "varlen_pack expects padded input of shape [batch, max_seqlen, *]");
+  CheckCuSeqlens(cu_seqlens, "cu_seqlens");
+  TORCH_CHECK(
+      padded.size(0) == cu_seqlens.numel() - 1,
+      "varlen_pack: cu_seqlens describes ",
+      cu_seqlens.numel() - 1,
+      " sequences but the padded input holds ",
+      padded.size(0));
+  c10::musa::MUSAGuard device_guard(padded.device());
+  const Tensor cu = cu_seqlens.to(padded.device(), kLong).contiguous();
+  Tensor packed =
+      at::empty(PackedShape(padded, PackedTotal(cu_seqlens, total)),
+                padded.options());
+  if (padded.size(0) > 0) {
+    at::native::varlen_pack_stub(kMUSA, packed, padded.contiguous(), cu);
+  }
+  return packed;
+}
+
+Tensor VarlenUnpack(
+    const Tensor& packed,
+    const Tensor& cu_seqlens,
+    int64_t max_seqlen) {
+  TORCH_CHECK(
+      packed.dim() >= 1,
+      "varlen_unpack expects packed input of shape [total, *]");
+  CheckCuSeqlens(cu_seqlens, "cu_seqlens");
+  c10::musa::MUSAGuard device_guard(packed.device());
+  const Tensor cu = cu_seqlens.to(packed.device(), kLong).contiguous();
+  Tensor padded = at::empty(
+      PaddedShape(packed, cu_seqlens.numel() - 1, max_seqlen),
+      packed.options());
+  at::native::varlen_unpack_stub(kMUSA, padded, packed.contiguous(), cu);
+  return padded;
+}
+
+namespace {
+
+Tensor CallVarlenPack(
+    const Tensor& padded,
+    const Tensor& cu_seqlens,
+    c10::optional<int64_t> total) {
+  static auto op = c10::Dispatcher::singleton()
+                       .findSchemaOrThrow("musa::varlen_pack", "")
+                       .typed<decltype(VarlenPack)>();
+  return op.call(padded, cu_seqlens, total);
+}
+
+Tensor CallVarlenUnpack(
+    const Tensor& packed,
+    const Tensor& cu_seqlens,
+    int64_t max_seqlen) {
+  static auto op = c10::Dispatcher::singleton()
+                       .findSchemaOrThrow("musa::varlen_unpack", "")
+                       .typed<decltype(VarlenUnpack)>();
+  return op.call(packed, cu_seqlens, max_seqlen);
+}
+
+// Pack and unpack are adjoint, each one's backward is the other.
+class VarlenPackFunction
+    : public torch::autograd::Function<VarlenPackFunction> {
+ public:
+  static Tensor forward(
+      torch::autograd::AutogradContext* ctx,
+      const Tensor& padded,
+      const Tensor& cu_seqlens,
+      c10::optional<int64_t> total) {
+    at::AutoDispatchBelowADInplaceOrView guard;
+    ctx->save_for_backward({cu_seqlens});
+    ctx->saved_data["max_seqlen"] = padded.size(1);
+    return CallVarlenPack(padded, cu_seqlens, total);
+  }
+
+  static torch::autograd::variable_list backward(
+      torch::autograd::AutogradContext* ctx,
+      torch::autograd::variable_list grad_outputs) {
+    const auto cu_seqlens = ctx->get_saved_variables()[0];
+    return {
+        CallVarlenUnpack(
+            grad_outputs[0],
+            cu_seqlens,
+            ctx->saved_data["max_seqlen"].toInt()),
+        Tensor(),
+        Tensor()};
+  }
+};
+
+class VarlenUnpackFunction
+    : public torch::autograd::Function<VarlenUnpackFunction> {
+ public:
+  static Tensor forward(
+      torch::autograd::AutogradContext* ctx,
+      const Tensor& packed,
+      const Tensor& cu_seqlens,
+      int64_t max_seqlen) {
+    at::AutoDispatchBelowADInplaceOrView guard;
+    ctx->save_for_backward({cu_seqlens});
+    ctx->saved_data["total"] = packed.size(0);
+    return CallVarlenUnpack(packed, cu_seqlens, max_seqlen);
+  }
+
+  static torch::autograd::variable_list backward(
+      torch::autograd::AutogradContext* ctx,
+      torch::autograd::variable_list grad_outputs) {
+    const auto cu_seqlens = ctx->get_saved_variables()[0];
+    return {
+        CallVarlenPack(
+            grad_outputs[0], cu_seqlens, ctx->saved_data["total"].toInt()),
+        Tensor(),
+        Tensor()};
+  }
+};
+
+// [n * seq_len, H, D] rows starting at `begin` as a dense [n, H, seq_len, D]
+// view, no copy is made.
+Tensor DenseView(
+    const Tensor& packed,
+    int64_t begin,
+    int64_t n,
+    int64_t seq_len) {
+  return packed.narrow(0, begin, n * seq_len)
+      .view({n, seq_len, packed.size(1), packed.size(2)})
+      .transpose(1, 2);
+}
+
+} // anonymous namespace
+
+Tensor VarlenPackAutograd(
+    const Tensor& padded,
+    const Tensor& cu_seqlens,
+    c10::optional<int64_t> total) {
+  return VarlenPackFunction::apply(padded, cu_seqlens, total);
+}
+
+Tensor VarlenUnpackAutograd(
+    const Tensor& packed,
+    const Tensor& cu_seqlens,
+    int64_t max_seqlen) {
+  return VarlenUnpackFunction::apply(packed, cu_seqlens, max_seqlen);
+}
+
+// Attention over packed sequences, muDNN has no varlen kernel so the batch is
+// lowered onto dense scaled_dot_product_attention calls, which pick the flash
+// backend whenever it applies. Sequences are bucketed by (q_len, k_len), each
+// bucket is one dense call without any padding: a bucket of neighbouring
+// sequences is viewed in place, any other one gathers its rows. The outputs
+// are scattered back into the packed order. Causal masking is top-left
+// aligned within every sequence, as in scaled_dot_product_attention.
+Tensor FlashAttnVarlen(
+    const Tensor& query,
+    const Tensor& key,
+    const Tensor& value,
+    const Tensor& cu_seqlens_q,
+    const Tensor& cu_seqlens_k,
+    int64_t max_seqlen_q,
+    int64_t max_seqlen_k,
+    double dropout_p,
+    bool is_causal,
+    c10::optional<double> scale) {
+  TORCH_CHECK(
+      query.dim() == 3 && key.dim() == 3 && value.dim() == 3,
+      "flash_attn_varlen expects packed query, key and value of shape ",
+      "[total, num_heads, head_dim], but got ",
+      query.sizes(),
+      ", ",
+      key.sizes(),
+      " and ",
+      value.sizes());
+  TORCH_CHECK(
+      key.size(0) == value.size(0) && key.size(1) == value.size(1),
+      "flash_attn_varlen: key and value must hold the same rows and heads");
+  CheckCuSeqlens(cu_seqlens_q, "cu_seqlens_q");
+  CheckCuSeqlens(cu_seqlens_k, "cu_seqlens_k");
+  TORCH_CHECK(
+      cu_seqlens_q.numel() == cu_seqlens_k.numel(),
+      "flash_attn_varlen: cu_seqlens_q and cu_seqlens_k describe a different ",
+      "number of sequences");
+
+  // The sequence lengths decide the shapes of the dense calls, so they are
+  // read on the host. Passing CPU cu_seqlens avoids a device sync.
+  const Tensor host_q = HostCuSeqlens(cu_seqlens_q);
+  const Tensor host_k = HostCuSeqlens(cu_seqlens_k);
+  const int64_t* off_q = host_q.data_ptr<int64_t>();
+  const int64_t* off_k = host_k.data_ptr<int64_t>();
+  const int64_t batch = host_q.numel() - 1;
+  TORCH_CHECK(
+      off_q[batch] == query.size(0) && off_k[batch] == key.size(0),
+      "flash_attn_varlen: cu_seqlens end at ",
+      off_q[batch],
+      " query and ",
+      off_k[batch],
+      " key rows, but got ",
+      query.size(0),
+      " and ",
+      key.size(0));
+
+  // sequences of every (q_len, k_len), in the order the lengths first appear
+  std::vector<std::pair<int64_t, int64_t>> lengths;
+  std::vector<std::vector<int64_t>> buckets;
+  std::map<std::pair<int64_t, int64_t>, size_t> bucket_of;
+  for (int64_t b = 0; b < batch; ++b) {
+    const int64_t len_q = off_q[b + 1] - off_q[b];
+    const int64_t len_k = off_k[b + 1] - off_k[b];
+    TORCH_CHECK(
+        len_q >= 0 && len_q <= max_seqlen_q && len_k >= 0 &&
+            len_k <= max_seqlen_k,
+        "flash_attn_varlen: sequence ",
+        b,
+        " has ",
+        len_q,
+        " query and ",
+        len_k,
+        " key rows, which exceeds max_seqlen_q=",
+        max_seqlen_q,
+        " or max_seqlen_k=",
+        max_seqlen_k);
+    TORCH_CHECK(
+        len_q == 0 || len_k > 0,
+        "flash_attn_varlen: sequence ",
+        b,
+        " has queries but no keys");
+    if (len_q == 0) {
+      continue;
+    }
+    auto inserted =
+        bucket_of.emplace(std::make_pair(len_q, len_k), buckets.size());
+    if (inserted.second) {
+      lengths.emplace_back(len_q, len_k);
+      buckets.emplace_back();
+    }
+    buckets[inserted.first->second].push_back(b);
+  }
+
+  if (buckets.empty()) {
+    return at::empty(
+        {query.size(0), query.size(1), value.size(2)}, query.options());
+  }
+
+  // rows of the given sequences, in sequence order, as a device index
+  auto gather_index = [&](const std::vector<int64_t>& seqs,
+                          const int64_t* offsets,
+                          int64_t len) {
+    Tensor index = at::empty({int64_t(seqs.size()) * len}, kLong);
+    int64_t* rows = index.data_ptr<int64_t>();
+    for (const int64_t b : seqs) {
+      for (int64_t i = 0; i < len; ++i) {
+        *rows++ = offsets[b] + i;
+      }
+    }
+    return index.to(query.device());
+  };
+  // a packed [n * len, H, D] tensor as a dense [n, H, len, D] batch
+  auto as_batch = [](const Tensor& rows, int64_t n, int64_t len) {
+    return rows.view({n, len, rows.size(1), rows.size(2)}).transpose(1, 2);
+  };
+
+  std::vector<Tensor> outputs;
+  // packed query row of every output row
+  Tensor order = at::empty({query.size(0)}, kLong);
+  int64_t* order_rows = order.data_ptr<int64_t>();
+  int64_t written = 0;
+  bool in_order = true;
+  for (size_t i = 0; i < buckets.size(); ++i) {
+    const auto& seqs = buckets[i];
+    const int64_t n = seqs.size();
+    const int64_t len_q = lengths[i].first;
+    const int64_t len_k = lengths[i].second;
+    Tensor q, k, v;
+    if (seqs.back() - seqs.front() + 1 == n) {
+      q = DenseView(query, off_q[seqs.front()], n, len_q);
+      k = DenseView(key, off_k[seqs.front()], n, len_k);
+      v = DenseView(value, off_k[seqs.front()], n, len_k);
+    } else {
+      const Tensor index_k = gather_index(seqs, off_k, len_k);
+      q = as_batch(
+          query.index_select(0, gather_index(seqs, off_q, len_q)), n, len_q);
+      k = as_batch(key.index_select(0, index_k), n, len_k);
+      v = as_batch(value.index_select(0, index_k), n, len_k);
+    }
+    Tensor out = at::scaled_dot_product_attention(
+        q, k, v, c10::nullopt, dropout_p, is_causal, scale);
+    outputs.push_back(out.transpose(1, 2).reshape(
+        {n * len_q, query.size(1), value.size(2)}));
+    for (const int64_t b : seqs) {
+      for (int64_t row = off_q[b]; row < off_q[b + 1]; ++row) {
+        in_order = in_order && row == written;
+        order_rows[written++] = row;
+      }
+    }
+  }
+
+  Tensor out = outputs.size() == 1 ? outputs[0] : at::cat(outputs);
+  if (in_order) {
+    return out;
+  }
+  // output row of every packed query row
+  Tensor inverse = at::empty({query.size(0)}, kLong);
+  int64_t* positions = inverse.data_ptr<int64_t>();
+  for (int64_t i = 0; i < query.size(0); ++i) {
+    positions[order_rows[i]] = i;
+  }
+  return out.index_select(0, inverse.to(query.device()));
+}
+
+namespace {
+
+// Packed rows and offsets of a contiguous nested [B, S*, H, D] tensor. The
+// nested sizes live on the host, so nothing here waits on the device.
+std::tuple<Tensor, Tensor, int64_t> NestedVarlen(
+    const Tensor& nested,
+    const char* name) {
+  TORCH_CHECK(
+      nested.is_contiguous(),
+      "Nested ",
+      name,
+      " of scaled_dot_product_attention on MUSA must be contiguous in the ",
+      "[batch, seq_len, num_heads, head_dim] layout before the transpose");
+  auto* impl = at::native::get_nested_tensor_impl(nested);
+  const Tensor& sizes = impl->get_nested_sizes();
+  TORCH_CHECK(
+      sizes.dim() == 2 && sizes.size(1) == 3,
+      "Nested ",
+      name,
+      " of scaled_dot_product_attention must be 4-D");
+  Tensor lengths = sizes.select(1, 0);
+  Tensor cu_seqlens = at::zeros({sizes.size(0) + 1}, sizes.options());
+  cu_seqlens.narrow(0, 1, sizes.size(0)).copy_(lengths.cumsum(0));
+  const int64_t max_seqlen =
+      sizes.size(0) ? lengths.max().item().to<int64_t>() : 0;
+  Tensor packed =
+      impl->get_buffer().view({-1, nested.size(2), nested.size(3)});
+  return std::make_tuple(packed, cu_seqlens, max_seqlen);
+}
+
+} // anonymous namespace
+
+// Nested-tensor scaled_dot_product_attention routed to the flash backend by
+// sdp::use_flash_attention. Only the output is produced, logsumexp and the
+// dropout mask are returned empty since the backward is not supported.
+std::tuple<Tensor, Tensor, Tensor> NestedFlashSDPAFwd(
+    const Tensor& query,
+    const Tensor& key,
+    const Tensor& value,
+    const c10::optional<Tensor>& attn_mask,
+    double dropout_p,
+    bool is_causal,
+    c10::optional<double> scale) {
+  TORCH_CHECK(
+      query.is_nested() && key.is_nested() && value.is_nested(),
+      "Nested-tensor flash attention on MUSA needs nested query, key and value");
+  TORCH_CHECK(
+      !attn_mask.has_value(),
+      "Nested-tensor flash attention on MUSA does not take attn_mask");
+  c10::musa::MUSAGuard device_guard(query.device());
+  // [B, H, S*, D] -> [B, S*, H, D], the layout nested inputs are built in
+  const Tensor q_t = query.transpose(1, 2);
+  Tensor packed_q, cu_seqlens_q, packed_k, cu_seqlens_k, packed_v;
+  int64_t max_seqlen_q, max_seqlen_k;
+  std::tie(packed_q, cu_seqlens_q, max_seqlen_q) = NestedVarlen(q_t, "query");
+  std::tie(packed_k, cu_seqlens_k, max_seqlen_k) =
+      NestedVarlen(key.transpose(1, 2), "key");
+  std::tie(packed_v, std::ignore, std::ignore) =
+      NestedVarlen(value.transpose(1, 2), "value");
+
+  Tensor packed_out = FlashAttnVarlen(
+      packed_q,
+      packed_k,
+      packed_v,
+      cu_seqlens_q,
+      cu_seqlens_k,
+      max_seqlen_q,
+      max_seqlen_k,
+      dropout_p,
+      is_causal,
+      scale);
+  Tensor out_sizes =
+      at::native::get_nested_tensor_impl(q_t)->get_nested_sizes().clone();
+  out_sizes.select(1, 2).fill_(packed_v.size(2));
+  Tensor output = at::native::wrap_buffer(
+                      packed_out.contiguous().view(-1), out_sizes)
+                      .transpose(1, 2);
+  return std::make_tuple(output, Tensor(), Tensor());
+}
+
+std::tuple<Tensor, Tensor, Tensor> NestedFlashSDPABwd(
+    const Tensor& grad_output,
+    const Tensor& query,
+    const Tensor& key,
+    const Tensor& value,
+    const Tensor& output,
+    const Tensor& logsumexp,
+    const Tensor& dropout_mask,
+    bool is_causal,
+    const c10::optional<Tensor>& mask,
+    c10::optional<double> scale) {
+  TORCH_CHECK(
+      false,
+      "Backward of nested-tensor scaled_dot_product_attention is not ",
+      "supported on MUSA, train on packed tensors with ",
+      "torch.ops.musa.flash_attn_varlen instead");
+}
+
+TORCH_LIBRARY_FRAGMENT(musa, m) {
+  m.def(
+      "varlen_pack(Tensor padded, Tensor cu_seqlens, int? total=None) -> Tensor");
+  m.def(
+      "varlen_unpack(Tensor packed, Tensor cu_seqlens, int max_seqlen) -> Tensor");
+  m.def(
+      "flash_attn_varlen(Tensor query, Tensor key, Tensor value, Tensor cu_seqlens_q, Tensor cu_seqlens_k, int max_seqlen_q, int max_seqlen_k, float dropout_p=0.0, bool is_causal=False, *, float? scale=None) -> Tensor");
+}
+
+TORCH_LIBRARY_IMPL(musa, PrivateUse1, m) {
+  m.impl("varlen_pack", &VarlenPack);
+  m.impl("varlen_unpack", &VarlenUnpack);
+}
+
+TORCH_LIBRARY_IMPL(musa, CPU, m) {
+  m.impl("varlen_pack", &VarlenPackCPU);
+  m.impl("varlen_unpack", &VarlenUnpackCPU);
+}
+
+TORCH_LIBRARY_IMPL(musa, Autograd, m) {
+  m.impl("varlen_pack", &VarlenPackAutograd);
+  m.impl("varlen_unpack", &VarlenUnpackAutograd);
+}
+
+TORCH_LIBRARY_IMPL(musa, CompositeImplicitAutograd, m) {
+  m.impl("flash_attn_varlen", &FlashAttnVarlen);
+}
+
+TORCH_LIBRARY_IMPL(aten, NestedTensorPrivateUse1, m) {
+  // metadata only, lets nested inputs reach the [B, H, S*, D] layout and
+  // nested outputs be split back into sequences
+  m.impl("transpose.int", &at::native::transpose_nested);
+  m.impl("unbind.int", &at::native::NestedTensor_unbind);
+  m.impl("_scaled_dot_product_attention_flash_musa", &NestedFlashSDPAFwd);
+  m.impl(
+      "_scaled_dot_product_attention_flash_musa_backward",
+      &NestedFlashSDPABwd);
+}
+
+} // namespace musa
+} // namespace at
@@ -0,0 +1,26 @@
+#ifndef TORCH_MUSA_CSRC_ATEN_OPS_ATTENTION_MUDNN_SDPVARLEN_H_
+#define TORCH_MUSA_CSRC_ATEN_OPS_ATTENTION_MUDNN_SDPVARLEN_H_
+
+#include <ATen/core/Tensor.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at {
+namespace native {
+
+// Packed varlen tensors hold the rows of B sequences back to back,
+// cu_seqlens is the int64 [B + 1] exclusive prefix sum of their lengths.
+
+// (packed [total, *], padded [B, max_seqlen, *], cu_seqlens), every tensor
+// contiguous and on the same device
+using varlen_pack_fn = void (*)(Tensor&, const Tensor&, const Tensor&);
+// (padded [B, max_seqlen, *], packed [total, *], cu_seqlens), rows past the
+// end of a sequence are zero-filled
+using varlen_unpack_fn = void (*)(Tensor&, const Tensor&, const Tensor&);
+
+DECLARE_DISPATCH(varlen_pack_fn, varlen_pack_stub);
+DECLARE_DISPATCH(varlen_unpack_fn, varlen_unpack_stub);
+
+} // namespace native
+} // namespace at
+
+#endif // TORCH_MUSA_CSRC_ATEN_OPS_ATTENTION_MUDNN_SDPVARLEN_H_
@@ -51,8 +51,6 @@ void PackedConvWeightMudnn<kSpatialDim>::apply_impl_helper(
 
   auto act_scale = input.q_scale();
   auto act_zero_point = input.q_zero_point();
-  auto weight_scale = weight_.q_scale();
-  auto weight_zero_point = weight_.q_zero_point();
 
   // permute to NHWC format
   at::Tensor input_ = input.permute({0, 2, 3, 1});
@@ -70,9 +68,23 @@ void PackedConvWeightMudnn<kSpatialDim>::apply_impl_helper(
   CHECK_MUDNN_STATUS(
       ke.SetFormat(at::musa::muTensor::Format::NHWC),
       "Set weight muTensor format as NHWC");
+
+  if (at::musa::IsPerChannelQScheme(q_scheme_)) {
+    apply_per_channel_helper<act_mode>(
+        quantized_output,
+        input_,
+        in,
+        ke,
+        accum,
+        output_scale,
+        output_zero_point);
+    return;
+  }
+
   at::musa::SetMudnnQuantizationInfo(in, act_scale, act_zero_point);
   at::musa::SetMudnnQuantizationInfo(out, output_scale, output_zero_point);
-  at::musa::SetMudnnQuantizationInfo(ke, weight_scale, weight_zero_point);
+  at::musa::SetMudnnQuantizationInfo(
+      ke, weight_.q_scale(), weight_.q_zero_point());
 
   // if bias is used, we should make a muTensor and broadcast it first
   at::musa::muTensor bias;
@@ -132,6 +144,67 @@ void PackedConvWeightMudnn<kSpatialDim>::apply_impl_helper(
   return;
 }
 
+// muDNN convolution takes a single weight scale, so per-channel weights run
+// an int8 x int8 -> int32 convolution and the per-channel scales, bias,
+// skip-connection add and activation are applied by the fused requantization
+// epilogue
+template <int kSpatialDim>
+template <ActMode act_mode>
+void PackedConvWeightMudnn<kSpatialDim>::apply_per_channel_helper(
+    at::Tensor& quantized_output,
+    const at::Tensor& input,
+    at::musa::muTensor& in,
+    at::musa::muTensor& ke,
+    const c10::optional<at::Tensor>& accum,
+    double output_scale,
+    int64_t output_zero_point) {
+  // padded borders hold raw zeros, a zero point cannot be folded afterwards
+  TORCH_CHECK(
+      input.q_zero_point() == 0,
+      "Conv2d with per-channel quantized weight requires symmetric quantized "
+      "activation, but got zero_point ",
+      input.q_zero_point());
+
+  // quantized_output is a NHWC-permuted view over channels-last memory
+  at::Tensor acc = at::empty(
+      quantized_output.sizes(), at::device(input.device()).dtype(at::kInt));
+  at::musa::muTensor out = at::musa::CreateMUTensor(acc);
+  CHECK_MUDNN_STATUS(
+      out.SetFormat(at::musa::muTensor::Format::NHWC),
+      "Set accumulator muTensor format as NHWC");
+
+  at::Tensor accum_;
+  if (accum.has_value()) {
+    TORCH_CHECK(
+        accum.value().is_quantized(),
+        "accum tensor in qconv must be a quantized Tensor");
+    accum_ =
+        accum.value().to(c10::MemoryFormat::ChannelsLast).permute({0, 2, 3, 1});
+  }
+
+  at::musa::muHandle& h = at::GetMudnnHandle();
+  ::musa::dnn::Convolution op;
+  ConfigConv(
+      op, input.scalar_type(), padding(), stride(), dilation(), groups());
+  ::musa::dnn::Convolution::Algorithm algorithm =
+      static_cast<::musa::dnn::Convolution::Algorithm>(0);
+  CHECK_MUDNN_STATUS(
+      op.Run(h, out, in, ke, algorithm, at::musa::InternalMemAlloc), "Run");
+
+  at::musa::RequantizePerChannel(
+      quantized_output,
+      acc,
+      input.q_scale(),
+      /*input_zero_point=*/0,
+      weight_.q_per_channel_scales(),
+      /*weight_row_sum=*/c10::nullopt,
+      bias_,
+      accum.has_value() ? c10::optional<at::Tensor>(accum_) : c10::nullopt,
+      output_scale,
+      output_zero_point,
+      act_mode);
+}
+
 // weight and output Tensor will be a clampped int8 Tensor
 // while QY1 would cast weight to uint8 format
 /*
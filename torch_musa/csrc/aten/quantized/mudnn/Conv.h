@@ -15,10 +15,9 @@
 #endif
 
 #include "torch_musa/csrc/aten/ops/TensorFactory.h"
+#include "torch_musa/csrc/aten/quantized/mudnn/Requantize.h"
 #include "torch_musa/csrc/aten/utils/Context.h"
 
-enum class ActMode { IDENTITY, RELU, SILU };
-
 template <int kSpatialDim>
 at::SmallVector<int64_t, kSpatialDim + 2> MakeQConvOutputShape(
     int N, // mini-batch
@@ -179,6 +178,16 @@ struct TORCH_API PackedConvWeightMudnn
       double output_scale,
       int64_t output_zero_point);
 
+  template <ActMode act_mode>
+  void apply_per_channel_helper(
+      at::Tensor& quantized_output,
+      const at::Tensor& input,
+      at::musa::muTensor& in,
+      at::musa::muTensor& ke,
+      const c10::optional<at::Tensor>& accum,
+      double output_scale,
+      int64_t output_zero_point);
+
   template <ActMode act_mode>
   void apply_impl_helper(
       at::Tensor& quantized_output,
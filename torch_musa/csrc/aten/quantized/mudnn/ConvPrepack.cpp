@@ -20,11 +20,14 @@ c10::intrusive_ptr<ConvPackedParamsBase<kSpatialDim>> PackedConvWeightMudnn<
         torch::List<int64_t> dilation,
         int64_t groups,
         bool transpose) {
+  const bool per_channel = at::musa::IsPerChannelQScheme(weight.qscheme());
   TORCH_CHECK(
       weight.qscheme() == c10::kPerTensorAffine ||
-          weight.qscheme() == c10::kPerTensorSymmetric,
+          weight.qscheme() == c10::kPerTensorSymmetric ||
+          (per_channel && weight.q_per_channel_axis() == 0),
       "Unsupported qscheme: ",
-      toString(weight.qscheme()));
+      toString(weight.qscheme()),
+      ", per-channel weights must be quantized along output channels");
   TORCH_CHECK(
       kSpatialDim == 2, // 1D is packed as 2d, hence we don't need other checks
       "muDNN packing only supports 2D convolution.");
@@ -62,11 +65,18 @@ c10::intrusive_ptr<ConvPackedParamsBase<kSpatialDim>> PackedConvWeightMudnn<
       weight.scalar_type() == c10::kQInt8,
       "TORCH_MUSA_ARCH > 210 requires weights in format QInt8, which is ",
       weight.scalar_type());
-  TORCH_CHECK(
-      weight.q_zero_point() == 0,
-      "TORCH_MUSA_ARCH > 210 requires weights are quantized in per-tensor and symmetric quantization, ",
-      "zero_point should be 0, which is ",
-      weight.q_zero_point());
+  if (per_channel) {
+    TORCH_CHECK(
+        weight.q_per_channel_zero_points().eq(0).all().item<bool>(),
+        "TORCH_MUSA_ARCH > 210 requires per-channel weights are quantized in ",
+        "symmetric quantization, all zero_points should be 0");
+  } else {
+    TORCH_CHECK(
+        weight.q_zero_point() == 0,
+        "TORCH_MUSA_ARCH > 210 requires weights are quantized in per-tensor and symmetric quantization, ",
+        "zero_point should be 0, which is ",
+        weight.q_zero_point());
+  }
 
   const int output_channels = weight.size(0);
   const auto qtype = weight.qscheme();
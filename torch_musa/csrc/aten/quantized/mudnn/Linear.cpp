@@ -11,9 +11,123 @@
 
 #include "torch_musa/csrc/aten/ops/TensorFactory.h"
 #include "torch_musa/csrc/aten/quantized/QTensor.h"
+#include "torch_musa/csrc/aten/quantized/mudnn/Conv.h"
 #include "torch_musa/csrc/aten/quantized/mudnn/Linear.h"
 #include "torch_musa/csrc/aten/utils/Utils.h"
 
+namespace {
+
+// MatMul has no activation epilogue, so linear_relu is issued as a 1x1 NHWC
+// convolution whose RunFusion applies bias and ReLU before requantization
+void QLinearReluAsConv(
+    at::Tensor& quantized_output,
+    const at::Tensor& input,
+    const at::Tensor& weight,
+    const c10::optional<at::Tensor>& bias,
+    double output_scale,
+    int64_t output_zero_point) {
+  const int64_t M = quantized_output.size(0);
+  const int64_t N = quantized_output.size(1);
+  const int64_t K = input.size(1);
+
+  at::Tensor contig_input;
+  at::Tensor contig_weight;
+  at::musa::muTensor in = at::musa::CreateMUTensor(
+      at::musa::ContiguousRef(input, contig_input).view({M, 1, 1, K}));
+  at::musa::muTensor ke = at::musa::CreateMUTensor(
+      at::musa::ContiguousRef(weight, contig_weight).view({N, 1, 1, K}));
+  at::musa::muTensor out =
+      at::musa::CreateMUTensor(quantized_output.view({M, 1, 1, N}));
+  CHECK_MUDNN_STATUS(
+      in.SetFormat(at::musa::muTensor::Format::NHWC),
+      "Set input muTensor format as NHWC");
+  CHECK_MUDNN_STATUS(
+      out.SetFormat(at::musa::muTensor::Format::NHWC),
+      "Set output muTensor format as NHWC");
+  CHECK_MUDNN_STATUS(
+      ke.SetFormat(at::musa::muTensor::Format::NHWC),
+      "Set weight muTensor format as NHWC");
+  at::musa::SetMudnnQuantizationInfo(
+      in, input.q_scale(), input.q_zero_point());
+  at::musa::SetMudnnQuantizationInfo(
+      ke, weight.q_scale(), weight.q_zero_point());
+  at::musa::SetMudnnQuantizationInfo(out, output_scale, output_zero_point);
+
+  at::musa::muTensor bmt = (bias.has_value() && bias->numel() != 0)
+      ? at::musa::CreateMUTensor(*bias)
+      : at::musa::CreateEmptyMUTensor();
+  at::musa::muTensor add = at::musa::CreateEmptyMUTensor();
+
+  at::musa::muHandle& h = at::GetMudnnHandle();
+  ::musa::dnn::Convolution op;
+  ConfigConv(
+      op,
+      input.scalar_type(),
+      torch::List<int64_t>({0, 0}),
+      torch::List<int64_t>({1, 1}),
+      torch::List<int64_t>({1, 1}),
+      1);
+  ::musa::dnn::Convolution::FusedActivationDesc act;
+  act.SetMode(::musa::dnn::Convolution::FusedActivationDesc::Mode::RELU);
+  ::musa::dnn::Convolution::Algorithm algorithm =
+      static_cast<::musa::dnn::Convolution::Algorithm>(0);
+  CHECK_MUDNN_STATUS(
+      op.RunFusion(
+          h,
+          out,
+          in,
+          ke,
+          bmt,
+          add,
+          act,
+          algorithm,
+          at::musa::InternalMemAlloc),
+      "RunFusion");
+}
+
+} // anonymous namespace
+
+// muDNN takes a single weight scale per muTensor, so per-channel weights run
+// a plain int8 x int8 -> int32 MatMul and the per-channel scales, bias and
+// activation are folded into the requantization epilogue
+void PackedLinearWeightMudnn::apply_per_channel_helper(
+    at::Tensor& quantized_output,
+    const at::Tensor& input,
+    double output_scale,
+    int64_t output_zero_point,
+    ActMode act_mode) {
+  at::Tensor acc = at::empty(
+      quantized_output.sizes(), at::device(input.device()).dtype(at::kInt));
+
+  at::Tensor contig_input;
+  at::Tensor contig_weight;
+  at::musa::muTensor lmt =
+      at::musa::CreateMUTensor(at::musa::ContiguousRef(input, contig_input));
+  at::musa::muTensor rmt = at::musa::CreateMUTensor(
+      at::musa::ContiguousRef(orig_weight, contig_weight));
+  at::musa::muTensor rst = at::musa::CreateMUTensor(acc);
+
+  at::musa::muHandle& h = at::GetMudnnHandle();
+  ::musa::dnn::MatMul mm;
+  CHECK_MUDNN_STATUS(mm.SetTranspose(false, true), "SetTranspose");
+  CHECK_MUDNN_STATUS(
+      mm.Run(h, rst, lmt, rmt, at::musa::InternalMemAlloc), "Run");
+
+  const int64_t input_zp = input.q_zero_point();
+  at::musa::RequantizePerChannel(
+      quantized_output,
+      acc,
+      input.q_scale(),
+      input_zp,
+      orig_weight.q_per_channel_scales(),
+      input_zp != 0 ? weight_row_sum_ : c10::nullopt,
+      bias_,
+      c10::nullopt,
+      output_scale,
+      output_zero_point,
+      act_mode);
+}
+
 template <bool kReluFused>
 void PackedLinearWeightMudnn::apply_impl_helper(
     at::Tensor& quantized_output,
@@ -23,6 +137,25 @@ void PackedLinearWeightMudnn::apply_impl_helper(
   if (quantized_output.numel() == 0) {
     return;
   }
+  if (at::musa::IsPerChannelQScheme(q_scheme)) {
+    apply_per_channel_helper(
+        quantized_output,
+        input,
+        output_scale,
+        output_zero_point,
+        kReluFused ? ActMode::RELU : ActMode::IDENTITY);
+    return;
+  }
+  if (kReluFused) {
+    QLinearReluAsConv(
+        quantized_output,
+        input,
+        orig_weight,
+        bias_,
+        output_scale,
+        output_zero_point);
+    return;
+  }
   double input_scale = input.q_scale();
   double weight_scale = orig_weight.q_scale();
   int64_t input_zp = input.q_zero_point();
@@ -58,10 +191,6 @@ void PackedLinearWeightMudnn::apply_impl_helper(
         mm.Run(h, rst, lmt, rmt, at::musa::InternalMemAlloc), "Run");
   }
 
-  // ReLU can also be fused into W8A8 kernel in the future
-  if (kReluFused) {
-    quantized_output.relu_();
-  }
   return;
 }
 
@@ -13,15 +13,18 @@
 #endif
 
 #include "torch_musa/csrc/aten/ops/TensorFactory.h"
+#include "torch_musa/csrc/aten/quantized/mudnn/Requantize.h"
 
 struct PackedLinearWeightMudnn : public LinearPackedParamsBase {
   PackedLinearWeightMudnn(
       at::Tensor orig_weight,
       c10::optional<at::Tensor> bias,
-      c10::QScheme q_scheme)
+      c10::QScheme q_scheme,
+      c10::optional<at::Tensor> weight_row_sum = c10::nullopt)
       : orig_weight(std::move(orig_weight)),
         bias_(std::move(bias)),
-        q_scheme(std::move(q_scheme)) {}
+        q_scheme(std::move(q_scheme)),
+        weight_row_sum_(std::move(weight_row_sum)) {}
 
   at::Tensor apply(
       at::Tensor input,
@@ -59,6 +62,9 @@ struct PackedLinearWeightMudnn : public LinearPackedParamsBase {
   at::Tensor orig_weight;
   c10::optional<at::Tensor> bias_;
   c10::QScheme q_scheme;
+  // sum of int8 weights along in_features, only kept for per-channel weights
+  // to fold a non-zero activation zero point into the requantization epilogue
+  c10::optional<at::Tensor> weight_row_sum_;
 
   template <bool ReluFused>
   at::Tensor apply_impl(
@@ -72,4 +78,11 @@ struct PackedLinearWeightMudnn : public LinearPackedParamsBase {
       const at::Tensor& input,
       double output_scale,
       int64_t zero_point);
+
+  void apply_per_channel_helper(
+      at::Tensor& quantized_output,
+      const at::Tensor& input,
+      double output_scale,
+      int64_t output_zero_point,
+      ActMode act_mode);
 };
@@ -12,12 +12,16 @@ c10::intrusive_ptr<LinearPackedParamsBase> PackedLinearWeightMudnn::prepack(
     at::Tensor weight,
     c10::optional<at::Tensor> bias) {
   // TODO(@fan.mo): mudnn now only supports sym quant int8 linear
+  const bool per_channel = at::musa::IsPerChannelQScheme(weight.qscheme());
   TORCH_CHECK(
       weight.qscheme() == c10::kPerTensorSymmetric ||
           (weight.qscheme() == c10::kPerTensorAffine &&
-           weight.q_zero_point() == 0),
+           weight.q_zero_point() == 0) ||
+          (per_channel && weight.q_per_channel_axis() == 0 &&
+           weight.q_per_channel_zero_points().eq(0).all().item<bool>()),
       "Unsupported qscheme: ",
-      toString(weight.qscheme()));
+      toString(weight.qscheme()),
+      ", per-channel weights must be symmetric along output channels");
   TORCH_CHECK(
       weight.scalar_type() == c10::kQInt8,
       "Quantized Linear only supports QInt8 dtype");
@@ -31,8 +35,13 @@ c10::intrusive_ptr<LinearPackedParamsBase> PackedLinearWeightMudnn::prepack(
         "bias should have K elements: " + std::to_string(output_channels));
   }
 
-  auto ret_ptr =
-      c10::make_intrusive<PackedLinearWeightMudnn>(weight, bias, qtype);
+  c10::optional<at::Tensor> weight_row_sum = c10::nullopt;
+  if (per_channel) {
+    weight_row_sum = weight.int_repr().sum(1, /*keepdim=*/false, at::kInt);
+  }
+
+  auto ret_ptr = c10::make_intrusive<PackedLinearWeightMudnn>(
+      weight, bias, qtype, std::move(weight_row_sum));
   return ret_ptr;
 }
 
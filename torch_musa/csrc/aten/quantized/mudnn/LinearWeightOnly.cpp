@@ -0,0 +1,296 @@
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/native/quantized/PackedParams.h>
+#include <torch/library.h>
+
+#include "torch_musa/csrc/aten/quantized/mudnn/LinearWeightOnly.h"
+#include "torch_musa/csrc/aten/utils/Utils.h"
+#include "torch_musa/csrc/core/MUSAGuard.h"
+
+namespace at {
+namespace musa {
+
+void LinearWeightOnlyHostRef(
+    at::Tensor& out,
+    const at::Tensor& input,
+    const at::Tensor& qweight,
+    const at::Tensor& scales,
+    const c10::optional<at::Tensor>& bias,
+    int64_t bits,
+    int64_t group_size) {
+  const int64_t M = input.size(0);
+  const int64_t K = input.size(1);
+  const int64_t N = out.size(1);
+  const int64_t num_groups = K / group_size;
+
+  const auto contig_qweight = qweight.contiguous();
+  const auto contig_scales = scales.contiguous();
+  const float* scales_ptr = contig_scales.data_ptr<float>();
+  const int8_t* q8_ptr = static_cast<const int8_t*>(contig_qweight.data_ptr());
+  const uint8_t* q4_ptr =
+      static_cast<const uint8_t*>(contig_qweight.data_ptr());
+  at::Tensor contig_bias =
+      bias.has_value() ? bias->contiguous() : at::Tensor();
+
+  AT_DISPATCH_FLOATING_TYPES_AND2(
+      at::kHalf,
+      at::kBFloat16,
+      input.scalar_type(),
+      "LinearWeightOnlyHostRef",
+      [&] {
+        const scalar_t* in_ptr = input.data_ptr<scalar_t>();
+        const scalar_t* bias_ptr =
+            contig_bias.defined() ? contig_bias.data_ptr<scalar_t>() : nullptr;
+        scalar_t* out_ptr = out.data_ptr<scalar_t>();
+        at::parallel_for(0, N, 1, [&](int64_t begin, int64_t end) {
+          std::vector<float> acc(M);
+          for (int64_t n = begin; n < end; ++n) {
+            std::fill(acc.begin(), acc.end(), 0.f);
+            for (int64_t k = 0; k < K; ++k) {
+              float q;
+              if (bits == 8) {
+                q = static_cast<float>(q8_ptr[n * K + k]);
+              } else {
+                const uint8_t packed = q4_ptr[(n * K + k) / 2];
+                const int nibble = (k & 1) ? (packed >> 4) : (packed & 0xF);
+                q = static_cast<float>(nibble - 8);
+              }
+              const float w = q * scales_ptr[n * num_groups + k / group_size];
+              for (int64_t m = 0; m < M; ++m) {
+                acc[m] += static_cast<float>(in_ptr[m * K + k]) * w;
+              }
+            }
+            const float b =
+                bias_ptr ? static_cast<float>(bias_ptr[n]) : 0.f;
+            for (int64_t m = 0; m < M; ++m) {
+              out_ptr[m * N + n] = static_cast<scalar_t>(acc[m] + b);
+            }
+          }
+        });
+      });
+}
+
+} // namespace musa
+} // namespace at
+
+c10::intrusive_ptr<LinearPackedParamsBase> PackedLinearWeightOnlyMudnn::prepack(
+    const at::Tensor& weight,
+    c10::optional<at::Tensor> bias,
+    int64_t bits,
+    int64_t group_size) {
+  TORCH_CHECK(
+      bits == 8 || bits == 4,
+      "Weight-only quantized linear supports 8 or 4 bits, but got ",
+      bits);
+  TORCH_CHECK(
+      weight.dim() == 2, "Weight-only quantized linear weight must be 2D");
+  TORCH_CHECK(
+      at::isFloatingType(weight.scalar_type()),
+      "Weight-only quantized linear expects a floating weight, but got ",
+      weight.scalar_type());
+  const int64_t output_channels = weight.size(0);
+  const int64_t input_channels = weight.size(1);
+  if (group_size <= 0) {
+    group_size = input_channels; // per-output-channel
+  }
+  TORCH_CHECK(
+      input_channels % group_size == 0,
+      "in_features (",
+      input_channels,
+      ") must be divisible by group_size (",
+      group_size,
+      ")");
+  TORCH_CHECK(
+      bits == 8 || group_size % 2 == 0,
+      "int4 weight-only linear requires an even group_size");
+  if (bias.has_value()) {
+    TORCH_CHECK(bias.value().dim() == 1, "bias should be a vector (1D Tensor)");
+    TORCH_CHECK(
+        bias.value().size(0) == output_channels,
+        "bias should have K elements: " + std::to_string(output_channels));
+  }
+
+  // symmetric absmax quantization, scale = max(|w|) / qmax per group
+  const int64_t qmax = (1 << (bits - 1)) - 1;
+  const int64_t num_groups = input_channels / group_size;
+  const auto grouped =
+      weight.to(at::kFloat).reshape({output_channels, num_groups, group_size});
+  auto scales =
+      grouped.abs().amax(-1).clamp_min(1e-8).div(static_cast<double>(qmax));
+  auto qweight = grouped.div(scales.unsqueeze(-1))
+                     .round()
+                     .clamp(-qmax - 1, qmax)
+                     .to(at::kChar)
+                     .reshape({output_channels, input_channels});
+  if (bits == 4) {
+    // offset-binary nibbles, two consecutive input channels per byte
+    const auto nibbles = qweight.add(8).to(at::kByte).reshape(
+        {output_channels, input_channels / 2, 2});
+    qweight = nibbles.select(-1, 0)
+                  .bitwise_or(nibbles.select(-1, 1).bitwise_left_shift(4))
+                  .contiguous();
+  }
+
+  return c10::make_intrusive<PackedLinearWeightOnlyMudnn>(
+      qweight.contiguous(),
+      scales.contiguous(),
+      bias,
+      bits,
+      group_size,
+      input_channels);
+}
+
+at::Tensor PackedLinearWeightOnlyMudnn::dequantize_weight() const {
+  const int64_t output_channels = qweight_.size(0);
+  at::Tensor q;
+  if (bits_ == 8) {
+    q = qweight_.to(at::kFloat);
+  } else {
+    const auto low = qweight_.bitwise_and(0xF);
+    const auto high = qweight_.bitwise_right_shift(4);
+    q = at::stack({low, high}, -1)
+            .reshape({output_channels, in_features_})
+            .to(at::kFloat)
+            .sub(8);
+  }
+  return q.reshape({output_channels, -1, group_size_})
+      .mul(scales_.unsqueeze(-1))
+      .reshape({output_channels, in_features_});
+}
+
+std::tuple<at::Tensor, c10::optional<at::Tensor>> PackedLinearWeightOnlyMudnn::
+    unpack() {
+  return std::tuple<at::Tensor, c10::optional<at::Tensor>>{
+      dequantize_weight(), bias_};
+}
+
+at::Tensor PackedLinearWeightOnlyMudnn::apply_weight_only(
+    const at::Tensor& input) {
+  TORCH_CHECK(
+      input.scalar_type() == at::kHalf ||
+          input.scalar_type() == at::kBFloat16 ||
+          input.scalar_type() == at::kFloat,
+      "Weight-only quantized linear supports Half, BFloat16 and Float "
+      "activations, but got ",
+      input.scalar_type());
+  TORCH_CHECK(
+      input.dim() >= 1 && input.size(-1) == in_features_,
+      "Expected the last dimension of input to be ",
+      in_features_,
+      ", but got input of shape ",
+      input.sizes());
+  TORCH_CHECK(
+      input.device() == qweight_.device(),
+      "Input and packed weight of weight-only linear must be on the same "
+      "device, but got ",
+      input.device(),
+      " and ",
+      qweight_.device());
+
+  const int64_t output_channels = qweight_.size(0);
+  std::vector<int64_t> output_shape{input.sizes().vec()};
+  output_shape.back() = output_channels;
+
+  const auto input_2d = input.reshape({-1, in_features_}).contiguous();
+  const int64_t M = input_2d.size(0);
+  c10::optional<at::Tensor> bias = c10::nullopt;
+  if (bias_.has_value()) {
+    bias = bias_->to(input.scalar_type()).contiguous();
+  }
+
+  at::Tensor output;
+  if (M == 0) {
+    output = at::empty({0, output_channels}, input.options());
+  } else if (!at::musa::is_musa(input)) {
+    output = at::empty({M, output_channels}, input.options());
+    at::musa::LinearWeightOnlyHostRef(
+        output, input_2d, qweight_, scales_, bias, bits_, group_size_);
+  } else if (M <= at::musa::kWeightOnlyMaxDecodeRows) {
+    output = at::empty({M, output_channels}, input.options());
+    at::musa::LinearWeightOnlyKernel(
+        output, input_2d, qweight_, scales_, bias, bits_, group_size_);
+  } else {
+    // compute-bound prefill shapes, one dequantization then muDNN MatMul
+    const auto weight = dequantize_weight().to(input.scalar_type());
+    output = at::linear(input_2d, weight, bias);
+  }
+  return output.view(output_shape);
+}
+
+namespace at {
+namespace musa {
+namespace {
+
+class QLinearWeightOnlyPackWeight final {
+ public:
+  static c10::intrusive_ptr<LinearPackedParamsBase> run(
+      at::Tensor weight,
+      c10::optional<Tensor> bias,
+      int64_t bits,
+      int64_t group_size) {
+    const OptionalDeviceGuard device_guard(device_of(weight));
+    return PackedLinearWeightOnlyMudnn::prepack(
+        weight, std::move(bias), bits, group_size);
+  }
+};
+
+class QLinearWeightOnly final {
+ public:
+  static at::Tensor run(
+      at::Tensor input,
+      const c10::intrusive_ptr<LinearPackedParamsBase>& packed_weight) {
+    const OptionalDeviceGuard device_guard(device_of(input));
+    auto* weight_only =
+        dynamic_cast<PackedLinearWeightOnlyMudnn*>(packed_weight.get());
+    TORCH_CHECK(
+        weight_only != nullptr,
+        "quantized::linear_weight_only expects packed params created by "
+        "quantized::linear_weight_only_prepack");
+    return weight_only->apply_weight_only(input);
+  }
+};
+
+class QLinearDynamic final {
+ public:
+  static at::Tensor run(
+      at::Tensor input,
+      const c10::intrusive_ptr<LinearPackedParamsBase>& packed_weight,
+      bool reduce_range) {
+    c10::musa::MUSAGuard device_guard(input.device());
+    return packed_weight->apply_dynamic(std::move(input), reduce_range);
+  }
+};
+
+TORCH_LIBRARY_FRAGMENT(quantized, m) {
+  m.def(TORCH_SELECTIVE_SCHEMA(
+      "quantized::linear_weight_only_prepack(Tensor W, Tensor? B=None, int bits=8, int group_size=-1) -> __torch__.torch.classes.quantized.LinearPackedParamsBase W_prepack"));
+  m.def(TORCH_SELECTIVE_SCHEMA(
+      "quantized::linear_weight_only(Tensor X, __torch__.torch.classes.quantized.LinearPackedParamsBase W_prepack) -> Tensor Y"));
+}
+
+TORCH_LIBRARY_IMPL(quantized, PrivateUse1, m) {
+  m.impl(
+      TORCH_SELECTIVE_NAME("quantized::linear_weight_only_prepack"),
+      TORCH_FN(QLinearWeightOnlyPackWeight::run));
+  m.impl(
+      TORCH_SELECTIVE_NAME("quantized::linear_weight_only"),
+      TORCH_FN(QLinearWeightOnly::run));
+  m.impl(
+      TORCH_SELECTIVE_NAME("quantized::linear_dynamic"),
+      TORCH_FN(QLinearDynamic::run));
+}
+
+// host reference path, used to validate the device kernel
+TORCH_LIBRARY_IMPL(quantized, CPU, m) {
+  m.impl(
+      TORCH_SELECTIVE_NAME("quantized::linear_weight_only_prepack"),
+      TORCH_FN(QLinearWeightOnlyPackWeight::run));
+  m.impl(
+      TORCH_SELECTIVE_NAME("quantized::linear_weight_only"),
+      TORCH_FN(QLinearWeightOnly::run));
+}
+
+} // namespace
+} // namespace musa
+} // namespace at
@@ -0,0 +1,127 @@
+#ifndef TORCH_MUSA_CSRC_ATEN_QUANTIZED_MUDNN_LINEARWEIGHTONLY_H_
+#define TORCH_MUSA_CSRC_ATEN_QUANTIZED_MUDNN_LINEARWEIGHTONLY_H_
+
+#include <ATen/Tensor.h>
+#include <ATen/native/quantized/PackedParams.h>
+#include <c10/util/Optional.h>
+
+namespace at {
+namespace musa {
+
+// Decode-shaped problems (M <= kWeightOnlyMaxDecodeRows) go through the
+// dequantize-in-GEMM kernel, larger ones dequantize the weight once and run
+// the fp16/bf16 muDNN MatMul.
+constexpr int64_t kWeightOnlyMaxDecodeRows = 16;
+
+// out[M, N] = input[M, K] @ dequant(qweight)[N, K]^T (+ bias)
+// qweight is int8 [N, K] when bits == 8, or uint8 [N, K / 2] holding two
+// offset-binary int4 values per byte (low nibble first) when bits == 4.
+// scales is float32 [N, K / group_size], whatever the activation dtype.
+void LinearWeightOnlyKernel(
+    at::Tensor& out,
+    const at::Tensor& input,
+    const at::Tensor& qweight,
+    const at::Tensor& scales,
+    const c10::optional<at::Tensor>& bias,
+    int64_t bits,
+    int64_t group_size);
+
+// Host reference of LinearWeightOnlyKernel, used for validation. It
+// accumulates in float too, but in another order than the device reduction,
+// so results agree within rounding rather than bit for bit.
+void LinearWeightOnlyHostRef(
+    at::Tensor& out,
+    const at::Tensor& input,
+    const at::Tensor& qweight,
+    const at::Tensor& scales,
+    const c10::optional<at::Tensor>& bias,
+    int64_t bits,
+    int64_t group_size);
+
+} // namespace musa
+} // namespace at
+
+// Weight-only quantized linear: activations stay in fp16/bf16/fp32, weights
+// are stored as symmetric per-channel (group_size == in_features) or
+// group-wise int8/int4 and dequantized inside the GEMM.
+struct PackedLinearWeightOnlyMudnn : public LinearPackedParamsBase {
+  PackedLinearWeightOnlyMudnn(
+      at::Tensor qweight,
+      at::Tensor scales,
+      c10::optional<at::Tensor> bias,
+      int64_t bits,
+      int64_t group_size,
+      int64_t in_features)
+      : qweight_(std::move(qweight)),
+        scales_(std::move(scales)),
+        bias_(std::move(bias)),
+        bits_(bits),
+        group_size_(group_size),
+        in_features_(in_features) {}
+
+  at::Tensor apply(
+      at::Tensor input,
+      double output_scale,
+      int64_t output_zero_point) override {
+    TORCH_CHECK(
+        false,
+        "Weight-only packed params expect floating activations, "
+        "use quantized::linear_weight_only instead");
+  }
+  at::Tensor apply_relu(
+      at::Tensor input,
+      double output_scale,
+      int64_t output_zero_point) override {
+    TORCH_CHECK(
+        false,
+        "Weight-only packed params expect floating activations, "
+        "use quantized::linear_weight_only instead");
+  }
+
+  // activations are never quantized, so the dynamic entries map directly
+  // onto the weight-only GEMM
+  at::Tensor apply_dynamic(at::Tensor input, bool reduce_range = false)
+      override {
+    return apply_weight_only(input);
+  }
+  at::Tensor apply_dynamic_relu(at::Tensor input, bool reduce_range = false)
+      override {
+    return apply_weight_only(input).relu_();
+  }
+
+  at::Tensor apply_weight_only(const at::Tensor& input);
+
+  // returns the dequantized floating weight, int4 weights have no quantized
+  // tensor counterpart in PyTorch
+  std::tuple<at::Tensor, c10::optional<at::Tensor>> unpack() override;
+
+  c10::optional<at::Tensor> bias() override {
+    return bias_;
+  }
+
+  int64_t bits() const {
+    return bits_;
+  }
+
+  int64_t group_size() const {
+    return group_size_;
+  }
+
+  static c10::intrusive_ptr<LinearPackedParamsBase> prepack(
+      const at::Tensor& weight,
+      c10::optional<at::Tensor> bias,
+      int64_t bits,
+      int64_t group_size);
+
+ private:
+  at::Tensor qweight_;
+  at::Tensor scales_;
+  c10::optional<at::Tensor> bias_;
+  int64_t bits_;
+  int64_t group_size_;
+  int64_t in_features_;
+
+  at::Tensor dequantize_weight() const;
+};
+
+#endif // TORCH_MUSA_CSRC_ATEN_QUANTIZED_MUDNN_LINEARWEIGHTONLY_H_
@@ -0,0 +1,41 @@
+#ifndef TORCH_MUSA_CSRC_ATEN_QUANTIZED_MUDNN_REQUANTIZE_H_
+#define TORCH_MUSA_CSRC_ATEN_QUANTIZED_MUDNN_REQUANTIZE_H_
+
+#include <ATen/Tensor.h>
+#include <c10/util/Optional.h>
+
+enum class ActMode { IDENTITY, RELU, SILU };
+
+namespace at {
+namespace musa {
+
+inline bool IsPerChannelQScheme(c10::QScheme qscheme) {
+  return qscheme == c10::kPerChannelAffine ||
+      qscheme == c10::kPerChannelSymmetric ||
+      qscheme == c10::kPerChannelAffineFloatQParams;
+}
+
+// Fused requantization epilogue for per-channel quantized weights, muDNN runs
+// the int8 x int8 -> int32 GEMM/conv and this kernel folds the per-channel
+// weight scales in:
+//   v = (acc - input_zp * weight_row_sum[c]) * input_scale * weight_scale[c]
+//       + bias[c] + dequant(accum)
+//   out = clamp(round(act(v) / output_scale) + output_zp)
+// acc/out/accum are dense with the channel dimension innermost.
+void RequantizePerChannel(
+    Tensor& quantized_output,
+    const Tensor& acc,
+    double input_scale,
+    int64_t input_zero_point,
+    const Tensor& weight_scales,
+    const c10::optional<Tensor>& weight_row_sum,
+    const c10::optional<Tensor>& bias,
+    const c10::optional<Tensor>& accum,
+    double output_scale,
+    int64_t output_zero_point,
+    ActMode act_mode);
+
+} // namespace musa
+} // namespace at
+
+#endif // TORCH_MUSA_CSRC_ATEN_QUANTIZED_MUDNN_REQUANTIZE_H_
@@ -5,7 +5,11 @@
 #include <torch/csrc/utils/pybind.h>
 #include <torch/csrc/utils/pycfunction_helpers.h>
 
+#include <cstdlib>
+#include <string>
+
 #include "torch_musa/csrc/aten/utils/Context.h"
+#include "torch_musa/csrc/aten/mudnn/ConvAlgoCache.h"
 
 namespace at {
 namespace musa {
@@ -37,6 +41,35 @@ void Context::SetAllowTF32(bool allow_tf32) {
   allow_tf32_ = allow_tf32;
 }
 
+bool Context::GetBenchmark() const {
+  return benchmark_.load(std::memory_order_relaxed);
+}
+
+void Context::SetBenchmark(bool benchmark) {
+  benchmark_.store(benchmark, std::memory_order_relaxed);
+}
+
+size_t Context::GetBenchmarkWorkspaceLimit() const {
+  return benchmark_workspace_limit_.load(std::memory_order_relaxed);
+}
+
+void Context::SetBenchmarkWorkspaceLimit(size_t limit) {
+  benchmark_workspace_limit_.store(limit, std::memory_order_relaxed);
+}
+
+bool Context::GetOpCache() const {
+  return op_cache_.load(std::memory_order_relaxed);
+}
+
+void Context::SetOpCache(bool enabled) {
+  op_cache_.store(enabled, std::memory_order_relaxed);
+}
+
+bool Context::OpCacheEnabledByEnv() {
+  const char* env = std::getenv("TORCH_MUSA_MUDNN_OP_CACHE");
+  return env == nullptr || std::string(env) != "0";
+}
+
 PyObject* THPModuleSetAllowTF32(PyObject* /*unused*/, PyObject* arg) {
   THPUtils_assert(
       PyBool_Check(arg),
@@ -54,9 +87,129 @@ PyObject* THPModuleGetAllowTF32(PyObject* /*_unused*/, PyObject* /*_unused*/) {
     Py_RETURN_FALSE;
 }
 
+PyObject* THPModuleSetBenchmark(PyObject* /*unused*/, PyObject* arg) {
+  THPUtils_assert(
+      PyBool_Check(arg),
+      "set_benchmark_mudnn expects a bool, "
+      "but got %s",
+      THPUtils_typename(arg));
+  at::musa::GlobalContext().SetBenchmark(arg == Py_True);
+  Py_RETURN_NONE;
+}
+
+PyObject* THPModuleGetBenchmark(PyObject* /*_unused*/, PyObject* /*_unused*/) {
+  if (at::musa::GlobalContext().GetBenchmark())
+    Py_RETURN_TRUE;
+  else
+    Py_RETURN_FALSE;
+}
+
+PyObject* THPModuleSetBenchmarkWorkspaceLimit(
+    PyObject* /*unused*/,
+    PyObject* arg) {
+  THPUtils_assert(
+      THPUtils_checkLong(arg),
+      "set_benchmark_workspace_limit expects an int, "
+      "but got %s",
+      THPUtils_typename(arg));
+  const auto limit = THPUtils_unpackLong(arg);
+  THPUtils_assert(
+      limit >= 0, "benchmark workspace limit must be non-negative");
+  at::musa::GlobalContext().SetBenchmarkWorkspaceLimit(
+      static_cast<size_t>(limit));
+  Py_RETURN_NONE;
+}
+
+PyObject* THPModuleGetBenchmarkWorkspaceLimit(
+    PyObject* /*_unused*/,
+    PyObject* /*_unused*/) {
+  return THPUtils_packUInt64(
+      at::musa::GlobalContext().GetBenchmarkWorkspaceLimit());
+}
+
+PyObject* THPModuleSetOpCache(PyObject* /*unused*/, PyObject* arg) {
+  THPUtils_assert(
+      PyBool_Check(arg),
+      "set_mudnn_op_cache expects a bool, "
+      "but got %s",
+      THPUtils_typename(arg));
+  at::musa::GlobalContext().SetOpCache(arg == Py_True);
+  Py_RETURN_NONE;
+}
+
+PyObject* THPModuleGetOpCache(PyObject* /*_unused*/, PyObject* /*_unused*/) {
+  if (at::musa::GlobalContext().GetOpCache())
+    Py_RETURN_TRUE;
+  else
+    Py_RETURN_FALSE;
+}
+
+PyObject* THPModuleConvAlgoCacheSave(PyObject* /*unused*/, PyObject* arg) {
+  HANDLE_TH_ERRORS
+  THPUtils_assert(
+      THPUtils_checkString(arg),
+      "conv algorithm cache path must be a str, but got %s",
+      THPUtils_typename(arg));
+  at::musa::ConvAlgoCache::Instance().Save(THPUtils_unpackString(arg));
+  Py_RETURN_NONE;
+  END_HANDLE_TH_ERRORS
+}
+
+PyObject* THPModuleConvAlgoCacheLoad(PyObject* /*unused*/, PyObject* arg) {
+  HANDLE_TH_ERRORS
+  THPUtils_assert(
+      THPUtils_checkString(arg),
+      "conv algorithm cache path must be a str, but got %s",
+      THPUtils_typename(arg));
+  at::musa::ConvAlgoCache::Instance().Load(THPUtils_unpackString(arg));
+  Py_RETURN_NONE;
+  END_HANDLE_TH_ERRORS
+}
+
+PyObject* THPModuleConvAlgoCacheClear(
+    PyObject* /*_unused*/,
+    PyObject* /*_unused*/) {
+  at::musa::ConvAlgoCache::Instance().Clear();
+  Py_RETURN_NONE;
+}
+
+PyObject* THPModuleConvAlgoCacheSize(
+    PyObject* /*_unused*/,
+    PyObject* /*_unused*/) {
+  return THPUtils_packUInt64(at::musa::ConvAlgoCache::Instance().Size());
+}
+
 static PyMethodDef ContextMethods[] = { // NOLINT
     {"_get_allow_tf32", THPModuleGetAllowTF32, METH_NOARGS, nullptr},
     {"_set_allow_tf32", THPModuleSetAllowTF32, METH_O, nullptr},
+    {"_get_mudnn_benchmark", THPModuleGetBenchmark, METH_NOARGS, nullptr},
+    {"_set_mudnn_benchmark", THPModuleSetBenchmark, METH_O, nullptr},
+    {"_get_mudnn_benchmark_workspace_limit",
+     THPModuleGetBenchmarkWorkspaceLimit,
+     METH_NOARGS,
+     nullptr},
+    {"_set_mudnn_benchmark_workspace_limit",
+     THPModuleSetBenchmarkWorkspaceLimit,
+     METH_O,
+     nullptr},
+    {"_get_mudnn_op_cache", THPModuleGetOpCache, METH_NOARGS, nullptr},
+    {"_set_mudnn_op_cache", THPModuleSetOpCache, METH_O, nullptr},
+    {"_mudnn_conv_algo_cache_save",
+     THPModuleConvAlgoCacheSave,
+     METH_O,
+     nullptr},
+    {"_mudnn_conv_algo_cache_load",
+     THPModuleConvAlgoCacheLoad,
+     METH_O,
+     nullptr},
+    {"_mudnn_conv_algo_cache_clear",
+     THPModuleConvAlgoCacheClear,
+     METH_NOARGS,
+     nullptr},
+    {"_mudnn_conv_algo_cache_size",
+     THPModuleConvAlgoCacheSize,
+     METH_NOARGS,
+     nullptr},
     {nullptr, nullptr, 0, nullptr}};
 
 PyMethodDef* GetContextMethods() {
@@ -5,6 +5,8 @@
 #include <c10/util/CallOnce.h>
 #include <mudnn.h>
 
+#include <atomic>
+
 #include "torch_musa/csrc/aten/utils/Utils.h"
 #include "torch_musa/csrc/core/MUSAHooksInterface.h"
 
@@ -31,9 +33,30 @@ class Context {
   // Set the allow_tf32 flag.
   void SetAllowTF32(bool allow_tf32);
 
+  // Benchmark mode times every muDNN convolution algorithm once per problem
+  // and caches the fastest, see ConvAlgoCache.h.
+  bool GetBenchmark() const;
+  void SetBenchmark(bool benchmark);
+
+  // Upper bound in bytes of the workspace a benchmarked candidate may use,
+  // 0 means unlimited.
+  size_t GetBenchmarkWorkspaceLimit() const;
+  void SetBenchmarkWorkspaceLimit(size_t limit);
+
+  // Reuse configured muDNN operator descriptors and muTensor layouts across
+  // calls with the same signature, see OpCache.h.
+  bool GetOpCache() const;
+  void SetOpCache(bool enabled);
+
  private:
   // TF32 is disabled by default to keep consistent to official PyTorch.
   bool allow_tf32_ = false;
+  std::atomic<bool> benchmark_{false};
+  std::atomic<size_t> benchmark_workspace_limit_{size_t(1) << 30};
+  // enabled unless TORCH_MUSA_MUDNN_OP_CACHE=0
+  std::atomic<bool> op_cache_{OpCacheEnabledByEnv()};
+
+  static bool OpCacheEnabledByEnv();
   c10::once_flag musa_init_;
 };
 
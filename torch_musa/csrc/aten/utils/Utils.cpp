@@ -12,7 +12,9 @@
 #include <ATen/ops/as_strided.h>
 #endif
 
+#include "torch_musa/csrc/aten/mudnn/OpCache.h"
 #include "torch_musa/csrc/aten/ops/TensorFactory.h"
+#include "torch_musa/csrc/aten/utils/Context.h"
 #include "torch_musa/csrc/aten/utils/Utils.h"
 #include "torch_musa/csrc/core/Allocator.h"
 
@@ -35,14 +37,17 @@ Tensor empty_strided_musa(
 }
 } // namespace
 
-void ConfigFormat(
+namespace {
+
+struct MuTensorLayout {
+  muTensor::Format format;
+  DimVector sizes;
+  DimVector strides;
+};
+
+MuTensorLayout ComputeMuTensorLayout(
     const Tensor& t,
-    muTensor& mt,
     bool permute_if_not_contiguous) {
-  TORCH_CHECK(
-      t.dim() <= 8,
-      "mudnn only support intput tensors'dim <= 8, but it is ",
-      t.dim());
   const auto t_dim = t.dim();
   const auto memory_format = t.suggest_memory_format();
   muTensor::Format mudnn_format = muTensor::Format::NCHW;
@@ -71,9 +76,37 @@ void ConfigFormat(
       }
     }
   }
+  return {mudnn_format, DimVector(mu_t.sizes()), DimVector(mu_t.strides())};
+}
+
+} // namespace
 
-  mt.SetFormat(mudnn_format);
-  mt.SetNdInfo(mu_t.dim(), mu_t.sizes().data(), mu_t.strides().data());
+void ConfigFormat(
+    const Tensor& t,
+    muTensor& mt,
+    bool permute_if_not_contiguous) {
+  TORCH_CHECK(
+      t.dim() <= 8,
+      "mudnn only support intput tensors'dim <= 8, but it is ",
+      t.dim());
+  if (GlobalContext().GetOpCache()) {
+    // the layout only depends on sizes and strides, caching it skips
+    // suggest_memory_format and the permuted views on repeated shapes
+    MudnnOpKey key(MudnnOpKind::TENSOR_LAYOUT);
+    key.Add(t.sizes()).Add(t.strides()).Add(
+        static_cast<int64_t>(permute_if_not_contiguous));
+    const auto& layout =
+        ThreadLocalMudnnOpCache<MuTensorLayout>().GetOrCreate(key, [&]() {
+          return ComputeMuTensorLayout(t, permute_if_not_contiguous);
+        });
+    mt.SetFormat(layout.format);
+    mt.SetNdInfo(
+        layout.sizes.size(), layout.sizes.data(), layout.strides.data());
+    return;
+  }
+  const auto layout = ComputeMuTensorLayout(t, permute_if_not_contiguous);
+  mt.SetFormat(layout.format);
+  mt.SetNdInfo(layout.sizes.size(), layout.sizes.data(), layout.strides.data());
 }
 
 void SetMUTensorDType(ScalarType dtype, muTensor& m_t) {
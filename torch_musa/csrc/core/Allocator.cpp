@@ -52,7 +52,7 @@ namespace MUSACachingAllocator {
 namespace {
 
 // TODO(yang.zhao):
-//    1. Add members and functions to support MUSA graphs, events and streams.
+//    1. Add members and functions to support events and streams.
 //    2. Modify block-related hyper-params to fit MTGPU (need experiments).
 //    3. Add a allocator-vector to manage multiple devices.
 //    4. Add c10::reportMemoryUsageToProfiler() when python API allows.
@@ -119,13 +119,18 @@ void update_stat_array(
 }
 
 struct Block;
+struct PrivatePool;
 typedef bool (*Comparison)(const Block*, const Block*);
 
 struct BlockPool {
-  BlockPool(Comparison comparator, bool small)
-      : blocks(comparator), is_small(small) {}
+  BlockPool(
+      Comparison comparator,
+      bool small,
+      PrivatePool* private_pool = nullptr)
+      : blocks(comparator), is_small(small), owner_PrivatePool(private_pool) {}
   std::set<Block*, Comparison> blocks;
   const bool is_small;
+  PrivatePool* owner_PrivatePool;
 };
 
 struct HistoryChain {
@@ -188,6 +193,30 @@ static bool BlockComparator(const Block* a, const Block* b) {
   return (uintptr_t)a->ptr < (uintptr_t)b->ptr;
 }
 
+// Memory of MUSA graph captures. Blocks allocated while a capture is underway
+// come from the private pool of that capture and are only ever reused by
+// captures sharing the pool, so that replays never race with eager work.
+struct PrivatePool {
+  PrivatePool()
+      : large_blocks(BlockComparator, /*is_small=*/false, this),
+        small_blocks(BlockComparator, /*is_small=*/true, this) {}
+  PrivatePool(const PrivatePool&) = delete;
+  PrivatePool& operator=(const PrivatePool&) = delete;
+  // Number of live graphs using this pool
+  int use_count{1};
+  // Number of unfreed musaMallocs made for this pool. When use_count and
+  // musaMalloc_count drop to zero, we can delete this PrivatePool.
+  int musaMalloc_count{0};
+  BlockPool large_blocks;
+  BlockPool small_blocks;
+};
+
+struct MempoolIdHash {
+  std::size_t operator()(const MempoolId_t& mempool_id) const noexcept {
+    return mempool_id.first != 0 ? mempool_id.first : mempool_id.second;
+  }
+};
+
 struct AllocParams {
   AllocParams(
       int device,
@@ -432,6 +461,19 @@ class MTGPUCachingAllocator {
 
   std::vector<OutOfMemoryObserver> oom_observers_;
 
+  // Private pools of MUSA graphs
+  ska::flat_hash_map<MempoolId_t, std::unique_ptr<PrivatePool>, MempoolIdHash>
+      graph_pools_;
+  // Pools no longer referenced by any graph. Their cached blocks are freed by
+  // release_cached_blocks(), the pool itself once all its blocks are freed.
+  ska::flat_hash_map<MempoolId_t, PrivatePool*, MempoolIdHash>
+      graph_pools_freeable_;
+  // Maps a capture id to the private pool its allocations are drawn from
+  ska::flat_hash_map<CaptureId_t, MempoolId_t> capture_to_pool_map_;
+  // musaEventRecord/Query are illegal while a capture is underway, frees of
+  // blocks used on other streams record their events after the capture ends
+  std::vector<Block*> needs_events_deferred_until_no_capture_;
+
  public:
   MTGPUCachingAllocator()
       : large_blocks_(BlockComparator, /*is_small=*/false),
@@ -467,10 +509,13 @@ class MTGPUCachingAllocator {
     std::shared_ptr<Context> context =
         context_recorder ? context_recorder() : nullptr;
     std::unique_lock<std::recursive_mutex> lock(mutex_);
-    process_events();
+    if (C10_LIKELY(capture_to_pool_map_.empty())) {
+      // process_events queries musaEvents, which is illegal during capture
+      process_events();
+    }
 
     size_t size = round_size(orig_size);
-    BlockPool& pool = get_pool(size);
+    BlockPool& pool = get_pool(size, stream);
     const size_t alloc_size = get_allocation_size(size);
     AllocParams params(device, size, stream, &pool, alloc_size, stats_);
     params.stat_types[static_cast<size_t>(StatType::AGGREGATE)] = true;
@@ -485,9 +530,12 @@ class MTGPUCachingAllocator {
 
     // Can't reuse an existing block; try to get a new one.
     if (!block_found) {
+      // Releasing cached blocks synchronizes events and frees memory, both
+      // of which would invalidate a capture that is underway.
+      const bool no_capture_underway = capture_to_pool_map_.empty();
       // Do garbage collection if the flag is set.
       if (C10_UNLIKELY(
-              set_fraction_ &&
+              no_capture_underway && set_fraction_ &&
               CachingAllocatorConfig::garbage_collection_threshold() > 0.0)) {
         garbage_collect_cached_blocks();
       }
@@ -495,10 +543,12 @@ class MTGPUCachingAllocator {
       block_found = alloc_block(params, false)
           // Free enough available cached blocks to satisfy alloc and retry
           // alloc.
-          || (release_available_cached_blocks(params) &&
+          || (C10_LIKELY(no_capture_underway) &&
+              release_available_cached_blocks(params) &&
               alloc_block(params, false))
           // Free all non-split cached blocks and retry alloc.
-          || (release_cached_blocks() && alloc_block(params, true));
+          || (C10_LIKELY(no_capture_underway) && release_cached_blocks() &&
+              alloc_block(params, true));
 
       if (record_history && block_found) {
         record_trace(
@@ -710,7 +760,11 @@ class MTGPUCachingAllocator {
       update_stat(stats_.oversize_allocations, -1);
 
     if (!block->stream_uses.empty()) {
-      insert_events(block);
+      if (C10_UNLIKELY(!capture_to_pool_map_.empty())) {
+        needs_events_deferred_until_no_capture_.push_back(block);
+      } else {
+        insert_events(block);
+      }
     } else {
       free_block(block);
     }
@@ -760,7 +814,19 @@ class MTGPUCachingAllocator {
     return event_pool->get(idx);
   }
 
+  void insert_events_deferred_until_no_capture() {
+    if (C10_UNLIKELY(!needs_events_deferred_until_no_capture_.empty())) {
+      for (auto* block : needs_events_deferred_until_no_capture_) {
+        TORCH_INTERNAL_ASSERT(!block->stream_uses.empty());
+        insert_events(block);
+      }
+      needs_events_deferred_until_no_capture_.clear();
+    }
+  }
+
   void process_events() {
+    insert_events_deferred_until_no_capture();
+
     // Process outstanding musaEvents. Events that are completed are
     // removed from the queue, and the 'event_count' for the
     // corresponding allocation is decremented. We maintain a separate
@@ -1153,7 +1219,24 @@ class MTGPUCachingAllocator {
     return subsumed_size;
   }
 
-  BlockPool& get_pool(size_t size) {
+  BlockPool& get_pool(size_t size, musaStream_t stream) {
+    if (C10_UNLIKELY(!capture_to_pool_map_.empty())) {
+      // an allocation on a capturing stream goes to the capture's pool
+      musaStreamCaptureStatus status;
+      CaptureId_t id = 0;
+      TORCH_MUSA_CHECK(musaStreamGetCaptureInfo(stream, &status, &id));
+      if (status != musaStreamCaptureStatusNone) {
+        auto it0 = capture_to_pool_map_.find(id);
+        TORCH_INTERNAL_ASSERT(it0 != capture_to_pool_map_.end());
+        auto it1 = graph_pools_.find(it0->second);
+        TORCH_INTERNAL_ASSERT(it1 != graph_pools_.end());
+        if (size <= kMaxSmallAlloc) {
+          return it1->second->small_blocks;
+        } else {
+          return it1->second->large_blocks;
+        }
+      }
+    }
     if (size <= kMaxSmallAlloc) {
       return small_blocks_;
     } else {
@@ -1323,6 +1406,11 @@ class MTGPUCachingAllocator {
       }
     }
 
+    if (p.pool->owner_PrivatePool) {
+      // The block is for a MUSA graph's PrivatePool.
+      p.pool->owner_PrivatePool->musaMalloc_count++;
+    }
+
     total_allocated_memory_ += size;
     p.block = new Block(p.device(), p.stream(), size, p.pool, (char*)ptr);
     for_each_selected_stat_type(p.stat_types, [&](size_t stat_type) {
@@ -1390,15 +1478,88 @@ class MTGPUCachingAllocator {
     release_blocks(large_blocks_);
     release_blocks(small_blocks_);
 
+    for (auto it = graph_pools_freeable_.begin();
+         it != graph_pools_freeable_.end();) {
+      // See notifyCaptureDestroy for the strategy here.
+      TORCH_INTERNAL_ASSERT(it->second->use_count == 0);
+      release_blocks(it->second->small_blocks);
+      release_blocks(it->second->large_blocks);
+      if (it->second->musaMalloc_count == 0) {
+        auto erase_count = graph_pools_.erase(it->first);
+        TORCH_INTERNAL_ASSERT(erase_count == 1);
+        it = graph_pools_freeable_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+
     return true;
   }
 
+  // Called by MUSAGraph::capture_begin once the capture stream is capturing.
+  void notify_capture_begin(CaptureId_t graph_id, MempoolId_t mempool_id) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    auto it = graph_pools_.find(mempool_id);
+    if (it == graph_pools_.end()) {
+      // mempool_id does not reference an existing pool. Make a new pool for
+      // this capture.
+      graph_pools_.emplace(mempool_id, std::make_unique<PrivatePool>());
+    } else {
+      // mempool_id references an existing pool, which the current capture
+      // will share. Check this pool is live (at least one other capture
+      // already references it).
+      TORCH_INTERNAL_ASSERT(it->second->use_count > 0);
+      it->second->use_count++;
+    }
+    auto inserted = capture_to_pool_map_.insert({graph_id, mempool_id});
+    TORCH_INTERNAL_ASSERT(inserted.second);
+  }
+
+  // Called by MUSAGraph::capture_end before the capture stream stops
+  // capturing, later allocations on it go to the regular pools again.
+  void notify_capture_about_to_end(CaptureId_t graph_id) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    auto it = capture_to_pool_map_.find(graph_id);
+    TORCH_INTERNAL_ASSERT(it != capture_to_pool_map_.end());
+    capture_to_pool_map_.erase(it);
+  }
+
+  // Called by MUSAGraph::reset
+  void notify_capture_destroy(MempoolId_t mempool_id) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    // The instantiated musaGraphExec_t has been destroyed. We can't blindly
+    // delete and musaFree the mempool its capture used, because
+    //  1. other graph(s) might share the same pool
+    //  2. the user might still hold references to output tensors allocated
+    //  during capture.
+    // To handle 1 and 2, we track the number of graphs using this particular
+    // mempool. When the count reaches 0, we tell free_cached_blocks it may
+    // now musaFree blocks from this graph's pool when it discovers they're
+    // unused (unsplit).
+    auto it = graph_pools_.find(mempool_id);
+    TORCH_INTERNAL_ASSERT(it != graph_pools_.end());
+    auto uc = --(it->second->use_count);
+    TORCH_INTERNAL_ASSERT(uc >= 0);
+    if (uc == 0) {
+      // Allows free_cached_blocks to begin musaFreeing this pool's memory,
+      // and makes sure this pool wasn't somehow made freeable already.
+      bool inserted =
+          graph_pools_freeable_.insert({mempool_id, it->second.get()}).second;
+      TORCH_INTERNAL_ASSERT(inserted);
+    }
+  }
+
   void release_block(Block* block) {
     auto err = musaFree((void*)block->ptr);
     TORCH_CHECK(err == musaSuccess, "Musa Tensor Release failed!");
     total_allocated_memory_ -= block->size;
 
     BlockPool* pool = block->pool;
+    if (pool->owner_PrivatePool) {
+      // The musaFreed block belonged to a MUSA graph's PrivatePool.
+      TORCH_INTERNAL_ASSERT(pool->owner_PrivatePool->musaMalloc_count > 0);
+      pool->owner_PrivatePool->musaMalloc_count--;
+    }
 
     StatTypes stat_types = {false};
     stat_types[static_cast<size_t>(StatType::AGGREGATE)] = true;
@@ -1635,6 +1796,21 @@ class MusaCachingAllocatorImpl {
     }
   }
 
+  void notify_capture_begin(
+      int device,
+      CaptureId_t graph_id,
+      MempoolId_t mempool_id) {
+    device_allocator_[device]->notify_capture_begin(graph_id, mempool_id);
+  }
+
+  void notify_capture_about_to_end(int device, CaptureId_t graph_id) {
+    device_allocator_[device]->notify_capture_about_to_end(graph_id);
+  }
+
+  void notify_capture_destroy(int device, MempoolId_t mempool_id) {
+    device_allocator_[device]->notify_capture_destroy(mempool_id);
+  }
+
   std::vector<std::unique_ptr<MTGPUCachingAllocator>> device_allocator_;
 
  private:
@@ -1753,27 +1929,17 @@ struct C10_API MusaCachingAllocator final : MUSAAllocator {
       int device,
       CaptureId_t graph_id,
       MempoolId_t mempool_id) override {
-    C10_THROW_ERROR(
-        NotImplementedError,
-        "notifyCaptureBegin in MUSACachingAllocator is not supported now!");
+    allocator_impl_->notify_capture_begin(device, graph_id, mempool_id);
   }
 
   void notifyCaptureAboutToEnd(int device, CaptureId_t graph_id) override {
-    C10_THROW_ERROR(
-        NotImplementedError,
-        "notifyCaptureAboutToEnd in MUSACachingAllocator is not supported now!");
+    allocator_impl_->notify_capture_about_to_end(device, graph_id);
   }
 
-  void notifyCaptureEnded(int device, CaptureId_t graph_id) override {
-    C10_THROW_ERROR(
-        NotImplementedError,
-        "notifyCaptureEnded in MUSACachingAllocator is not supported now!");
-  }
+  void notifyCaptureEnded(int device, CaptureId_t graph_id) override {}
 
   void notifyCaptureDestroy(int device, MempoolId_t mempool_id) override {
-    C10_THROW_ERROR(
-        NotImplementedError,
-        "notifyCaptureDestroy in MUSACachingAllocator is not supported now!");
+    allocator_impl_->notify_capture_destroy(device, mempool_id);
   }
 
   void recordHistory(
@@ -1976,6 +2142,25 @@ std::shared_ptr<void> GetIpcDevPtr(std::string handle) {
   MusaCachingAllocator* palloc = GetMusaCachingAllocator();
   return palloc->getIpcDevPtr(handle);
 }
+
+void NotifyCaptureBegin(
+    int device,
+    CaptureId_t graph_id,
+    MempoolId_t mempool_id) {
+  GetMusaCachingAllocator()->notifyCaptureBegin(device, graph_id, mempool_id);
+}
+
+void NotifyCaptureAboutToEnd(int device, CaptureId_t graph_id) {
+  GetMusaCachingAllocator()->notifyCaptureAboutToEnd(device, graph_id);
+}
+
+void NotifyCaptureEnded(int device, CaptureId_t graph_id) {
+  GetMusaCachingAllocator()->notifyCaptureEnded(device, graph_id);
+}
+
+void NotifyCaptureDestroy(int device, MempoolId_t mempool_id) {
+  GetMusaCachingAllocator()->notifyCaptureDestroy(device, mempool_id);
+}
 } // namespace MUSACachingAllocator
 } // namespace musa
 } // namespace c10
@@ -236,6 +236,16 @@ void AttachOutOfMemoryObserver(OutOfMemoryObserver observer);
 void* GetBaseAllocation(void* ptr, size_t* outSize);
 std::shared_ptr<void> GetIpcDevPtr(std::string handle);
 
+// Route the allocations of capture `graph_id` into the private pool
+// `mempool_id` until NotifyCaptureAboutToEnd, see MUSAGraph.
+void NotifyCaptureBegin(
+    int device,
+    CaptureId_t graph_id,
+    MempoolId_t mempool_id);
+void NotifyCaptureAboutToEnd(int device, CaptureId_t graph_id);
+void NotifyCaptureEnded(int device, CaptureId_t graph_id);
+void NotifyCaptureDestroy(int device, MempoolId_t mempool_id);
+
 } // namespace MUSACachingAllocator
 } // namespace musa
 } // namespace c10
@@ -0,0 +1,67 @@
+#include "torch_musa/csrc/core/Graph.h"
+
+#include <torch/csrc/Exceptions.h>
+#include <torch/csrc/utils/pybind.h>
+
+#include <string>
+
+#include "torch_musa/csrc/aten/musa/MUSAGraph.h"
+
+// Cargo culted partially from csrc/cuda/Graph.cpp
+
+void THMPGraph_init(PyObject* module) {
+  // Pybind11 patch notes say "py::module_" is more up-to-date syntax,
+  // but CI linter and some builds prefer "module".
+  auto torch_M = py::handle(module).cast<py::module>();
+
+  torch_M.def("_graph_pool_handle", &::at::musa::graph_pool_handle);
+
+  py::class_<::at::musa::MUSAGraph>(torch_M, "_MUSAGraph")
+      .def(py::init<>())
+      .def(
+          "capture_begin",
+          [](::at::musa::MUSAGraph& self,
+             c10::optional<c10::musa::MempoolId_t> pool_opt,
+             std::string capture_error_mode) {
+            musaStreamCaptureMode capture_mode;
+            c10::musa::MempoolId_t pool = pool_opt.has_value()
+                ? pool_opt.value()
+                : c10::musa::MempoolId_t{0, 0};
+            if (capture_error_mode == "global") {
+              capture_mode = musaStreamCaptureModeGlobal;
+            } else if (capture_error_mode == "thread_local") {
+              capture_mode = musaStreamCaptureModeThreadLocal;
+            } else if (capture_error_mode == "relaxed") {
+              capture_mode = musaStreamCaptureModeRelaxed;
+            } else {
+              TORCH_CHECK(
+                  false,
+                  "Unknown capture error mode. Expected `global`, `thread_local`, or `relaxed`, got ",
+                  capture_error_mode);
+            }
+            return self.capture_begin(pool, capture_mode);
+          },
+          py::arg("pool"),
+          py::arg("capture_error_mode"),
+          py::call_guard<py::gil_scoped_release>())
+      .def(
+          "capture_end",
+          torch::wrap_pybind_function_no_gil(&at::musa::MUSAGraph::capture_end))
+      .def(
+          "replay",
+          torch::wrap_pybind_function_no_gil(&at::musa::MUSAGraph::replay))
+      .def(
+          "reset",
+          torch::wrap_pybind_function_no_gil(&at::musa::MUSAGraph::reset))
+      .def(
+          "pool",
+          torch::wrap_pybind_function_no_gil(&at::musa::MUSAGraph::pool))
+      .def(
+          "debug_dump",
+          torch::wrap_pybind_function_no_gil(
+              &::at::musa::MUSAGraph::debug_dump))
+      .def(
+          "enable_debug_mode",
+          torch::wrap_pybind_function_no_gil(
+              &::at::musa::MUSAGraph::enable_debug_mode));
+}
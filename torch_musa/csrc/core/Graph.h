@@ -0,0 +1,8 @@
+#ifndef TORCH_MUSA_CSRC_CORE_GRAPH_H_
+#define TORCH_MUSA_CSRC_CORE_GRAPH_H_
+
+#include <torch/csrc/python_headers.h>
+
+void THMPGraph_init(PyObject* module);
+
+#endif // TORCH_MUSA_CSRC_CORE_GRAPH_H_
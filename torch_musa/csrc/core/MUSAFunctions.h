@@ -32,6 +32,16 @@ __inline__ WarningState& warning_state() {
   return warning_state_;
 }
 
+// To be called by ops that synchronize implicitly (e.g. output sizes computed
+// on device and read back inside a library call) so that SyncDebugMode
+// reports them like explicit stream synchronizations.
+void __inline__ maybe_warn_or_error_on_sync() {
+  if (C10_UNLIKELY(
+          warning_state().get_sync_debug_mode() != SyncDebugMode::L_DISABLED)) {
+    warn_or_error_on_sync();
+  }
+}
+
 void __inline__ memcpy_and_sync(
     void* dst,
     const void* src,
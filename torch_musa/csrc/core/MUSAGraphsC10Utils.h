@@ -3,8 +3,11 @@
 
 #include <utility>
 
+#include "musa_runtime_api.h"
+#include "torch_musa/csrc/core/MUSAStream.h"
+
 // MUSA Graphs utils used by c10 and aten.
-// aten/musa/MUSAGraphsUtils.cuh adds utils used by aten only.
+// aten/musa/MUSAGraphsUtils.muh adds utils used by aten only.
 
 namespace c10 {
 namespace musa {
@@ -15,13 +18,50 @@ using CaptureId_t = unsigned long long;
 // second is set if the instance is created by at::musa::graph_pool_handle.
 using MempoolId_t = std::pair<CaptureId_t, CaptureId_t>;
 
-enum class CaptureStatus : int { None = 0 };
+// RAII guard for "musaStreamCaptureMode", a thread-local value
+// that controls the error-checking strictness of a capture.
+struct MUSAStreamCaptureModeGuard {
+  explicit MUSAStreamCaptureModeGuard(musaStreamCaptureMode desired)
+      : strictness_(desired) {
+    TORCH_MUSA_CHECK(musaThreadExchangeStreamCaptureMode(&strictness_));
+  }
+  ~MUSAStreamCaptureModeGuard() {
+    TORCH_MUSA_CHECK_WARN(musaThreadExchangeStreamCaptureMode(&strictness_));
+  }
+
+ private:
+  musaStreamCaptureMode strictness_;
+};
+
+// Protects against enum musaStreamCaptureStatus implementation changes.
+// Some compilers seem not to like static_assert without the messages.
+static_assert(
+    int(musaStreamCaptureStatus::musaStreamCaptureStatusNone) == 0,
+    "unexpected int(musaStreamCaptureStatusNone) value");
+static_assert(
+    int(musaStreamCaptureStatus::musaStreamCaptureStatusActive) == 1,
+    "unexpected int(musaStreamCaptureStatusActive) value");
+static_assert(
+    int(musaStreamCaptureStatus::musaStreamCaptureStatusInvalidated) == 2,
+    "unexpected int(musaStreamCaptureStatusInvalidated) value");
+
+enum class CaptureStatus : int {
+  None = int(musaStreamCaptureStatus::musaStreamCaptureStatusNone),
+  Active = int(musaStreamCaptureStatus::musaStreamCaptureStatusActive),
+  Invalidated = int(musaStreamCaptureStatus::musaStreamCaptureStatusInvalidated)
+};
 
 inline std::ostream& operator<<(std::ostream& os, CaptureStatus status) {
   switch (status) {
     case CaptureStatus::None:
       os << "musaStreamCaptureStatusNone";
       break;
+    case CaptureStatus::Active:
+      os << "musaStreamCaptureStatusActive";
+      break;
+    case CaptureStatus::Invalidated:
+      os << "musaStreamCaptureStatusInvalidated";
+      break;
     default:
       TORCH_INTERNAL_ASSERT(
           false, "Unknown MUSA graph CaptureStatus", int(status));
@@ -29,8 +69,12 @@ inline std::ostream& operator<<(std::ostream& os, CaptureStatus status) {
   return os;
 }
 
+// Use this version where you're sure a MUSA context exists already.
 inline CaptureStatus currentStreamCaptureStatusMayInitCtx() {
-  return CaptureStatus::None;
+  musaStreamCaptureStatus is_capturing;
+  TORCH_MUSA_CHECK(
+      musaStreamIsCapturing(getCurrentMUSAStream().stream(), &is_capturing));
+  return CaptureStatus(is_capturing);
 }
 
 } // namespace musa
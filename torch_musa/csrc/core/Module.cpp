@@ -18,10 +18,13 @@
 #include "torch_musa/csrc/amp/autocast_mode.h"
 #include "torch_musa/csrc/aten/musa/MUSAContext.h"
 #include "torch_musa/csrc/aten/musa/MUSAGeneratorImpl.h"
+#include "torch_musa/csrc/aten/musa/MUSAGraphsUtils.muh"
 #include "torch_musa/csrc/aten/utils/Utils.h"
 #include "torch_musa/csrc/core/Allocator.h"
 #include "torch_musa/csrc/core/Device.h"
 #include "torch_musa/csrc/core/Event.h"
+#include "torch_musa/csrc/core/Graph.h"
+#include "torch_musa/csrc/core/MUSAFunctions.h"
 #include "torch_musa/csrc/core/PythonTensor.h"
 #include "torch_musa/csrc/core/Sleep.h"
 #include "torch_musa/csrc/core/Stream.h"
@@ -150,6 +153,8 @@ PyObject* PyMusaMemoryStats(PyObject* /* unused */, PyObject* arg) {
   result["inactive_split_bytes"] = statArrayToDict(stats.inactive_split_bytes);
   result["oversize_allocations"] = statToDict(stats.oversize_allocations);
   result["oversize_segments"] = statToDict(stats.oversize_segments);
+  result["mublas_workspace_bytes"] =
+      statToDict(at::musa::getMublasWorkspaceStat(device));
 
   return result.release().ptr();
   END_HANDLE_TH_ERRORS
@@ -409,6 +414,16 @@ PyObject* PyMusaresetPeakMemoryStats(PyObject* _unused, PyObject* arg) {
       THPUtils_checkLong(arg), "invalid argument to reset_peak_memory_stats");
   const int device = (int)THPUtils_unpackLong(arg);
   c10::musa::MUSACachingAllocator::ResetPeakStats(device);
+  at::musa::resetPeakMublasWorkspaceStat(device);
+  END_HANDLE_TH_ERRORS
+  Py_RETURN_NONE;
+}
+
+PyObject* PyMusaClearMublasWorkspaces(
+    PyObject* /* unused */,
+    PyObject* /* unused */) {
+  HANDLE_TH_ERRORS
+  at::musa::clearMublasWorkspaces();
   END_HANDLE_TH_ERRORS
   Py_RETURN_NONE;
 }
@@ -633,6 +648,21 @@ PyObject* PyMusaGetCurrentStream(
   END_HANDLE_TH_ERRORS
 }
 
+PyObject* PyMusaIsCurrentStreamCapturing(
+    PyObject* /* unused */,
+    PyObject* /* noargs */) {
+  HANDLE_TH_ERRORS
+  // If there's no musa context, at::musa::currentStreamCaptureStatus returns
+  // CaptureStatus::None without initializing a context.
+  if (at::musa::currentStreamCaptureStatus() ==
+      at::musa::CaptureStatus::None) {
+    Py_RETURN_FALSE;
+  } else {
+    Py_RETURN_TRUE;
+  }
+  END_HANDLE_TH_ERRORS
+}
+
 PyObject* PyMusaGetCurrentRawStream(
     PyObject* /* unused */,
     PyObject* device_index) {
@@ -701,6 +731,27 @@ PyObject* PyMusaSleep(PyObject* /* unused */, PyObject* cycles) {
   END_HANDLE_TH_ERRORS
 }
 
+PyObject* PyMusaSetSyncDebugMode(PyObject* /* unused */, PyObject* arg) {
+  HANDLE_TH_ERRORS
+  TORCH_CHECK(
+      THPUtils_checkLong(arg), "invalid argument to set_sync_debug_mode");
+  const int64_t debug_mode = THPUtils_unpackLong(arg);
+  TORCH_CHECK(
+      debug_mode >= 0 && debug_mode <= 2,
+      "invalid value of debug_mode, expected one of 0,1,2");
+  c10::musa::warning_state().set_sync_debug_mode(
+      static_cast<c10::musa::SyncDebugMode>(debug_mode));
+  Py_RETURN_NONE;
+  END_HANDLE_TH_ERRORS
+}
+
+PyObject* PyMusaGetSyncDebugMode(PyObject* /* unused */, PyObject* noargs) {
+  HANDLE_TH_ERRORS
+  return THPUtils_packInt32(
+      static_cast<int32_t>(c10::musa::warning_state().get_sync_debug_mode()));
+  END_HANDLE_TH_ERRORS
+}
+
 PyObject* PyMusaMudnnVersion(PyObject* /* unused */, PyObject* /* unused */) {
   HANDLE_TH_ERRORS
   return THPUtils_packInt64(MUDNN_VERSION);
@@ -725,6 +776,10 @@ static PyMethodDef MusaMemoryMethods[] = {
      nullptr},
     {"_musa_setMemoryFraction", PyMusaSetMemoryFraction, METH_VARARGS, nullptr},
     {"_musa_resetPeakMemoryStats", PyMusaresetPeakMemoryStats, METH_O, nullptr},
+    {"_musa_clearMublasWorkspaces",
+     PyMusaClearMublasWorkspaces,
+     METH_NOARGS,
+     nullptr},
     {nullptr}};
 
 static PyMethodDef MusaStreamMethods[] = {
@@ -736,6 +791,10 @@ static PyMethodDef MusaStreamMethods[] = {
      METH_VARARGS | METH_KEYWORDS,
      nullptr},
     {"_musa_sleep", PyMusaSleep, METH_O, nullptr},
+    {"_musa_isCurrentStreamCapturing",
+     PyMusaIsCurrentStreamCapturing,
+     METH_NOARGS,
+     nullptr},
     {nullptr}};
 
 static PyMethodDef MusaDeviceMethods[] = {
@@ -749,6 +808,11 @@ static PyMethodDef MusaDeviceMethods[] = {
      METH_VARARGS,
      nullptr},
     {"_musa_synchronize", PyMusaSynchronize, METH_NOARGS, nullptr},
+    {"_musa_set_sync_debug_mode", PyMusaSetSyncDebugMode, METH_O, nullptr},
+    {"_musa_get_sync_debug_mode",
+     PyMusaGetSyncDebugMode,
+     METH_NOARGS,
+     nullptr},
     {"_mudnn_version", PyMusaMudnnVersion, METH_NOARGS, nullptr},
     {"_musa_ipc_collect", PyMusaIPCCollect, METH_NOARGS, nullptr},
     {"_musa_isInBadFork", PyMusaIsInBadFork, METH_NOARGS, nullptr},
@@ -783,6 +847,7 @@ PyObject* InitMusaModule() {
 
   THMPStream_init(module);
   THMPEvent_init(module);
+  THMPGraph_init(module);
   torch::musa::python::InitCommMethods(module);
 
 #ifdef USE_MCCL
@@ -23,6 +23,35 @@ extern void multi_tensor_lamb_musa(
     const float max_grad_norm,
     at::optional<bool> use_nvlamb_python);
 
+extern void multi_tensor_adam_musa(
+    int chunk_size,
+    at::Tensor noop_flag,
+    std::vector<std::vector<at::Tensor>> tensor_lists,
+    const float lr,
+    const float beta1,
+    const float beta2,
+    const float epsilon,
+    at::Tensor step,
+    const int mode,
+    const int bias_correction,
+    const float weight_decay,
+    const bool amsgrad,
+    at::optional<at::Tensor> inv_scale,
+    at::optional<at::Tensor> found_inf);
+
+extern void multi_tensor_sgd_musa(
+    int chunk_size,
+    at::Tensor noop_flag,
+    std::vector<std::vector<at::Tensor>> tensor_lists,
+    const float weight_decay,
+    const float momentum,
+    const float dampening,
+    const float lr,
+    const bool nesterov,
+    at::optional<at::Tensor> momentum_initialized,
+    at::optional<at::Tensor> inv_scale,
+    at::optional<at::Tensor> found_inf);
+
 PYBIND11_MODULE(TORCH_EXTENSION_NAME, m) {
   m.def(
       "multi_tensor_l2norm",
@@ -32,4 +61,12 @@ PYBIND11_MODULE(TORCH_EXTENSION_NAME, m) {
       "multi_tensor_lamb",
       &multi_tensor_lamb_musa,
       "Computes and apply update for LAMB optimizer");
+  m.def(
+      "multi_tensor_adam",
+      &multi_tensor_adam_musa,
+      "Computes and apply update for Adam/AdamW optimizer");
+  m.def(
+      "multi_tensor_sgd",
+      &multi_tensor_sgd_musa,
+      "Computes and apply update for SGD optimizer");
 }
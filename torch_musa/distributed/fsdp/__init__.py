@@ -1,2 +1,3 @@
 # pylint: disable=all
 from .sharded_grad_scaler import ShardedGradScaler
+from ._runtime_utils import enable_multi_stream
@@ -1,6 +1,7 @@
 # pylint: disable=all
 import os
-from typing import no_type_check
+import warnings
+from typing import Optional, no_type_check
 
 import torch
 import torch.distributed as dist
@@ -22,13 +23,52 @@ from torch.distributed.fsdp._runtime_utils import (
     _div_if_needed,
 )
 
-# flag for compare multiple computation streams with single computation stream, default is True
-# TODO(mingyuan.wang): try `_TORCH_MUSA_FSDP_DEFAULT_STREAM_ONLY=False` on musa arch'version greater than 22
+# flag for compare multiple computation streams with single computation stream, default is True.
+# With False (multi-stream mode, see `enable_multi_stream`) the all-gathers of the next unit are
+# prefetched on the unshard stream and reduce-scatters run on the post-backward stream, both
+# overlapping the computation on the default stream.
 _TORCH_MUSA_FSDP_DEFAULT_STREAM_ONLY = True
 
-# flag for disable async all-reduce in HSDP, default is False
+# HSDP's all-reduce on its own stream was seen hanging up to musa arch 22, where multi-stream
+# mode falls back to the default stream. Newer archs are the ones it is enabled on.
+_TORCH_MUSA_FSDP_MULTI_STREAM_MIN_CAPABILITY = (2, 3)
+
+# flag for disable async all-reduce in HSDP, default is False. Only takes effect in multi-stream
+# mode, where HSDP's all-reduce runs on its own stream, and stalls the host once per unit
 _TORCH_MUSA_FSDP_FORCE_SYNC_ALL_REDUCE = False
 
+# number of all-gathers allowed in flight ahead of the computation when `limit_all_gathers`
+# is set in multi-stream mode, None keeps PyTorch's default of 2. Every in-flight all-gather
+# holds an unsharded flat parameter, so this bounds the memory the prefetching costs.
+_TORCH_MUSA_FSDP_MAX_INFLIGHT_ALL_GATHERS = None
+
+
+def enable_multi_stream(
+    enabled: bool = True, max_inflight_all_gathers: Optional[int] = None
+) -> None:
+    """
+    Switches FSDP between the default-stream-only mode and the multi-stream mode.
+
+    In multi-stream mode the all-gathers run on a dedicated unshard stream, so that
+    ``forward_prefetch``/``backward_prefetch`` overlap them with the computation of the
+    current unit, and the reduce-scatters run on a dedicated post-backward stream. Memory
+    moving between the streams is handed back to the caching allocator through
+    ``record_stream``, and ``limit_all_gathers=True`` (the default) rate limits the
+    prefetching to ``max_inflight_all_gathers`` unsharded units.
+
+    Takes effect for root FSDP modules whose first forward has not run yet, the streams
+    are created lazily then. Equivalent to setting ``TORCH_MUSA_FSDP_DEFAULT_STREAM_ONLY=0``
+    and ``TORCH_MUSA_FSDP_MAX_INFLIGHT_ALL_GATHERS`` before importing torch_musa.
+    On musa arch 22 and older FSDP warns and keeps using the default stream only.
+    """
+    global _TORCH_MUSA_FSDP_DEFAULT_STREAM_ONLY, _TORCH_MUSA_FSDP_MAX_INFLIGHT_ALL_GATHERS
+    if max_inflight_all_gathers is not None and max_inflight_all_gathers < 1:
+        raise ValueError(
+            f"max_inflight_all_gathers must be positive, got {max_inflight_all_gathers}"
+        )
+    _TORCH_MUSA_FSDP_DEFAULT_STREAM_ONLY = not enabled
+    _TORCH_MUSA_FSDP_MAX_INFLIGHT_ALL_GATHERS = max_inflight_all_gathers
+
 
 @no_type_check
 def _init_streams(
@@ -46,6 +86,14 @@ def _init_streams(
         for fsdp_state in state._all_fsdp_states
     )
     default_stream_only = _TORCH_MUSA_FSDP_DEFAULT_STREAM_ONLY
+    if not default_stream_only:
+        capability = state._device_handle.get_device_capability(state.compute_device)
+        if capability < _TORCH_MUSA_FSDP_MULTI_STREAM_MIN_CAPABILITY:
+            warnings.warn(
+                "FSDP multi-stream mode is not supported on musa arch "
+                f"{capability[0]}{capability[1]}, using the default stream only"
+            )
+            default_stream_only = True
 
     # Prioritize all-gathers/reduce-scatters over async all-reduce for HSDP and
     # preserve the default priority of 0 otherwise
@@ -84,6 +132,22 @@ def _init_streams(
         )
     )
 
+    if default_stream_only:
+        return
+    for fsdp_state in state._all_fsdp_states:
+        if not fsdp_state.limit_all_gathers:
+            warnings.warn(
+                "FSDP multi-stream mode without `limit_all_gathers` lets the host issue "
+                "all-gathers arbitrarily far ahead of the computation, every one of them "
+                "holding an unsharded flat parameter in memory"
+            )
+            break
+    if _TORCH_MUSA_FSDP_MAX_INFLIGHT_ALL_GATHERS is not None:
+        for fsdp_state in state._all_fsdp_states:
+            fsdp_state._free_event_queue._max_num_inflight_all_gathers = (
+                _TORCH_MUSA_FSDP_MAX_INFLIGHT_ALL_GATHERS
+            )
+
 
 @no_type_check
 def _reduce_grad(state: _FSDPState, handle: FlatParamHandle) -> None:
@@ -159,13 +223,22 @@ def _apply_runtime_utils_patch():
 
     global _TORCH_MUSA_FSDP_DEFAULT_STREAM_ONLY
     global _TORCH_MUSA_FSDP_FORCE_SYNC_ALL_REDUCE
+    global _TORCH_MUSA_FSDP_MAX_INFLIGHT_ALL_GATHERS
 
     _TORCH_MUSA_FSDP_DEFAULT_STREAM_ONLY = (
         os.environ.get("TORCH_MUSA_FSDP_DEFAULT_STREAM_ONLY", "1") == "1"
     )
-    if _TORCH_MUSA_FSDP_DEFAULT_STREAM_ONLY:
-        _TORCH_MUSA_FSDP_FORCE_SYNC_ALL_REDUCE = (
-            os.environ.get("TORCH_MUSA_FSDP_FORCE_SYNC_ALL_REDUCE", "0") == "1"
-        )
+    _TORCH_MUSA_FSDP_FORCE_SYNC_ALL_REDUCE = (
+        os.environ.get("TORCH_MUSA_FSDP_FORCE_SYNC_ALL_REDUCE", "0") == "1"
+    )
+    max_inflight_all_gathers = os.environ.get("TORCH_MUSA_FSDP_MAX_INFLIGHT_ALL_GATHERS")
+    if max_inflight_all_gathers is not None:
+        max_inflight_all_gathers = int(max_inflight_all_gathers)
+        if max_inflight_all_gathers < 1:
+            raise ValueError(
+                "TORCH_MUSA_FSDP_MAX_INFLIGHT_ALL_GATHERS must be positive, "
+                f"got {max_inflight_all_gathers}"
+            )
+        _TORCH_MUSA_FSDP_MAX_INFLIGHT_ALL_GATHERS = max_inflight_all_gathers
 
     torch.distributed.fsdp._runtime_utils._init_streams = _init_streams
@@ -2,6 +2,8 @@
 :mod:`torch_musa.optim` is a package implementing various optimization algorithms.
 """
 
+from .fused_adam import FusedAdam
 from .fused_lamb import FusedLAMB
+from .fused_sgd import FusedSGD
 
-__all__ = ["FusedLAMB"]
+__all__ = ["FusedAdam", "FusedLAMB", "FusedSGD"]
@@ -0,0 +1,214 @@
+"""FusedAdam Optimizer"""
+
+from collections import defaultdict
+
+import torch
+from torch_musa.multi_tensor_apply import multi_tensor_applier
+
+from ..utils import ext_loader
+
+ext_module = ext_loader.load_ext("_ext", ["multi_tensor_adam"])
+
+
+def _grad_scaler_states(optimizer, device):
+    """Returns (inv_scale, found_inf) set on the optimizer by GradScaler.step.
+
+    Both stay on the device, the kernels read them directly so the step never
+    waits for the host to learn whether the gradients overflowed.
+    """
+    grad_scale = getattr(optimizer, "grad_scale", None)
+    found_inf = getattr(optimizer, "found_inf", None)
+    inv_scale = None
+    if grad_scale is not None:
+        inv_scale = grad_scale.to(device, torch.double).reciprocal().float()
+        inv_scale = inv_scale.reshape(1)
+    if found_inf is not None:
+        found_inf = found_inf.to(device, torch.float32).reshape(1)
+    return inv_scale, found_inf
+
+
+class FusedAdam(torch.optim.Optimizer):
+    """Implements Adam algorithm.
+
+    Currently GPU-only.
+
+    This version of fused Adam implements 2 fusions.
+
+      * Fusion of the Adam update's elementwise operations
+      * A multi-tensor apply launch that batches the elementwise updates applied to all the model's
+        parameters into one or a few kernel launches.
+
+    :class:`FusedAdam`'s usage is similar to any ordinary Pytorch optimizer::
+
+        from torch_musa.optim import FusedAdam
+        opt = FusedAdam(model.parameters(), lr = ....)
+        ...
+        opt.step()
+
+    :class:`FusedAdam` may be used with ``torch.musa.amp.GradScaler``, the
+    scaler then hands its scale and overflow flag to :meth:`step`, which
+    unscales the gradients inside the kernel and skips the update on overflow
+    without synchronizing with the host.
+
+    Adam was proposed in `Adam: A Method for Stochastic Optimization`_.
+
+    Arguments:
+        params (iterable): iterable of parameters to optimize or dicts defining
+            parameter groups.
+        lr (float, optional): learning rate. (default: 1e-3)
+        bias_correction (bool, optional): whether to apply Adam's bias
+            correction. (default: True)
+        betas (Tuple[float, float], optional): coefficients used for computing
+            running averages of gradient and its square. (default: (0.9, 0.999))
+        eps (float, optional): term added to the denominator to improve
+            numerical stability. (default: 1e-8)
+        adam_w_mode (boolean, optional): Apply L2 regularization or weight decay
+            True for decoupled weight decay(also known as AdamW) (default: True)
+        weight_decay (float, optional): weight decay (L2 penalty) (default: 0)
+        amsgrad (boolean, optional): whether to use the AMSGrad variant of this
+            algorithm from the paper `On the Convergence of Adam and Beyond`_
+            (default: False)
+        set_grad_none (bool, optional): whether set grad to None when zero_grad()
+            method is called. (default: True)
+        master_weights (bool, optional): keep an fp32 copy of every fp16/bf16
+            parameter together with fp32 optimizer states, the update is applied
+            to the copy and rounded back into the parameter. (default: False)
+
+    .. _Adam - A Method for Stochastic Optimization:
+        https://arxiv.org/abs/1412.6980
+    .. _On the Convergence of Adam and Beyond:
+        https://openreview.net/forum?id=ryQu7f-RZ
+    """
+
+    _step_supports_amp_scaling = True
+
+    def __init__(
+        self,
+        params,
+        lr=1e-3,
+        bias_correction=True,
+        betas=(0.9, 0.999),
+        eps=1e-8,
+        adam_w_mode=True,
+        weight_decay=0.0,
+        amsgrad=False,
+        set_grad_none=True,
+        master_weights=False,
+    ):
+        defaults = {
+            "lr": lr,
+            "bias_correction": bias_correction,
+            "betas": betas,
+            "eps": eps,
+            "weight_decay": weight_decay,
+            "amsgrad": amsgrad,
+        }
+        super().__init__(params, defaults)
+        if multi_tensor_applier.available:
+            # Skip buffer
+            self._dummy_overflow_buf = torch.tensor(
+                [0], dtype=torch.int, device=self.param_groups[0]["params"][0].device
+            )
+            self.multi_tensor_adam = ext_module.multi_tensor_adam
+        else:
+            raise RuntimeError("torch_musa.optim.FusedAdam requires musa extensions")
+
+        self.adam_w_mode = 1 if adam_w_mode else 0
+        self.set_grad_none = set_grad_none
+        self.master_weights = master_weights
+
+    def zero_grad(self, set_to_none: bool = True):
+        if self.set_grad_none:
+            for group in self.param_groups:
+                for p in group["params"]:
+                    p.grad = None
+        else:
+            super().zero_grad()
+
+    def _init_state(self, p, amsgrad):
+        state = self.state[p]
+        if len(state) == 0:
+            low_precision = p.dtype in (torch.float16, torch.bfloat16)
+            if self.master_weights and low_precision:
+                state["master_param"] = p.detach().float()
+            state_dtype = torch.float32 if "master_param" in state else p.dtype
+            # Exponential moving average of gradient values
+            state["exp_avg"] = torch.zeros_like(p, dtype=state_dtype)
+            # Exponential moving average of squared gradient values
+            state["exp_avg_sq"] = torch.zeros_like(p, dtype=state_dtype)
+        if amsgrad and "max_exp_avg_sq" not in state:
+            state["max_exp_avg_sq"] = torch.zeros_like(state["exp_avg_sq"])
+        return state
+
+    def step(self, closure=None):
+        """Performs a single optimization step.
+
+        Arguments:
+            closure (callable, optional): A closure that reevaluates the model
+                and returns the loss.
+        """
+        loss = None
+        if closure is not None:
+            loss = closure()
+
+        device = self.param_groups[0]["params"][0].device
+        inv_scale, found_inf = _grad_scaler_states(self, device)
+
+        for group in self.param_groups:
+            bias_correction = 1 if group["bias_correction"] else 0
+            beta1, beta2 = group["betas"]
+            amsgrad = group["amsgrad"]
+
+            # the step count stays on the device, so an overflowed step can be
+            # undone without knowing on the host whether it happened
+            if "step" not in group:
+                group["step"] = torch.zeros(1, dtype=torch.float32, device=device)
+            group["step"].add_(1)
+            if found_inf is not None:
+                group["step"].sub_(found_inf)
+
+            # create lists for multi-tensor apply, one per param dtype and
+            # master weight layout
+            tensor_lists = defaultdict(lambda: [[] for _ in range(6)])
+            for p in group["params"]:
+                if p.grad is None:
+                    continue
+                if p.grad.data.is_sparse:
+                    raise RuntimeError(
+                        "FusedAdam does not support sparse gradients, "
+                        "please consider SparseAdam instead"
+                    )
+                if p.dtype not in (torch.float32, torch.float16, torch.bfloat16):
+                    raise RuntimeError("FusedAdam only support fp32, fp16 and bf16.")
+
+                state = self._init_state(p, amsgrad)
+                master = "master_param" in state
+                lists = tensor_lists[(p.dtype, master)]
+                lists[0].append(p.grad.data)
+                lists[1].append(p.data)
+                lists[2].append(state["exp_avg"])
+                lists[3].append(state["exp_avg_sq"])
+                if amsgrad:
+                    lists[4].append(state["max_exp_avg_sq"])
+                if master:
+                    lists[5].append(state["master_param"])
+
+            for lists in tensor_lists.values():
+                multi_tensor_applier(
+                    self.multi_tensor_adam,
+                    self._dummy_overflow_buf,
+                    [l for l in lists if len(l) > 0],
+                    group["lr"],
+                    beta1,
+                    beta2,
+                    group["eps"],
+                    group["step"],
+                    self.adam_w_mode,
+                    bias_correction,
+                    group["weight_decay"],
+                    amsgrad,
+                    inv_scale,
+                    found_inf,
+                )
+
+        return loss
@@ -0,0 +1,178 @@
+"""FusedSGD Optimizer"""
+
+from collections import defaultdict
+
+import torch
+from torch.optim.optimizer import required
+from torch_musa.multi_tensor_apply import multi_tensor_applier
+
+from ..utils import ext_loader
+from .fused_adam import _grad_scaler_states
+
+ext_module = ext_loader.load_ext("_ext", ["multi_tensor_sgd"])
+
+
+class FusedSGD(torch.optim.Optimizer):
+    """Implements stochastic gradient descent (optionally with momentum).
+
+    Currently GPU-only.
+
+    This version of fused SGD implements 2 fusions.
+
+      * Fusion of the SGD update's elementwise operations
+      * A multi-tensor apply launch that batches the elementwise updates applied to all the model's
+        parameters into one or a few kernel launches.
+
+    :class:`FusedSGD`'s usage is similar to any ordinary Pytorch optimizer::
+
+        from torch_musa.optim import FusedSGD
+        opt = FusedSGD(model.parameters(), lr = ...., momentum=0.9)
+        ...
+        opt.step()
+
+    Like :class:`FusedAdam`, it takes the scale and overflow flag of
+    ``torch.musa.amp.GradScaler`` directly on the device.
+
+    Nesterov momentum is based on the formula from
+    `On the importance of initialization and momentum in deep learning`__.
+
+    Arguments:
+        params (iterable): iterable of parameters to optimize or dicts defining
+            parameter groups.
+        lr (float): learning rate
+        momentum (float, optional): momentum factor (default: 0)
+        dampening (float, optional): dampening for momentum (default: 0)
+        weight_decay (float, optional): weight decay (L2 penalty) (default: 0)
+        nesterov (bool, optional): enables Nesterov momentum (default: False)
+        set_grad_none (bool, optional): whether set grad to None when zero_grad()
+            method is called. (default: False)
+        master_weights (bool, optional): keep an fp32 copy of every fp16/bf16
+            parameter together with an fp32 momentum buffer, the update is
+            applied to the copy and rounded back into the parameter.
+            (default: False)
+
+    __ http://www.cs.toronto.edu/%7Ehinton/absps/momentum.pdf
+    """
+
+    _step_supports_amp_scaling = True
+
+    def __init__(
+        self,
+        params,
+        lr=required,
+        momentum=0,
+        dampening=0,
+        weight_decay=0,
+        nesterov=False,
+        set_grad_none=False,
+        master_weights=False,
+    ):
+        if lr is not required and lr < 0.0:
+            raise ValueError(f"Invalid learning rate: {lr}")
+        if momentum < 0.0:
+            raise ValueError(f"Invalid momentum value: {momentum}")
+        if weight_decay < 0.0:
+            raise ValueError(f"Invalid weight_decay value: {weight_decay}")
+        if nesterov and (momentum <= 0 or dampening != 0):
+            raise ValueError("Nesterov momentum requires a momentum and zero dampening")
+        defaults = {
+            "lr": lr,
+            "momentum": momentum,
+            "dampening": dampening,
+            "weight_decay": weight_decay,
+            "nesterov": nesterov,
+        }
+        super().__init__(params, defaults)
+        if multi_tensor_applier.available:
+            # Skip buffer
+            self._dummy_overflow_buf = torch.tensor(
+                [0], dtype=torch.int, device=self.param_groups[0]["params"][0].device
+            )
+            self.multi_tensor_sgd = ext_module.multi_tensor_sgd
+        else:
+            raise RuntimeError("torch_musa.optim.FusedSGD requires musa extensions")
+
+        self.set_grad_none = set_grad_none
+        self.master_weights = master_weights
+
+    def zero_grad(self, set_to_none: bool = True):
+        if self.set_grad_none:
+            for group in self.param_groups:
+                for p in group["params"]:
+                    p.grad = None
+        else:
+            super().zero_grad(set_to_none)
+
+    def step(self, closure=None):
+        """Performs a single optimization step.
+
+        Arguments:
+            closure (callable, optional): A closure that reevaluates the model
+                and returns the loss.
+        """
+        loss = None
+        if closure is not None:
+            loss = closure()
+
+        device = self.param_groups[0]["params"][0].device
+        inv_scale, found_inf = _grad_scaler_states(self, device)
+
+        for group in self.param_groups:
+            momentum = group["momentum"]
+
+            # create lists for multi-tensor apply, one per param dtype, master
+            # weight layout and device flag telling whether the momentum
+            # buffers were initialized. Buffers created in the same step share
+            # the flag, it is only set once a step was not skipped by found_inf
+            tensor_lists = defaultdict(lambda: [[] for _ in range(4)])
+            new_flag = None
+            for p in group["params"]:
+                if p.grad is None:
+                    continue
+                if p.grad.data.is_sparse:
+                    raise RuntimeError("FusedSGD does not support sparse gradients")
+                if p.dtype not in (torch.float32, torch.float16, torch.bfloat16):
+                    raise RuntimeError("FusedSGD only support fp32, fp16 and bf16.")
+
+                state = self.state[p]
+                low_precision = p.dtype in (torch.float16, torch.bfloat16)
+                if self.master_weights and low_precision and len(state) == 0:
+                    state["master_param"] = p.detach().float()
+                master = "master_param" in state
+                if momentum != 0 and "momentum_buffer" not in state:
+                    state_dtype = torch.float32 if master else p.dtype
+                    state["momentum_buffer"] = torch.zeros_like(p, dtype=state_dtype)
+                    if new_flag is None:
+                        new_flag = torch.zeros(1, dtype=torch.int, device=device)
+                    state["momentum_initialized"] = new_flag
+
+                initialized = state.get("momentum_initialized")
+                lists = tensor_lists[(p.dtype, master, initialized)]
+                lists[0].append(p.grad.data)
+                lists[1].append(p.data)
+                if momentum != 0:
+                    lists[2].append(state["momentum_buffer"])
+                if master:
+                    lists[3].append(state["master_param"])
+
+            for (_, _, initialized), lists in tensor_lists.items():
+                multi_tensor_applier(
+                    self.multi_tensor_sgd,
+                    self._dummy_overflow_buf,
+                    [l for l in lists if len(l) > 0],
+                    group["weight_decay"],
+                    momentum,
+                    group["dampening"],
+                    group["lr"],
+                    group["nesterov"],
+                    initialized,
+                    inv_scale,
+                    found_inf,
+                )
+                if initialized is not None:
+                    if found_inf is None:
+                        initialized.fill_(1)
+                    else:
+                        initialized.masked_fill_(found_inf == 0, 1)
+
+        return loss
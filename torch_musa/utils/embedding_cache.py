@@ -0,0 +1,408 @@
+"""Embedding tables kept in pinned host memory behind a device row cache.
+
+The full table of a :class:`CachedEmbedding` lives in pinned host memory, a
+set-associative cache of ``cache_rows`` rows lives on the device and serves
+every lookup. Row ``r`` may only occupy one of the ``associativity`` ways of
+set ``r % num_sets``. Planning a batch (which rows hit, which ways the misses
+take, which rows get evicted) runs on the host against the CPU indices, so it
+is cheap to test and can run ahead of the device. Only the copies of missed
+and evicted rows are issued on a side stream.
+"""
+
+import contextlib
+from collections import deque
+from dataclasses import dataclass
+from typing import Optional
+
+import torch
+from torch import nn
+import torch.nn.functional as F
+
+
+__all__ = ["CachePlan", "SetAssociativeCachePlanner", "CachedEmbedding"]
+
+_POLICIES = ("lru", "lfu")
+
+
+@dataclass
+class CachePlan:
+    """Host-side plan of one batch, every tensor is a CPU int64 tensor."""
+
+    # per lookup: the cache slot of its row, or num_slots + i for the i-th
+    # spilled row
+    slots: torch.Tensor
+    # missed rows copied from the host table into these slots
+    fetch_rows: torch.Tensor
+    fetch_slots: torch.Tensor
+    # resident rows written back to the host table before being replaced
+    evict_rows: torch.Tensor
+    evict_slots: torch.Tensor
+    # missed rows that found no free way, read from the host for this batch
+    spill_rows: torch.Tensor
+    # slots that may not be evicted until the batch is released
+    locked_slots: torch.Tensor
+
+
+class SetAssociativeCachePlanner:
+    """Tags, eviction scores and locks of a set-associative row cache.
+
+    ``policy="lru"`` evicts the way used longest ago, ``policy="lfu"`` the way
+    looked up least often since it was filled. Empty ways are always taken
+    first. Ways holding rows of a batch that has been planned but not released
+    are locked, a batch whose misses outnumber the unlocked ways of a set
+    spills the remaining rows instead of evicting locked ones.
+    """
+
+    def __init__(self, num_sets, associativity, policy="lru"):
+        if policy not in _POLICIES:
+            raise ValueError(f"policy must be one of {_POLICIES}, got {policy!r}")
+        if num_sets < 1 or associativity < 1:
+            raise ValueError("num_sets and associativity must be positive")
+        self.num_sets = num_sets
+        self.associativity = associativity
+        self.policy = policy
+        self.tags = torch.full((num_sets, associativity), -1, dtype=torch.int64)
+        self.scores = torch.zeros((num_sets, associativity), dtype=torch.int64)
+        self.locks = torch.zeros((num_sets, associativity), dtype=torch.int32)
+        self.clock = 0
+
+    @property
+    def num_slots(self):
+        return self.num_sets * self.associativity
+
+    def plan(self, indices, allow_spill=True):
+        """Plan the lookups of ``indices`` and lock every slot they use.
+
+        With ``allow_spill=False`` a batch that would spill raises before any
+        state is changed.
+        """
+        if indices.device.type != "cpu":
+            raise ValueError("cache planning runs on host, pass CPU indices")
+        num_sets, ways = self.num_sets, self.associativity
+        tags, scores = self.tags.view(-1), self.scores.view(-1)
+
+        rows, inverse, counts = torch.unique(
+            indices.reshape(-1).to(torch.int64),
+            return_inverse=True,
+            return_counts=True,
+        )
+        sets = rows % num_sets
+        match = self.tags[sets] == rows.unsqueeze(1)
+        hit = match.any(1)
+        row_slot = torch.empty_like(rows)
+        hit_slots = sets[hit] * ways + match[hit].to(torch.int8).argmax(1)
+        row_slot[hit] = hit_slots
+
+        # misses grouped by set, each takes the next free way of its set in
+        # eviction order: empty ways, then the lowest score
+        miss_idx = (~hit).nonzero().squeeze(1)
+        miss_sets, order = torch.sort(sets[miss_idx], stable=True)
+        miss_idx = miss_idx[order]
+        _, set_sizes = torch.unique_consecutive(miss_sets, return_counts=True)
+        first = torch.repeat_interleave(torch.cumsum(set_sizes, 0) - set_sizes, set_sizes)
+        rank = torch.arange(miss_idx.numel()) - first
+
+        busy = (self.locks > 0).view(-1).clone()
+        busy[hit_slots] = True
+        busy = busy.view(num_sets, ways)[miss_sets]
+        key = self.scores[miss_sets].masked_fill(self.tags[miss_sets] < 0, -1)
+        key.masked_fill_(busy, torch.iinfo(torch.int64).max)
+        ranked_ways = torch.argsort(key, dim=1, stable=True)
+        fits = rank < (~busy).sum(1)
+        if not allow_spill and not fits.all():
+            raise RuntimeError(
+                f"{int((~fits).sum())} rows of the batch found no free cache "
+                "way, increase cache_rows or associativity"
+            )
+        victim = ranked_ways.gather(1, rank.clamp(max=ways - 1).unsqueeze(1))
+        fetch_slots = (miss_sets * ways + victim.squeeze(1))[fits]
+        fetch_idx = miss_idx[fits]
+        spill_idx = miss_idx[~fits]
+        row_slot[fetch_idx] = fetch_slots
+        row_slot[spill_idx] = self.num_slots + torch.arange(spill_idx.numel())
+
+        self.clock += 1
+        old_rows = tags[fetch_slots]
+        evicted = old_rows >= 0
+        tags[fetch_slots] = rows[fetch_idx]
+        if self.policy == "lru":
+            scores[hit_slots] = self.clock
+            scores[fetch_slots] = self.clock
+        else:
+            scores[hit_slots] += counts[hit]
+            scores[fetch_slots] = counts[fetch_idx]
+        locked_slots = torch.cat([hit_slots, fetch_slots])
+        self.locks.view(-1)[locked_slots] += 1
+
+        return CachePlan(
+            slots=row_slot[inverse].view(indices.shape),
+            fetch_rows=rows[fetch_idx],
+            fetch_slots=fetch_slots,
+            evict_rows=old_rows[evicted],
+            evict_slots=fetch_slots[evicted],
+            spill_rows=rows[spill_idx],
+            locked_slots=locked_slots,
+        )
+
+    def release(self, plan):
+        """Unlock the slots of a batch once its forward and backward are done."""
+        self.locks.view(-1)[plan.locked_slots] -= 1
+
+    def resident(self):
+        """Return (rows, slots) of every row currently held by the cache."""
+        slots = (self.tags.view(-1) >= 0).nonzero().squeeze(1)
+        return self.tags.view(-1)[slots], slots
+
+
+@dataclass
+class _Batch:
+    indices: torch.Tensor
+    plan: CachePlan
+    slots: torch.Tensor
+    # missed and spilled rows copied to the device, None until staged
+    fetched: Optional[torch.Tensor] = None
+    spill: Optional[torch.Tensor] = None
+    # evicted and fetched rows written into the cache
+    applied: bool = False
+
+
+class CachedEmbedding(nn.Module):
+    """``nn.Embedding`` whose table lives in pinned host memory.
+
+    Lookups are served by ``cache_weight``, a device parameter of
+    ``num_sets * associativity`` rows. Call :meth:`prefetch` with the CPU
+    indices of an upcoming batch to copy its missing rows to the device on a
+    side stream, :meth:`forward` on indices that were not prefetched plans and
+    fetches them inline. :meth:`prefetch` may be called anywhere between two
+    forwards: the copies into and out of ``cache_weight`` are only issued by
+    the forward of the batch, ordered after the optimizer step queued before
+    it. Evicted rows are written back to the host table and :meth:`flush`
+    writes back every resident row. The state dict holds the flushed host
+    table as ``weight``, like the one of ``nn.Embedding``.
+
+    Optimizers update ``cache_weight``, whose rows are cache slots: per-row
+    optimizer state (momentum, Adam moments) and weight decay would follow
+    the slot and carry over to the next row stored there. Only plain SGD
+    without momentum or weight decay matches ``nn.Embedding``.
+
+    The slots of a batch stay locked until the next forward, so the
+    backward of a batch must run before the forward of the one after it.
+    Rows that found no free way are spilled: looked up from a per-batch copy,
+    which is only allowed in eval mode since their gradients would be lost.
+    """
+
+    def __init__(
+        self,
+        num_embeddings,
+        embedding_dim,
+        cache_rows,
+        associativity=8,
+        policy="lru",
+        device="musa",
+        dtype=None,
+        _weight=None,
+    ):
+        super().__init__()
+        device = torch.device(device)
+        num_sets = max(1, -(-cache_rows // associativity))
+        self.num_embeddings = num_embeddings
+        self.embedding_dim = embedding_dim
+        self.planner = SetAssociativeCachePlanner(num_sets, associativity, policy)
+        pin = device.type == "musa"
+        self.host_weight = torch.empty(
+            (num_embeddings, embedding_dim), dtype=dtype, pin_memory=pin
+        )
+        if _weight is None:
+            nn.init.normal_(self.host_weight)
+        else:
+            self.host_weight.copy_(_weight)
+        self.cache_weight = nn.Parameter(
+            torch.zeros(
+                (self.planner.num_slots, embedding_dim),
+                dtype=self.host_weight.dtype,
+                device=device,
+            )
+        )
+        self._stream = torch.musa.Stream(device=device) if pin else None
+        self._pending = deque()
+        self._in_use = None
+        self._writeback = None
+
+    def _side_stream(self):
+        if self._stream is None:
+            return contextlib.nullcontext()
+        return torch.musa.stream(self._stream)
+
+    def _pinned(self, rows):
+        buf = torch.empty(
+            (rows.numel(), self.embedding_dim),
+            dtype=self.host_weight.dtype,
+            pin_memory=self._stream is not None,
+        )
+        return torch.index_select(self.host_weight, 0, rows, out=buf)
+
+    def _finish_writeback(self):
+        if self._writeback is None:
+            return
+        rows, buf, event = self._writeback
+        if event is not None:
+            event.synchronize()
+        self.host_weight.index_copy_(0, rows, buf)
+        self._writeback = None
+
+    def _stage(self, batch):
+        # the host table must hold every row evicted so far
+        self._finish_writeback()
+        device = self.cache_weight.device
+        plan = batch.plan
+        batch.fetched = self._pinned(plan.fetch_rows).to(device, non_blocking=True)
+        batch.spill = self._pinned(plan.spill_rows).to(device, non_blocking=True)
+
+    @torch.no_grad()
+    def _apply(self, batch):
+        if batch.applied:
+            return
+        device = self.cache_weight.device
+        cache = self.cache_weight.data
+        plan = batch.plan
+        if self._stream is not None:
+            # after every update of cache_weight queued so far
+            self._stream.wait_stream(torch.musa.current_stream(device))
+        with self._side_stream():
+            if batch.fetched is None:
+                self._stage(batch)
+            if plan.evict_rows.numel():
+                self._finish_writeback()
+                evicted = cache.index_select(0, plan.evict_slots.to(device))
+                buf = torch.empty(
+                    evicted.shape,
+                    dtype=evicted.dtype,
+                    pin_memory=self._stream is not None,
+                )
+                buf.copy_(evicted, non_blocking=True)
+                event = None
+                if self._stream is not None:
+                    event = torch.musa.Event()
+                    event.record()
+                self._writeback = (plan.evict_rows, buf, event)
+            if plan.fetch_rows.numel():
+                fetch_slots = plan.fetch_slots.to(device, non_blocking=True)
+                cache.index_copy_(0, fetch_slots, batch.fetched)
+        batch.applied = True
+
+    def prefetch(self, indices):
+        """Plan ``indices`` (CPU) and start copying their missing rows."""
+        if indices.numel() and (
+            indices.min() < 0 or indices.max() >= self.num_embeddings
+        ):
+            raise IndexError("CachedEmbedding indices out of range")
+        plan = self.planner.plan(indices, allow_spill=not self.training)
+        slots = plan.slots
+        if self._stream is not None:
+            slots = slots.pin_memory()
+        with self._side_stream():
+            batch = _Batch(
+                indices, plan, slots.to(self.cache_weight.device, non_blocking=True)
+            )
+            # rows evicted by a queued batch reach the host table only when
+            # it is applied, stage from the host once it has been
+            if all(pending.applied for pending in self._pending):
+                self._stage(batch)
+        self._pending.append(batch)
+
+    def forward(self, indices):
+        if self._pending and (
+            self._pending[0].indices is indices
+            or torch.equal(self._pending[0].indices, indices.cpu())
+        ):
+            batch = self._pending.popleft()
+        else:
+            # not prefetched, batches prefetched for later stay queued but
+            # are applied first so this one stages their evicted rows
+            for pending in self._pending:
+                self._apply(pending)
+            self.prefetch(indices.cpu())
+            batch = self._pending.pop()
+        self._apply(batch)
+        if self._stream is not None:
+            current = torch.musa.current_stream(self._stream.device)
+            current.wait_stream(self._stream)
+            batch.slots.record_stream(current)
+            batch.spill.record_stream(current)
+        if self._in_use is not None:
+            self.planner.release(self._in_use.plan)
+        self._in_use = batch
+        if batch.spill.numel():
+            return F.embedding(batch.slots, torch.cat([self.cache_weight, batch.spill]))
+        return F.embedding(batch.slots, self.cache_weight)
+
+    @torch.no_grad()
+    def flush(self):
+        """Write every resident row back and return the host table."""
+        # the planner already counts rows of queued batches as resident
+        for pending in self._pending:
+            self._apply(pending)
+        if self._stream is not None:
+            self._stream.synchronize()
+            torch.musa.current_stream(self._stream.device).synchronize()
+        self._finish_writeback()
+        rows, slots = self.planner.resident()
+        cache = self.cache_weight.data
+        self.host_weight.index_copy_(0, rows, cache[slots.to(cache.device)].cpu())
+        return self.host_weight
+
+    def _save_to_state_dict(self, destination, prefix, keep_vars):
+        # cache_weight is slot ordered, only the host table is meaningful
+        destination[prefix + "weight"] = self.flush().clone()
+
+    def _load_from_state_dict(
+        self,
+        state_dict,
+        prefix,
+        local_metadata,
+        strict,
+        missing_keys,
+        unexpected_keys,
+        error_msgs,
+    ):
+        key = prefix + "weight"
+        if strict:
+            unexpected_keys.extend(
+                name
+                for name in state_dict
+                if name.startswith(prefix)
+                and name != key
+                and "." not in name[len(prefix) :]
+            )
+        if key not in state_dict:
+            missing_keys.append(key)
+            return
+        weight = state_dict[key]
+        if weight.shape != self.host_weight.shape:
+            error_msgs.append(
+                f"size mismatch for {key}: copying a param with shape "
+                f"{tuple(weight.shape)} from checkpoint, the shape in current "
+                f"model is {tuple(self.host_weight.shape)}."
+            )
+            return
+        if self._stream is not None:
+            self._stream.synchronize()
+            torch.musa.current_stream(self._stream.device).synchronize()
+        # every cached and queued row is stale now
+        planner = self.planner
+        self.planner = SetAssociativeCachePlanner(
+            planner.num_sets, planner.associativity, planner.policy
+        )
+        self._pending.clear()
+        self._in_use = None
+        self._writeback = None
+        with torch.no_grad():
+            self.host_weight.copy_(weight)
+
+    def extra_repr(self):
+        return (
+            f"{self.num_embeddings}, {self.embedding_dim}, "
+            f"num_sets={self.planner.num_sets}, "
+            f"associativity={self.planner.associativity}, "
+            f"policy={self.planner.policy!r}"
+        )
@@ -0,0 +1,155 @@
+"""Rewrite eager linear/addmm/conv -> activation chains onto fused MUSA ops"""
+
+import torch
+from torch import fx, nn
+import torch.nn.functional as F
+
+
+_ACT_MODULES = {
+    nn.ReLU: "relu",
+    nn.GELU: "gelu",
+    nn.SiLU: "silu",
+}
+
+_ACT_FUNCTIONS = {
+    F.relu: "relu",
+    torch.relu: "relu",
+    F.gelu: "gelu",
+    F.silu: "silu",
+}
+
+_ACT_METHODS = {
+    "relu": "relu",
+}
+
+
+def _activation_of(node, modules):
+    """Return the activation name applied by ``node``, or None."""
+    if node.op == "call_module":
+        mod = modules[node.target]
+        act = _ACT_MODULES.get(type(mod))
+        # tanh-approximated GELU has no fused counterpart
+        if act == "gelu" and mod.approximate != "none":
+            return None
+        return act
+    if node.op == "call_function":
+        if node.target == F.gelu and node.kwargs.get("approximate", "none") != "none":
+            return None
+        return _ACT_FUNCTIONS.get(node.target)
+    if node.op == "call_method":
+        return _ACT_METHODS.get(node.target)
+    return None
+
+
+def _producer_args(node, modules, gm):
+    """Return ('linear'|'addmm'|'conv', args, kwargs) for a fusible producer
+    node, or None."""
+    if node.op == "call_module":
+        mod = modules[node.target]
+        if type(mod) is nn.Linear:  # pylint: disable=unidiomatic-typecheck
+            weight = _get_attr(gm, node, f"{node.target}.weight")
+            bias = (
+                _get_attr(gm, node, f"{node.target}.bias")
+                if mod.bias is not None
+                else None
+            )
+            return "linear", (node.args[0], weight, bias), {}
+        if (
+            type(mod) in (nn.Conv2d, nn.Conv3d)  # pylint: disable=unidiomatic-typecheck
+            and mod.padding_mode == "zeros"
+            and not isinstance(mod.padding, str)
+        ):
+            weight = _get_attr(gm, node, f"{node.target}.weight")
+            bias = (
+                _get_attr(gm, node, f"{node.target}.bias")
+                if mod.bias is not None
+                else None
+            )
+            return (
+                "conv",
+                (
+                    node.args[0],
+                    weight,
+                    bias,
+                    list(mod.stride),
+                    list(mod.padding),
+                    list(mod.dilation),
+                    mod.groups,
+                ),
+                {},
+            )
+        return None
+    if node.op == "call_function" and node.target == F.linear:
+        args = list(node.args) + [None] * (3 - len(node.args))
+        bias = node.kwargs.get("bias", args[2])
+        return "linear", (args[0], args[1], bias), {}
+    if (
+        node.op == "call_function"
+        and node.target == torch.addmm
+        and len(node.args) == 3
+        and set(node.kwargs) <= {"beta", "alpha"}
+    ):
+        return "addmm", tuple(node.args), dict(node.kwargs)
+    return None
+
+
+_FUSED_OPS = {
+    "linear": "fused_linear_act",
+    "addmm": "fused_addmm_act",
+    "conv": "fused_conv_bias_act",
+}
+
+
+def _get_attr(gm, anchor, target):
+    with gm.graph.inserting_before(anchor):
+        return gm.graph.get_attr(target)
+
+
+def fuse_linear_act(model: nn.Module) -> fx.GraphModule:
+    r"""Trace ``model`` with torch.fx and replace every ``Linear -> act``,
+    ``torch.addmm -> act`` and ``Conv2d/Conv3d -> act`` pair with
+    ``torch.ops.musa.fused_linear_act``, ``torch.ops.musa.fused_addmm_act`` and
+    ``torch.ops.musa.fused_conv_bias_act``, where act is one of ReLU, SiLU or
+    exact GELU. Only the producers whose output feeds nothing but the
+    activation are rewritten, and conv inputs must be batched.
+
+    The fused ops have no autograd formula, so the pass is meant for inference
+    and requires ``model`` to be in eval mode.
+
+    Example::
+
+        >>> model = torch_musa.utils.fusion.fuse_linear_act(model.eval())
+    """
+    if model.training:
+        raise RuntimeError("fuse_linear_act only supports models in eval mode")
+    gm = fx.symbolic_trace(model)
+    modules = dict(gm.named_modules())
+
+    for node in list(gm.graph.nodes):
+        act = _activation_of(node, modules)
+        if act is None or not node.args:
+            continue
+        producer = node.args[0]
+        if not isinstance(producer, fx.Node) or len(producer.users) != 1:
+            continue
+        kind_and_args = _producer_args(producer, modules, gm)
+        if kind_and_args is None:
+            continue
+        kind, args, kwargs = kind_and_args
+        with gm.graph.inserting_before(node):
+            fused = gm.graph.call_function(
+                getattr(torch.ops.musa, _FUSED_OPS[kind]),
+                args,
+                {**kwargs, "act": act},
+            )
+        node.replace_all_uses_with(fused)
+        gm.graph.erase_node(node)
+        gm.graph.erase_node(producer)
+
+    gm.graph.eliminate_dead_code()
+    gm.delete_all_unused_submodules()
+    gm.recompile()
+    return gm
+
+
+__all__ = ["fuse_linear_act"]